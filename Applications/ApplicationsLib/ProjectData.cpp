@@ -23,6 +23,7 @@
 #include "MeshLib/Mesh.h"
 
 #include "NumLib/TimeStepping/Algorithms/FixedTimeStepping.h"
+#include "NumLib/TimeStepping/Algorithms/IterationNumberBasedAdaptiveTimeStepping.h"
 
 // FileIO
 #include "FileIO/XmlIO/Boost/BoostXmlGmlInterface.h"
@@ -267,6 +268,12 @@ void ProjectData::parseTimeStepping(BaseLib::ConfigTree const& timestepping_conf
 	{
 		_time_stepper.reset(NumLib::FixedTimeStepping::newInstance(timestepping_config));
 	}
+	else if (type == "IterationNumberBasedAdaptiveTimeStepping")
+	{
+		_time_stepper.reset(
+		    NumLib::IterationNumberBasedAdaptiveTimeStepping::newInstance(
+		        timestepping_config));
+	}
 	else if (type == "SingleStep")
 	{
 		timestepping_config.ignoreConfParam("type");
@@ -0,0 +1,167 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "ComponentGlobalIndexDict.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <iterator>
+
+namespace AssemblerLib
+{
+namespace detail
+{
+
+std::ostream& operator<<(std::ostream& os, Line const& l)
+{
+    return os << l.location << ", " << l.comp_id << ", " << l.global_index;
+}
+
+GlobalIndexType const ComponentGlobalIndexDict::nop;
+
+ComponentGlobalIndexDict::ComponentGlobalIndexDict(
+    std::vector<Line>&& lines, std::size_t const num_components)
+    : _num_components(num_components)
+{
+    std::stable_sort(lines.begin(), lines.end(),
+        [](Line const& a, Line const& b)
+        {
+            if (a.location < b.location)
+                return true;
+            if (b.location < a.location)
+                return false;
+            return a.comp_id < b.comp_id;
+        });
+
+    // Split the sorted lines into groups of the same mesh and item type.
+    auto group_begin = lines.cbegin();
+    std::size_t n_rows = 0;
+    while (group_begin != lines.cend())
+    {
+        auto const sameGroup = [&group_begin](Line const& l)
+        {
+            return l.location.mesh_id == group_begin->location.mesh_id &&
+                   l.location.item_type == group_begin->location.item_type;
+        };
+        auto const group_end =
+            std::find_if_not(group_begin, lines.cend(), sameGroup);
+
+        Group g;
+        g.mesh_id = group_begin->location.mesh_id;
+        g.item_type = group_begin->location.item_type;
+        g.row_offset = n_rows;
+        g.first_item_id = group_begin->location.item_id;
+
+        std::size_t n_items = 0;
+        for (auto l = group_begin; l != group_end; ++l)
+            if (l == group_begin ||
+                l->location.item_id != std::prev(l)->location.item_id)
+                ++n_items;
+
+        // Items covering at least half of their id range are indexed
+        // directly, otherwise their ids are stored.
+        std::size_t const range =
+            std::prev(group_end)->location.item_id - g.first_item_id + 1;
+        if (range <= 2 * n_items)
+        {
+            g.n_rows = range;
+        }
+        else
+        {
+            g.n_rows = n_items;
+            g.item_ids.reserve(n_items);
+            for (auto l = group_begin; l != group_end; ++l)
+                if (g.item_ids.empty() ||
+                    g.item_ids.back() != l->location.item_id)
+                    g.item_ids.push_back(l->location.item_id);
+        }
+
+        n_rows += g.n_rows;
+        _groups.push_back(std::move(g));
+        group_begin = group_end;
+    }
+
+    _global_indices.assign(n_rows * _num_components, nop);
+    for (auto const& l : lines)
+    {
+        assert(l.comp_id < _num_components);
+        auto& gi = _global_indices[findRow(l.location) * _num_components +
+                                   l.comp_id];
+        // Keep the first line of duplicates.
+        if (gi != nop)
+            continue;
+        gi = l.global_index;
+        ++_size;
+    }
+}
+
+std::size_t ComponentGlobalIndexDict::findRow(
+    MeshLib::Location const& l) const
+{
+    std::size_t const not_found = std::numeric_limits<std::size_t>::max();
+    for (auto const& g : _groups)
+    {
+        if (g.mesh_id != l.mesh_id || g.item_type != l.item_type)
+            continue;
+
+        if (g.item_ids.empty())
+        {
+            if (l.item_id < g.first_item_id ||
+                l.item_id - g.first_item_id >= g.n_rows)
+                return not_found;
+            return g.row_offset + l.item_id - g.first_item_id;
+        }
+
+        auto const it = std::lower_bound(g.item_ids.cbegin(),
+                                         g.item_ids.cend(), l.item_id);
+        if (it == g.item_ids.cend() || *it != l.item_id)
+            return not_found;
+        return g.row_offset + (it - g.item_ids.cbegin());
+    }
+    return not_found;
+}
+
+GlobalIndexType const* ComponentGlobalIndexDict::find(
+    MeshLib::Location const& l) const
+{
+    std::size_t const row = findRow(l);
+    if (row == std::numeric_limits<std::size_t>::max())
+        return nullptr;
+    return _global_indices.data() + row * _num_components;
+}
+
+void ComponentGlobalIndexDict::renumberByLocation(GlobalIndexType offset)
+{
+    // The rows are sorted by location.
+    for (auto& gi : _global_indices)
+        if (gi != nop)
+            gi = offset++;
+}
+
+std::ostream& operator<<(std::ostream& os, ComponentGlobalIndexDict const& dict)
+{
+    for (auto const& g : dict._groups)
+        for (std::size_t row = 0; row < g.n_rows; ++row)
+        {
+            MeshLib::Location const l(g.mesh_id, g.item_type,
+                                      g.getItemId(row));
+            for (std::size_t c = 0; c < dict._num_components; ++c)
+            {
+                auto const gi = dict._global_indices
+                    [(g.row_offset + row) * dict._num_components + c];
+                if (gi != ComponentGlobalIndexDict::nop)
+                    os << Line(l, c, gi) << "\n";
+            }
+        }
+    return os;
+}
+
+}    // namespace detail
+}    // namespace AssemblerLib
@@ -13,13 +13,9 @@
 #ifndef ASSEMBLERLIB_COMPONENTGLOBALINDEXDICT_H_
 #define ASSEMBLERLIB_COMPONENTGLOBALINDEXDICT_H_
 
-#include <iostream>
+#include <iosfwd>
 #include <limits>
-
-#include <boost/multi_index/composite_key.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index_container.hpp>
+#include <vector>
 
 #include "MeshLib/Location.h"
 #include "ProcessLib/NumericsConfig.h"
@@ -56,67 +52,90 @@ struct Line
         global_index(std::numeric_limits<GlobalIndexType>::max())
     {}
 
-    friend std::ostream& operator<<(std::ostream& os, Line const& l)
-    {
-        return os << l.location << ", " << l.comp_id << ", " << l.global_index;
-    }
+    friend std::ostream& operator<<(std::ostream& os, Line const& l);
 };
 
-struct LineByLocationComparator
+/// Flat table of the global indices of all (location, component) pairs.
+///
+/// The locations are grouped by mesh and mesh item type. The item ids of a
+/// group are either covering a dense range, which is indexed directly, or are
+/// stored sorted for a binary search, e.g. for the scattered nodes of a
+/// boundary subset. For each location the global indices of all components
+/// are stored contiguously in one row of the table; components not present at
+/// a location are marked by the #nop value.
+class ComponentGlobalIndexDict
 {
-    bool operator()(Line const& a, Line const& b) const
-    {
-        return a.location < b.location;
-    }
-};
+public:
+    /// Marks a component not present at a location.
+    static GlobalIndexType const nop =
+        std::numeric_limits<GlobalIndexType>::max();
 
-struct LineByLocationAndComponentComparator
-{
-    bool operator()(Line const& a, Line const& b) const
+    ComponentGlobalIndexDict() = default;
+
+    /// Creates the table from the given lines. If a (location, component)
+    /// pair is given more than once, the first line is used.
+    /// \param num_components the number of component ids, i.e. all component
+    ///        ids of the lines are smaller.
+    ComponentGlobalIndexDict(std::vector<Line>&& lines,
+                             std::size_t const num_components);
+
+    /// Number of stored (location, component) pairs.
+    std::size_t size() const { return _size; }
+
+    /// Number of components per location, i.e. the length of a row.
+    std::size_t getNumComponents() const { return _num_components; }
+
+    /// Returns the row of global indices of all components at the location
+    /// \c l, or nullptr if the location is not stored.
+    GlobalIndexType const* find(MeshLib::Location const& l) const;
+
+    /// Renumbers the global indices in the order of the locations and then of
+    /// the components starting with the given offset.
+    void renumberByLocation(GlobalIndexType offset);
+
+    /// Prints all lines in the order of the locations.
+    friend std::ostream& operator<<(std::ostream& os,
+                                    ComponentGlobalIndexDict const& dict);
+
+private:
+    /// Locations of the same mesh and item type.
+    struct Group
     {
-        if (a.location < b.location)
-            return true;
-        if (b.location < a.location)
-            return false;
-
-        // a.loc == b.loc
-        return a.comp_id < b.comp_id;
-    }
-};
+        std::size_t mesh_id;
+        MeshLib::MeshItemType item_type;
+
+        /// First row of the group in the table.
+        std::size_t row_offset;
+        /// Number of rows of the group.
+        std::size_t n_rows;
+
+        /// Item id of the first row for dense groups, where the row of an
+        /// item is its id minus the first id.
+        std::size_t first_item_id;
+        /// Sorted item ids of the rows for sparse groups; empty for dense
+        /// groups.
+        std::vector<std::size_t> item_ids;
+
+        std::size_t getItemId(std::size_t const row) const
+        {
+            return item_ids.empty() ? first_item_id + row : item_ids[row];
+        }
+    };
 
-struct ByLocation {};
-struct ByLocationAndComponent {};
-struct ByComponent {};
-struct ByGlobalIndex {};
-
-typedef boost::multi_index::multi_index_container<
-        Line,
-        boost::multi_index::indexed_by
-        <
-            boost::multi_index::ordered_unique
-            <
-                boost::multi_index::tag<ByLocationAndComponent>,
-                boost::multi_index::identity<Line>,
-                LineByLocationAndComponentComparator
-            >,
-            boost::multi_index::ordered_non_unique
-            <
-                boost::multi_index::tag<ByLocation>,
-                boost::multi_index::identity<Line>,
-                LineByLocationComparator
-            >,
-            boost::multi_index::ordered_non_unique
-            <
-                boost::multi_index::tag<ByComponent>,
-                boost::multi_index::member<Line, std::size_t, &Line::comp_id>
-            >,
-            boost::multi_index::ordered_non_unique
-            <
-                boost::multi_index::tag<ByGlobalIndex>,
-                boost::multi_index::member<Line, GlobalIndexType, &Line::global_index>
-            >
-        >
-    > ComponentGlobalIndexDict;
+    /// Returns the table row of the location \c l, or the maximum value of
+    /// std::size_t if the location is not stored.
+    std::size_t findRow(MeshLib::Location const& l) const;
+
+    std::vector<Group> _groups;
+
+    std::size_t _num_components = 0;
+
+    /// Global indices of all locations (rows) and components (columns) in
+    /// row-major order.
+    std::vector<GlobalIndexType> _global_indices;
+
+    std::size_t _size = 0;
+};
 
 }    // namespace detail
 }    // namespace AssemblerLib
@@ -0,0 +1,69 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+
+#include "MeshLib/Elements/Element.h"
+
+#include "ComputeElementColoring.h"
+
+namespace AssemblerLib
+{
+
+ElementColoring
+computeElementColoring(std::vector<MeshLib::Element*> const& elements)
+{
+    std::size_t n_nodes = 0;
+    for (auto const* e : elements)
+        for (unsigned i = 0; i < e->getNNodes(); ++i)
+            n_nodes = std::max<std::size_t>(n_nodes, e->getNodeIndex(i) + 1);
+
+    // Stores for each node the last color (shifted by one) it was used in.
+    // This avoids resetting the marks for each new color.
+    std::vector<std::size_t> node_color(n_nodes, 0);
+
+    std::vector<std::size_t> uncolored(elements.size());
+    for (std::size_t i = 0; i < uncolored.size(); ++i)
+        uncolored[i] = i;
+
+    ElementColoring coloring;
+    std::vector<std::size_t> remaining;
+    while (!uncolored.empty())
+    {
+        std::size_t const color = coloring.size() + 1;
+        coloring.emplace_back();
+        auto& color_class = coloring.back();
+
+        remaining.clear();
+        for (auto const i : uncolored)
+        {
+            auto const& e = *elements[i];
+            unsigned const n = e.getNNodes();
+
+            bool conflict = false;
+            for (unsigned k = 0; k < n && !conflict; ++k)
+                conflict = node_color[e.getNodeIndex(k)] == color;
+
+            if (conflict)
+            {
+                remaining.push_back(i);
+                continue;
+            }
+
+            for (unsigned k = 0; k < n; ++k)
+                node_color[e.getNodeIndex(k)] = color;
+            color_class.push_back(i);
+        }
+        uncolored.swap(remaining);
+    }
+
+    return coloring;
+}
+
+}
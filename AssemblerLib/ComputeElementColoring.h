@@ -0,0 +1,45 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_COMPUTEELEMENTCOLORING_H
+#define ASSEMBLERLIB_COMPUTEELEMENTCOLORING_H
+
+#include <cstddef>
+#include <vector>
+
+namespace MeshLib
+{
+class Element;
+}
+
+namespace AssemblerLib
+{
+
+/// Partition of element positions into color classes. Elements of the same
+/// color do not share any node, hence their contributions go into distinct
+/// rows of the global matrix and the right-hand-side vector.
+using ElementColoring = std::vector<std::vector<std::size_t>>;
+
+/**
+ * @brief Computes a greedy coloring of the given elements.
+ *
+ * Two elements are in conflict if they share a node. Each color class is
+ * filled with the first elements (in the order of the input vector) not
+ * conflicting with the elements already in the class.
+ *
+ * @param elements  elements to be colored, e.g. the mesh elements or the
+ *                  boundary elements of a Neumann boundary condition.
+ *
+ * @return The color classes containing positions in the \c elements vector.
+ */
+ElementColoring
+computeElementColoring(std::vector<MeshLib::Element*> const& elements);
+}
+
+#endif // ASSEMBLERLIB_COMPUTEELEMENTCOLORING_H
@@ -7,6 +7,9 @@
  *
  */
 
+#include <algorithm>
+#include <numeric>
+
 #include "MeshLib/NodeAdjacencyTable.h"
 #include "LocalToGlobalIndexMap.h"
 
@@ -54,4 +57,86 @@ computeSparsityPattern(LocalToGlobalIndexMap const& dof_table,
     return sparsity_pattern;
 }
 
+CompressedSparsityPattern
+computeCompressedSparsityPattern(LocalToGlobalIndexMap const& dof_table)
+{
+    std::size_t const n_rows = dof_table.dofSize();
+
+    // Indices not being rows of the matrix, e.g. marking components missing
+    // at a location, are skipped.
+    auto const isRow = [n_rows](GlobalIndexType const i)
+    {
+        return static_cast<std::size_t>(i) < n_rows;
+    };
+
+    // The mesh items of each row in compressed storage.
+    std::vector<std::size_t> item_offsets(n_rows + 1, 0);
+    for (std::size_t id = 0; id < dof_table.size(); ++id)
+        for (auto const i : dof_table(id).rows)
+            if (isRow(i))
+                ++item_offsets[i + 1];
+    std::partial_sum(item_offsets.begin(), item_offsets.end(),
+                     item_offsets.begin());
+
+    std::vector<std::size_t> items(item_offsets.back());
+    {
+        std::vector<std::size_t> fill(item_offsets.begin(),
+                                      item_offsets.end() - 1);
+        for (std::size_t id = 0; id < dof_table.size(); ++id)
+            for (auto const i : dof_table(id).rows)
+                if (isRow(i))
+                    items[fill[i]++] = id;
+    }
+
+    // Collects the sorted and unique columns of a row coupled by its items.
+    auto const getColumns = [&](std::size_t const row,
+                                std::vector<GlobalIndexType>& columns)
+    {
+        columns.clear();
+        for (std::size_t k = item_offsets[row]; k < item_offsets[row + 1]; ++k)
+            for (auto const i : dof_table(items[k]).rows)
+                if (isRow(i))
+                    columns.push_back(i);
+        std::sort(columns.begin(), columns.end());
+        columns.erase(std::unique(columns.begin(), columns.end()),
+                      columns.end());
+    };
+
+    CompressedSparsityPattern sparsity_pattern;
+    sparsity_pattern.row_ptr.assign(n_rows + 1, 0);
+
+    // The columns are computed twice, first for the row sizes and then for
+    // the column indices, so that no additional storage is needed.
+    OPENMP_LOOP_TYPE const n = n_rows;
+    #pragma omp parallel
+    {
+        std::vector<GlobalIndexType> columns;
+        #pragma omp for
+        for (OPENMP_LOOP_TYPE row = 0; row < n; row++)
+        {
+            getColumns(row, columns);
+            sparsity_pattern.row_ptr[row + 1] = columns.size();
+        }
+    }
+    std::partial_sum(sparsity_pattern.row_ptr.begin(),
+                     sparsity_pattern.row_ptr.end(),
+                     sparsity_pattern.row_ptr.begin());
+
+    sparsity_pattern.col_idx.resize(sparsity_pattern.row_ptr.back());
+    #pragma omp parallel
+    {
+        std::vector<GlobalIndexType> columns;
+        #pragma omp for
+        for (OPENMP_LOOP_TYPE row = 0; row < n; row++)
+        {
+            getColumns(row, columns);
+            std::copy(columns.cbegin(), columns.cend(),
+                      sparsity_pattern.col_idx.begin() +
+                          sparsity_pattern.row_ptr[row]);
+        }
+    }
+
+    return sparsity_pattern;
+}
+
 }
@@ -12,6 +12,7 @@
 
 #include <vector>
 
+#include "MathLib/LinAlg/CompressedSparsityPattern.h"
 #include "ProcessLib/NumericsConfig.h"
 
 namespace MeshLib
@@ -39,6 +40,24 @@ computeSparsityPattern(
         LocalToGlobalIndexMap const& dof_table,
         MeshLib::Mesh const& mesh
         );
+
+/// The column indices of the non-zero entries of each global matrix row.
+using CompressedSparsityPattern =
+    MathLib::CompressedSparsityPattern<GlobalIndexType>;
+
+/**
+ * @brief Computes the exact compressed sparsity pattern of the global matrix.
+ *
+ * The pattern contains all entries coupled by the mesh items of the
+ * \c dof_table, i.e. the entries added by the VectorMatrixAssembler. The rows
+ * are computed in parallel if OpenMP is enabled.
+ *
+ * @param dof_table            maps mesh items to global indices
+ *
+ * @return The computed sparsity pattern with sorted and unique columns.
+ */
+CompressedSparsityPattern
+computeCompressedSparsityPattern(LocalToGlobalIndexMap const& dof_table);
 }
 
 #endif // ASSEMBLERLIB_COMPUTESPARSITYPATTERN_H
@@ -0,0 +1,90 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "GlobalMatrixScatterMap.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "LocalToGlobalIndexMap.h"
+
+namespace AssemblerLib
+{
+
+#ifdef OGS_USE_EIGEN
+void freezeMatrixStructure(
+    MathLib::EigenMatrix& A, LocalToGlobalIndexMap const& dof_table)
+{
+    auto& mat = A.getRawMatrix();
+    bool const symmetric = A.isSymmetric();
+
+    // Insert explicit zeros for the missing entries; a symmetric matrix
+    // stores the upper triangle only.
+    for (std::size_t id = 0; id < dof_table.size(); ++id)
+    {
+        // Global indices of an element ordered by component, as assembled
+        // by the VectorMatrixAssembler.
+        auto const indices = dof_table(id).rows;
+        for (auto const r : indices)
+            for (auto const c : indices)
+                if (!symmetric || r <= c)
+                    mat.coeffRef(r, c);
+    }
+    A.freezeStructure();
+}
+
+GlobalMatrixScatterMap createScatterMap(
+    MathLib::EigenMatrix& A, LocalToGlobalIndexMap const& dof_table)
+{
+    freezeMatrixStructure(A, dof_table);
+
+    auto const& mat = A.getRawMatrix();
+    bool const symmetric = A.isSymmetric();
+    auto const* const outer = mat.outerIndexPtr();
+    auto const* const inner = mat.innerIndexPtr();
+
+    GlobalMatrixScatterMap map;
+    map._offsets.reserve(dof_table.size() + 1);
+    map._offsets.push_back(0);
+    for (std::size_t id = 0; id < dof_table.size(); ++id)
+    {
+        auto const indices = dof_table(id).rows;
+        auto const position = [outer, inner](GlobalIndexType const r,
+                                              GlobalIndexType const c)
+        {
+            auto const* const row_begin = inner + outer[r];
+            auto const* const row_end = inner + outer[r + 1];
+            auto const* const it = std::lower_bound(row_begin, row_end, c);
+            assert(it != row_end && *it == c);
+            return static_cast<GlobalIndexType>(it - inner);
+        };
+
+        // For symmetric matrices the upper triangle of the local matrix is
+        // mapped to the global upper triangle.
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            if (!symmetric)
+            {
+                for (std::size_t j = 0; j < indices.size(); ++j)
+                    map._positions.push_back(position(indices[i], indices[j]));
+                continue;
+            }
+            for (std::size_t j = i; j < indices.size(); ++j)
+                map._positions.push_back(
+                    position(std::min(indices[i], indices[j]),
+                             std::max(indices[i], indices[j])));
+        }
+        map._offsets.push_back(map._positions.size());
+    }
+
+    return map;
+}
+#endif
+
+}   // namespace AssemblerLib
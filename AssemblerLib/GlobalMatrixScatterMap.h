@@ -0,0 +1,96 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_GLOBALMATRIXSCATTERMAP_H_
+#define ASSEMBLERLIB_GLOBALMATRIXSCATTERMAP_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "ProcessLib/NumericsConfig.h"
+
+#ifdef OGS_USE_EIGEN
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#endif
+
+namespace AssemblerLib
+{
+class LocalToGlobalIndexMap;
+
+/// Positions of the local element matrix entries in the value storage of a
+/// global matrix with fixed structure.
+///
+/// For each element the positions of the n x n local matrix entries are
+/// stored in row-major order, where the local matrix is ordered by component
+/// as done by the VectorMatrixAssembler. For a symmetric matrix storing its
+/// upper triangle only the positions of the local upper triangle are stored.
+/// The map is only valid as long as the structure of the global matrix does
+/// not change.
+class GlobalMatrixScatterMap
+{
+public:
+    /// Returns true if no positions are stored, i.e. the global matrix type
+    /// does not support direct access to its value storage.
+    bool empty() const { return _positions.empty(); }
+
+    /// Returns the positions for the local matrix of the element \c id.
+    GlobalIndexType const* getPositions(std::size_t const id) const
+    {
+        return _positions.data() + _offsets[id];
+    }
+
+private:
+    /// Offsets into the #_positions for each element. The last entry is the
+    /// total number of positions.
+    std::vector<std::size_t> _offsets;
+
+    /// Positions of all elements' local matrix entries.
+    std::vector<GlobalIndexType> _positions;
+
+#ifdef OGS_USE_EIGEN
+    friend GlobalMatrixScatterMap createScatterMap(
+        MathLib::EigenMatrix& A, LocalToGlobalIndexMap const& dof_table);
+#endif
+};
+
+/// Generic variant for global matrices without a fixed structure; nothing is
+/// done.
+template <typename GlobalMatrix>
+void freezeMatrixStructure(
+    GlobalMatrix& /*A*/, LocalToGlobalIndexMap const& /*dof_table*/)
+{
+}
+
+/// Generic variant for global matrices without access to their value storage;
+/// an empty scatter map is returned.
+template <typename GlobalMatrix>
+GlobalMatrixScatterMap createScatterMap(
+    GlobalMatrix& /*A*/, LocalToGlobalIndexMap const& /*dof_table*/)
+{
+    return GlobalMatrixScatterMap();
+}
+
+#ifdef OGS_USE_EIGEN
+/// Inserts all entries coupled by the elements of the \c dof_table into the
+/// matrix \c A and freezes its structure.
+/// \note The matrix should be preallocated using setMatrixSparsity() for
+/// fast insertion. Afterwards only the values of the matrix are changed, see
+/// MathLib::EigenMatrix::freezeStructure().
+void freezeMatrixStructure(
+    MathLib::EigenMatrix& A, LocalToGlobalIndexMap const& dof_table);
+
+/// Freezes the structure of the matrix \c A as freezeMatrixStructure() does,
+/// and computes the value positions of the entries of each element.
+GlobalMatrixScatterMap createScatterMap(
+    MathLib::EigenMatrix& A, LocalToGlobalIndexMap const& dof_table);
+#endif
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_GLOBALMATRIXSCATTERMAP_H_
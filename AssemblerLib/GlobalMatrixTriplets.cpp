@@ -0,0 +1,147 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "GlobalMatrixTriplets.h"
+
+#include <algorithm>
+
+namespace AssemblerLib
+{
+
+void GlobalMatrixTriplets::clear()
+{
+#ifdef _OPENMP
+    std::size_t const n_threads = omp_get_max_threads();
+#else
+    std::size_t const n_threads = 1;
+#endif
+    if (_buffers.size() < n_threads)
+        _buffers.resize(n_threads);
+
+    for (auto& buffer : _buffers)
+    {
+        buffer.matrix.clear();
+        buffer.vector.clear();
+    }
+    _row_offsets.clear();
+    _columns.clear();
+    _values.clear();
+    _vector.clear();
+}
+
+void GlobalMatrixTriplets::compress(std::size_t const n_rows)
+{
+    compressTriplets(&ThreadBuffer::matrix, n_rows, _row_offsets, _columns,
+                     _values);
+
+    // The vector triplets have a single column; each row has at most one
+    // compressed entry.
+    std::vector<GlobalIndexType> vector_offsets;
+    std::vector<GlobalIndexType> vector_columns;
+    std::vector<double> vector_values;
+    compressTriplets(&ThreadBuffer::vector, n_rows, vector_offsets,
+                     vector_columns, vector_values);
+
+    _vector.assign(n_rows, 0.0);
+    for (std::size_t r = 0; r < n_rows; ++r)
+        if (vector_offsets[r] != vector_offsets[r + 1])
+            _vector[r] = vector_values[vector_offsets[r]];
+}
+
+void GlobalMatrixTriplets::compressTriplets(
+    std::vector<Triplet> ThreadBuffer::*const triplets,
+    std::size_t const n_rows,
+    std::vector<GlobalIndexType>& row_offsets,
+    std::vector<GlobalIndexType>& columns,
+    std::vector<double>& values)
+{
+    std::size_t const n_buffers = _buffers.size();
+
+    // Number of triplets of each buffer per row, stored buffer by buffer.
+    std::vector<std::size_t> positions(n_buffers * n_rows, 0);
+    OPENMP_LOOP_TYPE const n_b = n_buffers;
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE b = 0; b < n_b; b++)
+    {
+        std::size_t* const counts = positions.data() + b * n_rows;
+        for (auto const& t : _buffers[b].*triplets)
+            counts[t.row]++;
+    }
+
+    // Exclusive prefix sums in the order of the rows, and of the buffers
+    // within a row, give the first position of each buffer's triplets of a
+    // row.
+    std::vector<std::size_t> row_begin(n_rows + 1);
+    std::size_t n = 0;
+    for (std::size_t r = 0; r < n_rows; ++r)
+    {
+        row_begin[r] = n;
+        for (std::size_t b = 0; b < n_buffers; ++b)
+        {
+            std::size_t const count = positions[b * n_rows + r];
+            positions[b * n_rows + r] = n;
+            n += count;
+        }
+    }
+    row_begin[n_rows] = n;
+
+    _sorted.resize(n);
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE b = 0; b < n_b; b++)
+    {
+        std::size_t* const position = positions.data() + b * n_rows;
+        for (auto const& t : _buffers[b].*triplets)
+            _sorted[position[t.row]++] = t;
+    }
+
+    // Sort each row by column and mesh item id and sum the equal columns at
+    // the beginning of the row; the sum is taken in the order of the ids.
+    std::vector<std::size_t> row_sizes(n_rows);
+    OPENMP_LOOP_TYPE const n_r = n_rows;
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE r = 0; r < n_r; r++)
+    {
+        auto const begin = _sorted.begin() + row_begin[r];
+        auto const end = _sorted.begin() + row_begin[r + 1];
+        std::sort(begin, end, [](Triplet const& a, Triplet const& b)
+                  {
+                      return a.col < b.col || (a.col == b.col && a.id < b.id);
+                  });
+
+        std::size_t k = 0;
+        for (auto it = begin; it != end; ++it)
+        {
+            if (k > 0 && begin[k - 1].col == it->col)
+                begin[k - 1].value += it->value;
+            else
+                begin[k++] = *it;
+        }
+        row_sizes[r] = k;
+    }
+
+    row_offsets.resize(n_rows + 1);
+    row_offsets[0] = 0;
+    for (std::size_t r = 0; r < n_rows; ++r)
+        row_offsets[r + 1] = row_offsets[r] + row_sizes[r];
+
+    columns.resize(row_offsets[n_rows]);
+    values.resize(row_offsets[n_rows]);
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE r = 0; r < n_r; r++)
+    {
+        for (std::size_t k = 0; k < row_sizes[r]; ++k)
+        {
+            auto const& t = _sorted[row_begin[r] + k];
+            columns[row_offsets[r] + k] = t.col;
+            values[row_offsets[r] + k] = t.value;
+        }
+    }
+}
+
+}   // namespace AssemblerLib
@@ -0,0 +1,135 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_GLOBALMATRIXTRIPLETS_H_
+#define ASSEMBLERLIB_GLOBALMATRIXTRIPLETS_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "ProcessLib/NumericsConfig.h"
+
+namespace AssemblerLib
+{
+
+/// Global matrix and vector collected as (row, column, value) triplets.
+///
+/// The local matrices and vectors are appended to buffers of the calling
+/// thread, hence the elements can be assembled concurrently without coloring
+/// and without knowing the sparsity pattern. compress() then sorts and sums
+/// the triplets into compressed rows. The entries of the same position are
+/// summed in the order of the mesh item ids, so the result does not depend on
+/// the number of threads or on the order in which the items were added.
+class GlobalMatrixTriplets
+{
+public:
+    /// Removes all triplets and the compressed rows but keeps the allocated
+    /// memory; must be called outside of parallel regions.
+    void clear();
+
+    /// Appends the local matrix and vector of the mesh item \c id to the
+    /// buffer of the calling thread.
+    /// \param indices global indices of the local matrix' rows and columns
+    ///                and of the local vector's entries, e.g. a vector or an
+    ///                index span.
+    template <typename Indices, typename LocalMatrix, typename LocalVector>
+    void add(std::size_t const id, Indices const& indices,
+             LocalMatrix const& local_matrix, LocalVector const& local_vector)
+    {
+        auto& buffer = getThreadBuffer();
+        std::size_t const n = indices.size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+                buffer.matrix.push_back(
+                    {indices[i], indices[j], id, local_matrix(i, j)});
+            buffer.vector.push_back({indices[i], 0, id, local_vector[i]});
+        }
+    }
+
+    /// Sorts and sums all triplets into compressed rows of a matrix and a
+    /// vector with \c n_rows rows.
+    ///
+    /// The triplets are bucketed by row with a parallel counting sort, i.e.
+    /// one radix pass with the row as digit; the short rows are then sorted
+    /// by column and mesh item id, and the equal positions are summed.
+    void compress(std::size_t const n_rows);
+
+    /// Offsets of the rows in getColumns() and getValues() after compress();
+    /// the last entry is the number of non-zero entries.
+    std::vector<GlobalIndexType> const& getRowOffsets() const
+    {
+        return _row_offsets;
+    }
+
+    /// Column indices of the non-zero entries in row-major order.
+    std::vector<GlobalIndexType> const& getColumns() const { return _columns; }
+
+    /// Values of the non-zero entries in row-major order.
+    std::vector<double> const& getValues() const { return _values; }
+
+    /// Summed vector entries, one for each of the compressed rows.
+    std::vector<double> const& getVector() const { return _vector; }
+
+private:
+    struct Triplet
+    {
+        GlobalIndexType row;
+        GlobalIndexType col;
+        std::size_t id;
+        double value;
+    };
+
+    struct ThreadBuffer
+    {
+        std::vector<Triplet> matrix;
+        std::vector<Triplet> vector;
+    };
+
+    ThreadBuffer& getThreadBuffer()
+    {
+#ifdef _OPENMP
+        std::size_t const thread_id = omp_get_thread_num();
+#else
+        std::size_t const thread_id = 0;
+#endif
+        // The buffers are allocated for the maximum number of threads by
+        // clear().
+        assert(thread_id < _buffers.size());
+        return _buffers[thread_id];
+    }
+
+    /// Sorts and sums the triplets of all buffers' \c triplets member into
+    /// compressed rows.
+    void compressTriplets(std::vector<Triplet> ThreadBuffer::*const triplets,
+                          std::size_t const n_rows,
+                          std::vector<GlobalIndexType>& row_offsets,
+                          std::vector<GlobalIndexType>& columns,
+                          std::vector<double>& values);
+
+    /// Buffers of each thread, indexed by the OpenMP thread number.
+    std::vector<ThreadBuffer> _buffers;
+
+    std::vector<GlobalIndexType> _row_offsets;
+    std::vector<GlobalIndexType> _columns;
+    std::vector<double> _values;
+    std::vector<double> _vector;
+
+    /// Triplets sorted by row; reused by compress().
+    std::vector<Triplet> _sorted;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_GLOBALMATRIXTRIPLETS_H_
@@ -46,6 +46,13 @@ struct GlobalSetup
         return Executor::execute(std::forward<Args>(args)...);
     }
 
+    template <typename... Args>
+    static
+    void executeColored(Args&& ... args)
+    {
+        return Executor::executeColored(std::forward<Args>(args)...);
+    }
+
     GlobalSetup() { }
 };
 
@@ -0,0 +1,105 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_LOCALASSEMBLERARENA_H_
+#define ASSEMBLERLIB_LOCALASSEMBLERARENA_H_
+
+#include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace AssemblerLib
+{
+
+/// Owns local assemblers of different types derived from a common interface.
+///
+/// The local assemblers of one type are stored contiguously in one block in the
+/// order of their construction, instead of being allocated individually. The
+/// block size is fixed by reserve(); the objects are never moved and are
+/// destroyed together with the arena.
+template <typename LocalAssemblerInterface>
+class LocalAssemblerArena
+{
+public:
+    LocalAssemblerArena() = default;
+    LocalAssemblerArena(LocalAssemblerArena const&) = delete;
+    LocalAssemblerArena& operator=(LocalAssemblerArena const&) = delete;
+
+    /// Allocates a block for \c n objects of type \c LocalAssembler replacing a
+    /// previously allocated block of this type.
+    template <typename LocalAssembler>
+    void reserve(std::size_t const n)
+    {
+        static_assert(
+            std::is_base_of<LocalAssemblerInterface, LocalAssembler>::value,
+            "The local assembler must implement the interface.");
+        _blocks[std::type_index(typeid(LocalAssembler))].reset(
+            new Block<LocalAssembler>(n));
+    }
+
+    /// Default-constructs the next object in the block of type
+    /// \c LocalAssembler, which must have been reserved before.
+    template <typename LocalAssembler>
+    LocalAssembler* emplace()
+    {
+        auto const it = _blocks.find(std::type_index(typeid(LocalAssembler)));
+        assert(it != _blocks.end());
+        return static_cast<Block<LocalAssembler>&>(*it->second).emplace();
+    }
+
+    /// Destroys all objects and releases the blocks.
+    void clear() { _blocks.clear(); }
+
+private:
+    class BlockBase
+    {
+    public:
+        virtual ~BlockBase() = default;
+    };
+
+    template <typename T>
+    class Block : public BlockBase
+    {
+        using Storage =
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    public:
+        explicit Block(std::size_t const capacity)
+            : _storage(new Storage[capacity]), _capacity(capacity)
+        {
+        }
+
+        ~Block()
+        {
+            for (std::size_t i = _size; i > 0; --i)
+                reinterpret_cast<T*>(&_storage[i - 1])->~T();
+        }
+
+        T* emplace()
+        {
+            assert(_size < _capacity);
+            return new (&_storage[_size++]) T;
+        }
+
+    private:
+        std::unique_ptr<Storage[]> _storage;
+        std::size_t const _capacity;
+        std::size_t _size = 0;
+    };
+
+    std::unordered_map<std::type_index, std::unique_ptr<BlockBase>> _blocks;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_LOCALASSEMBLERARENA_H_
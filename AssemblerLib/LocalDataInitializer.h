@@ -10,10 +10,15 @@
 #ifndef ASSEMBLER_LIB_LOCALDATAINITIALIZER_H_
 #define ASSEMBLER_LIB_LOCALDATAINITIALIZER_H_
 
+#include <cassert>
+#include <cstdlib>
 #include <functional>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <vector>
+
+#include <logog/include/logog.hpp>
 
 #include "MeshLib/Elements/Elements.h"
 
@@ -36,6 +41,8 @@
 #include "NumLib/Fem/ShapeFunction/ShapeTri3.h"
 #include "NumLib/Fem/ShapeFunction/ShapeTri6.h"
 
+#include "LocalAssemblerArena.h"
+
 namespace AssemblerLib
 {
 
@@ -44,6 +51,10 @@ namespace AssemblerLib
 /// initialization of the new local assembler data.
 /// For example for MeshLib::Line a local assembler data with template argument
 /// NumLib::ShapeLine2 is created.
+///
+/// The local assembler data is created by allocate() in a LocalAssemblerArena,
+/// where the data of all elements of the same type is stored contiguously in
+/// element order; operator() then initializes the data of single elements.
 template <
     template <typename, typename> class LocalAssemblerDataInterface_,
     template <typename, typename, typename, typename, unsigned> class LocalAssemblerData_,
@@ -62,60 +73,97 @@ class LocalDataInitializer
                 IntegrationMethod<ShapeFunction_>,
                 GlobalMatrix_, GlobalVector_, GlobalDim>;
 
-
 public:
+    using LocalAssemblerInterface =
+        LocalAssemblerDataInterface_<GlobalMatrix_, GlobalVector_>;
+    using Arena = LocalAssemblerArena<LocalAssemblerInterface>;
+
     LocalDataInitializer()
     {
-        _builder[std::type_index(typeid(MeshLib::Hex20))] =
-            [](){ return new LAData<NumLib::ShapeHex20>; };
-        _builder[std::type_index(typeid(MeshLib::Hex))] =
-            [](){ return new LAData<NumLib::ShapeHex8>; };
-        _builder[std::type_index(typeid(MeshLib::Line))] =
-            [](){ return new LAData<NumLib::ShapeLine2>; };
-        _builder[std::type_index(typeid(MeshLib::Line3))] =
-            [](){ return new LAData<NumLib::ShapeLine3>; };
-        _builder[std::type_index(typeid(MeshLib::Point))] =
-            [](){ return new LAData<NumLib::ShapePoint1>; };
-        _builder[std::type_index(typeid(MeshLib::Prism15))] =
-            [](){ return new LAData<NumLib::ShapePrism15>; };
-        _builder[std::type_index(typeid(MeshLib::Prism))] =
-            [](){ return new LAData<NumLib::ShapePrism6>; };
-        _builder[std::type_index(typeid(MeshLib::Pyramid13))] =
-            [](){ return new LAData<NumLib::ShapePyra13>; };
-        _builder[std::type_index(typeid(MeshLib::Pyramid))] =
-            [](){ return new LAData<NumLib::ShapePyra5>; };
-        _builder[std::type_index(typeid(MeshLib::Quad))] =
-            [](){ return new LAData<NumLib::ShapeQuad4>; };
-        _builder[std::type_index(typeid(MeshLib::Quad8))] =
-            [](){ return new LAData<NumLib::ShapeQuad8>; };
-        _builder[std::type_index(typeid(MeshLib::Quad9))] =
-            [](){ return new LAData<NumLib::ShapeQuad9>; };
-        _builder[std::type_index(typeid(MeshLib::Tet10))] =
-            [](){ return new LAData<NumLib::ShapeTet10>; };
-        _builder[std::type_index(typeid(MeshLib::Tet))] =
-            [](){ return new LAData<NumLib::ShapeTet4>; };
-        _builder[std::type_index(typeid(MeshLib::Tri))] =
-            [](){ return new LAData<NumLib::ShapeTri3>; };
-        _builder[std::type_index(typeid(MeshLib::Tri6))] =
-            [](){ return new LAData<NumLib::ShapeTri6>; };
+        addElementType<MeshLib::Hex20, NumLib::ShapeHex20>();
+        addElementType<MeshLib::Hex, NumLib::ShapeHex8>();
+        addElementType<MeshLib::Line, NumLib::ShapeLine2>();
+        addElementType<MeshLib::Line3, NumLib::ShapeLine3>();
+        addElementType<MeshLib::Point, NumLib::ShapePoint1>();
+        addElementType<MeshLib::Prism15, NumLib::ShapePrism15>();
+        addElementType<MeshLib::Prism, NumLib::ShapePrism6>();
+        addElementType<MeshLib::Pyramid13, NumLib::ShapePyra13>();
+        addElementType<MeshLib::Pyramid, NumLib::ShapePyra5>();
+        addElementType<MeshLib::Quad, NumLib::ShapeQuad4>();
+        addElementType<MeshLib::Quad8, NumLib::ShapeQuad8>();
+        addElementType<MeshLib::Quad9, NumLib::ShapeQuad9>();
+        addElementType<MeshLib::Tet10, NumLib::ShapeTet10>();
+        addElementType<MeshLib::Tet, NumLib::ShapeTet4>();
+        addElementType<MeshLib::Tri, NumLib::ShapeTri3>();
+        addElementType<MeshLib::Tri6, NumLib::ShapeTri6>();
+    }
+
+    /// Creates the (uninitialized) local assembler data of all elements in the
+    /// arena and stores pointers to them in \c data in the order of the
+    /// elements.
+    template <typename Elements>
+    void allocate(Elements const& elements,
+                  std::vector<LocalAssemblerInterface*>& data,
+                  Arena& arena) const
+    {
+        std::unordered_map<std::type_index, std::size_t> counts;
+        for (auto const* e : elements)
+            ++counts[std::type_index(typeid(*e))];
+
+        for (auto const& count : counts)
+            getCreator(count.first).reserve(arena, count.second);
+
+        data.resize(elements.size());
+        for (std::size_t i = 0; i < elements.size(); ++i)
+            data[i] = getCreator(std::type_index(typeid(*elements[i])))
+                          .emplace(arena);
     }
 
-    /// Sets the provided data_ptr to the newly created local assembler data and
-    /// calls init() forwarding all remaining arguments.
+    /// Calls init() of the local assembler data previously created by
+    /// allocate() forwarding all remaining arguments.
     template <typename ...Args_>
     void operator()(const MeshLib::Element& e,
-        LocalAssemblerDataInterface_<GlobalMatrix_, GlobalVector_>*& data_ptr, Args_&&... args)
+        LocalAssemblerInterface* data_ptr, Args_&&... args) const
     {
-        data_ptr = _builder[std::type_index(typeid(e))]();
+        assert(data_ptr && "The local assembler data must be allocated.");
         data_ptr->init(e, std::forward<Args_>(args)...);
     }
 
+private:
+    struct Creator
+    {
+        std::function<void(Arena&, std::size_t)> reserve;
+        std::function<LocalAssemblerInterface*(Arena&)> emplace;
+    };
+
+    template <typename MeshElement, typename ShapeFunction_>
+    void addElementType()
+    {
+        _builder[std::type_index(typeid(MeshElement))] = Creator{
+            [](Arena& arena, std::size_t const n)
+            {
+                arena.template reserve<LAData<ShapeFunction_>>(n);
+            },
+            [](Arena& arena) -> LocalAssemblerInterface*
+            {
+                return arena.template emplace<LAData<ShapeFunction_>>();
+            }};
+    }
+
+    Creator const& getCreator(std::type_index const type) const
+    {
+        auto const it = _builder.find(type);
+        if (it == _builder.end())
+        {
+            ERR("No local assembler for the element type %s.", type.name());
+            std::abort();
+        }
+        return it->second;
+    }
+
 private:
     /// Mapping of element types to local assembler constructors.
-    std::unordered_map<
-        std::type_index,
-        std::function<LocalAssemblerDataInterface_<GlobalMatrix_, GlobalVector_>*()>
-            > _builder;
+    std::unordered_map<std::type_index, Creator> _builder;
 };
 
 }   // namespace AssemblerLib
@@ -24,9 +24,10 @@ void
 LocalToGlobalIndexMap::findGlobalIndices(
     ElementIterator first, ElementIterator last,
     std::size_t const mesh_id,
-    const unsigned comp_id, const unsigned comp_id_write)
+    const unsigned comp_id, const unsigned comp_id_write,
+    Table& rows) const
 {
-    _rows.resize(std::distance(first, last), _mesh_subsets.size());
+    rows.resize(std::distance(first, last), _mesh_subsets.size());
 
     // For each element find the global indices for node/element
     // components.
@@ -35,7 +36,7 @@ LocalToGlobalIndexMap::findGlobalIndices(
     {
         std::size_t const nnodes = (*e)->getNNodes();
 
-        LineIndex indices;
+        std::vector<GlobalIndexType> indices;
         indices.reserve(nnodes);
 
         for (unsigned n = 0; n < nnodes; n++)
@@ -46,10 +47,29 @@ LocalToGlobalIndexMap::findGlobalIndices(
             indices.push_back(_mesh_component_map.getGlobalIndex(l, comp_id));
         }
 
-        _rows(elem_id, comp_id_write) = std::move(indices);
+        rows(elem_id, comp_id_write) = std::move(indices);
     }
 }
 
+void LocalToGlobalIndexMap::compressTable(Table const& rows)
+{
+    _size = rows.rows();
+
+    _offsets.clear();
+    _offsets.reserve(rows.size() + 1);
+    _offsets.push_back(0);
+    for (std::size_t e = 0; e < _size; ++e)
+        for (unsigned c = 0; c < rows.cols(); ++c)
+            _offsets.push_back(_offsets.back() + rows(e, c).size());
+
+    _indices.clear();
+    _indices.reserve(_offsets.back());
+    for (std::size_t e = 0; e < _size; ++e)
+        for (unsigned c = 0; c < rows.cols(); ++c)
+            _indices.insert(_indices.end(), rows(e, c).cbegin(),
+                            rows(e, c).cend());
+}
+
 
 LocalToGlobalIndexMap::LocalToGlobalIndexMap(
     std::vector<MeshLib::MeshSubsets*> const& mesh_subsets,
@@ -59,6 +79,7 @@ LocalToGlobalIndexMap::LocalToGlobalIndexMap(
     // For all MeshSubsets and each of their MeshSubset's and each element
     // of that MeshSubset save a line of global indices.
 
+    Table rows;
     unsigned comp_id = 0;
     for (MeshLib::MeshSubsets const* const mss : _mesh_subsets)
     {
@@ -67,10 +88,11 @@ LocalToGlobalIndexMap::LocalToGlobalIndexMap(
             std::size_t const mesh_id = ms->getMeshID();
 
             findGlobalIndices(ms->elementsBegin(), ms->elementsEnd(), mesh_id,
-                              comp_id, comp_id);
+                              comp_id, comp_id, rows);
         }
         ++comp_id;
     }
+    compressTable(rows);
 }
 
 LocalToGlobalIndexMap::LocalToGlobalIndexMap(
@@ -85,6 +107,7 @@ LocalToGlobalIndexMap::LocalToGlobalIndexMap(
     // For all MeshSubsets and each of their MeshSubset's and each element
     // of that MeshSubset save a line of global indices.
 
+    Table rows;
     unsigned comp_id = 0;
     for (MeshLib::MeshSubsets const* const mss : _mesh_subsets)
     {
@@ -94,10 +117,11 @@ LocalToGlobalIndexMap::LocalToGlobalIndexMap(
             std::size_t const mesh_id = ms->getMeshID();
 
             findGlobalIndices(elements.cbegin(), elements.cend(), mesh_id,
-                              original_indices[comp_id], comp_id);
+                              original_indices[comp_id], comp_id, rows);
         }
         ++comp_id;
     }
+    compressTable(rows);
 }
 
 LocalToGlobalIndexMap*
@@ -131,27 +155,7 @@ LocalToGlobalIndexMap::dofSize() const
 std::size_t
 LocalToGlobalIndexMap::size() const
 {
-    return _rows.rows();
-}
-
-LocalToGlobalIndexMap::RowColumnIndices
-LocalToGlobalIndexMap::operator()(std::size_t const mesh_item_id, const unsigned component_id) const
-{
-    return RowColumnIndices(_rows(mesh_item_id, component_id),
-                            _columns(mesh_item_id, component_id));
-}
-
-std::size_t
-LocalToGlobalIndexMap::getNumElementDOF(std::size_t const mesh_item_id) const
-{
-    std::size_t ndof = 0;
-
-    for (unsigned c=0; c<_rows.cols(); ++c)
-    {
-        ndof += _rows(mesh_item_id, c).size();
-    }
-
-    return ndof;
+    return _size;
 }
 
 #ifndef NDEBUG
@@ -160,13 +164,13 @@ std::ostream& operator<<(std::ostream& os, LocalToGlobalIndexMap const& map)
     std::size_t const max_lines = 10;
     std::size_t lines_printed = 0;
 
-    os << "Rows of the local to global index map; " << map._rows.size()
-        << " rows\n";
+    os << "Rows of the local to global index map; "
+        << map.size() * map.getNumComponents() << " rows\n";
     for (std::size_t e=0; e<map.size(); ++e)
     {
         for (std::size_t c=0; c<map.getNumComponents(); ++c)
         {
-            auto const& line = map._rows(e, c);
+            auto const line = map(e, c).rows;
 
             os << "c" << c << " { ";
             std::copy(line.cbegin(), line.cend(),
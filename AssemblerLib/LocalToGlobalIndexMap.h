@@ -86,9 +86,29 @@ public:
 
     std::size_t getNumComponents() const { return _mesh_subsets.size(); }
 
-    RowColumnIndices operator()(std::size_t const mesh_item_id, const unsigned component_id) const;
+    /// Returns the indices of the given component of the mesh item. The
+    /// returned object refers to the storage of this map.
+    RowColumnIndices operator()(std::size_t const mesh_item_id, const unsigned component_id) const
+    {
+        std::size_t const cell = mesh_item_id * getNumComponents() + component_id;
+        return getRowColumnIndices(_offsets[cell], _offsets[cell + 1]);
+    }
+
+    /// Returns the indices of all components of the mesh item ordered by
+    /// component, i.e. the row and column indices of the local matrix of the
+    /// mesh item. The returned object refers to the storage of this map.
+    RowColumnIndices operator()(std::size_t const mesh_item_id) const
+    {
+        std::size_t const cell = mesh_item_id * getNumComponents();
+        return getRowColumnIndices(_offsets[cell],
+                                   _offsets[cell + getNumComponents()]);
+    }
 
-    std::size_t getNumElementDOF(std::size_t const mesh_item_id) const;
+    std::size_t getNumElementDOF(std::size_t const mesh_item_id) const
+    {
+        std::size_t const cell = mesh_item_id * getNumComponents();
+        return _offsets[cell + getNumComponents()] - _offsets[cell];
+    }
 
     GlobalIndexType getGlobalIndex(MeshLib::Location const& l,
                                std::size_t const c) const
@@ -120,24 +140,46 @@ private:
         std::vector<MeshLib::Element*> const& elements,
         AssemblerLib::MeshComponentMap&& mesh_component_map);
 
+    /// Table used during the construction; contains for each element (first
+    /// index) and each component (second index) a vector of indices in the
+    /// global stiffness matrix or vector.
+    using Table = Eigen::Matrix<std::vector<GlobalIndexType>, Eigen::Dynamic,
+                                Eigen::Dynamic, Eigen::RowMajor>;
+
     template <typename ElementIterator>
     void
     findGlobalIndices(ElementIterator first, ElementIterator last,
         std::size_t const mesh_id,
-        const unsigned component_id, const unsigned comp_id_write);
+        const unsigned component_id, const unsigned comp_id_write,
+        Table& rows) const;
+
+    /// Stores the given table in the compressed form.
+    void compressTable(Table const& rows);
+
+    RowColumnIndices getRowColumnIndices(std::size_t const begin,
+                                         std::size_t const end) const
+    {
+        LineIndex const line(_indices.data() + begin, end - begin);
+        return RowColumnIndices(line, line);
+    }
 
 private:
     std::vector<MeshLib::MeshSubsets*> const _mesh_subsets;
     AssemblerLib::MeshComponentMap _mesh_component_map;
 
-    using Table = Eigen::Matrix<LineIndex, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    /// Number of elements, i.e. of rows of the table.
+    std::size_t _size = 0;
 
-    /// Table contains for each element (first index) and each component (second index)
-    /// a vector (\c LineIndex) of indices in the global stiffness matrix or vector
-    Table _rows;
+    /// Offsets into #_indices for each element and each component in
+    /// row-major order; the entry after the last one is the total number of
+    /// indices. The indices of all components of an element are therefore
+    /// stored contiguously, which are then the rows and columns of the
+    /// element's local matrix.
+    std::vector<std::size_t> _offsets;
 
-    /// \see _rows
-    Table const& _columns = _rows;
+    /// Indices in the global stiffness matrix or vector of all elements and
+    /// components.
+    std::vector<GlobalIndexType> _indices;
 
 #ifndef NDEBUG
     /// Prints first rows of the table, every line, and the mesh component map.
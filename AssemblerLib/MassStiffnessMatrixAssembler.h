@@ -0,0 +1,60 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_MASSSTIFFNESSMATRIXASSEMBLER_H_
+#define ASSEMBLERLIB_MASSSTIFFNESSMATRIXASSEMBLER_H_
+
+#include "VectorMatrixAssembler.h"
+
+namespace AssemblerLib
+{
+
+/// Adds the results of a local assembler into a global mass matrix, a global
+/// stiffness matrix, and a global vector.
+///
+/// Works like the VectorMatrixAssembler but calls the local assembler's
+/// \code
+///     addToGlobal(M, K, rhs, indices)
+/// \endcode
+/// after assemble(). Both matrices must have the same structure if a scatter
+/// map is set, e.g. both are set up with the same sparsity pattern.
+template<
+    typename GLOBAL_MATRIX_,
+    typename GLOBAL_VECTOR_>
+class MassStiffnessMatrixAssembler
+    : public VectorMatrixAssembler<GLOBAL_MATRIX_, GLOBAL_VECTOR_>
+{
+public:
+    MassStiffnessMatrixAssembler(
+        GLOBAL_MATRIX_ &M,
+        GLOBAL_MATRIX_ &K,
+        GLOBAL_VECTOR_ &rhs,
+        LocalToGlobalIndexMap const& data_pos)
+    : VectorMatrixAssembler<GLOBAL_MATRIX_, GLOBAL_VECTOR_>(K, rhs, data_pos),
+      _M(M)
+    {}
+
+    /// Executes local assembler for the given mesh item and adds the result
+    /// into the global matrices and vector.
+    /// \attention The index \c id is not necesserily the mesh item's id.
+    template <typename LocalAssembler_>
+    void operator()(std::size_t const id,
+        LocalAssembler_* const local_assembler) const
+    {
+        auto const r_c_indices = this->assembleLocal(id, local_assembler);
+        local_assembler->addToGlobal(_M, this->_A, this->_rhs, r_c_indices);
+    }
+
+private:
+    GLOBAL_MATRIX_ &_M;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_MASSSTIFFNESSMATRIXASSEMBLER_H_
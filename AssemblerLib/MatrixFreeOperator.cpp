@@ -0,0 +1,175 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "MatrixFreeOperator.h"
+
+#include <algorithm>
+#include <cassert>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace AssemblerLib
+{
+
+MatrixFreeOperator::MatrixFreeOperator(
+    LocalToGlobalIndexMap const& dof_table,
+    ElementColoring const& element_coloring,
+    std::vector<MatrixFreeLocalAssembler const*>&& local_assemblers,
+    std::vector<GlobalIndexType> const& known_ids)
+    : _dof_table(dof_table),
+      _element_coloring(element_coloring),
+      _local_assemblers(std::move(local_assemblers)),
+      _known_ids(known_ids),
+      _is_known(dof_table.dofSize(), 0),
+      _free_x(dof_table.dofSize())
+{
+    assert(_local_assemblers.size() == _dof_table.size());
+
+    for (auto const id : _known_ids)
+        _is_known[id] = 1;
+
+    for (std::size_t id = 0; id < _dof_table.size(); ++id)
+        _max_num_dof = std::max(_max_num_dof, _dof_table.getNumElementDOF(id));
+    resizeLocalBuffers();
+
+    // Sum of the local diagonals; the elements of one color do not share
+    // unknowns.
+    std::size_t const n = getNRows();
+    _inverse_diagonal.assign(n, 0.0);
+    for (auto const& color : _element_coloring)
+    {
+        OPENMP_LOOP_TYPE const n_color = color.size();
+        #pragma omp parallel for
+        for (OPENMP_LOOP_TYPE k = 0; k < n_color; k++)
+        {
+            std::size_t const id = color[k];
+            auto const indices = _dof_table(id).rows;
+            auto& buffers = getLocalBuffers();
+            buffers.y.resize(indices.size());
+            _local_assemblers[id]->getLocalMatrixDiagonal(buffers.y);
+            for (std::size_t i = 0; i < indices.size(); ++i)
+                _inverse_diagonal[indices[i]] += buffers.y[i];
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        double& d = _inverse_diagonal[i];
+        d = (_is_known[i] || d == 0.0) ? 1.0 : 1.0 / d;
+    }
+}
+
+void MatrixFreeOperator::resizeLocalBuffers() const
+{
+#ifdef _OPENMP
+    std::size_t const n_threads = omp_get_max_threads();
+#else
+    std::size_t const n_threads = 1;
+#endif
+    if (_local_buffers.size() >= n_threads)
+        return;
+
+    _local_buffers.resize(n_threads);
+    for (auto& buffers : _local_buffers)
+    {
+        buffers.x.reserve(_max_num_dof);
+        buffers.y.reserve(_max_num_dof);
+    }
+}
+
+MatrixFreeOperator::LocalBuffers& MatrixFreeOperator::getLocalBuffers() const
+{
+#ifdef _OPENMP
+    std::size_t const thread_id = omp_get_thread_num();
+#else
+    std::size_t const thread_id = 0;
+#endif
+    assert(thread_id < _local_buffers.size());
+    return _local_buffers[thread_id];
+}
+
+void MatrixFreeOperator::applyUnconstrained(double const* const x,
+                                            double* const y) const
+{
+    resizeLocalBuffers();
+    std::fill_n(y, getNRows(), 0.0);
+
+    for (auto const& color : _element_coloring)
+    {
+        OPENMP_LOOP_TYPE const n_color = color.size();
+        #pragma omp parallel for
+        for (OPENMP_LOOP_TYPE k = 0; k < n_color; k++)
+        {
+            std::size_t const id = color[k];
+            auto const indices = _dof_table(id).rows;
+            auto& buffers = getLocalBuffers();
+
+            buffers.x.clear();
+            for (auto const i : indices)
+                buffers.x.push_back(x[i]);
+            buffers.y.resize(indices.size());
+
+            _local_assemblers[id]->applyLocalMatrix(buffers.x, buffers.y);
+
+            for (std::size_t i = 0; i < indices.size(); ++i)
+                y[indices[i]] += buffers.y[i];
+        }
+    }
+}
+
+void MatrixFreeOperator::amux(double const d, double const* const x,
+                              double* const y) const
+{
+    OPENMP_LOOP_TYPE const n = getNRows();
+
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+        _free_x[i] = _is_known[i] ? 0.0 : x[i];
+
+    applyUnconstrained(_free_x.data(), y);
+
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+        y[i] = d * (_is_known[i] ? x[i] : y[i]);
+}
+
+void MatrixFreeOperator::precondApply(double* const x) const
+{
+    OPENMP_LOOP_TYPE const n = getNRows();
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+        x[i] *= _inverse_diagonal[i];
+}
+
+void MatrixFreeOperator::applyKnownSolution(
+    double* const b, double* const x, std::vector<double> const& values) const
+{
+    assert(values.size() == _known_ids.size());
+    std::size_t const n = getNRows();
+
+    std::vector<double> known_x(n, 0.0);
+    for (std::size_t k = 0; k < _known_ids.size(); ++k)
+        known_x[_known_ids[k]] = values[k];
+
+    std::vector<double> correction(n);
+    applyUnconstrained(known_x.data(), correction.data());
+
+    for (std::size_t i = 0; i < n; ++i)
+        if (!_is_known[i])
+            b[i] -= correction[i];
+
+    for (std::size_t k = 0; k < _known_ids.size(); ++k)
+    {
+        b[_known_ids[k]] = values[k];
+        x[_known_ids[k]] = values[k];
+    }
+}
+
+}   // namespace AssemblerLib
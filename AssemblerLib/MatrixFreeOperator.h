@@ -0,0 +1,120 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_MATRIXFREEOPERATOR_H_
+#define ASSEMBLERLIB_MATRIXFREEOPERATOR_H_
+
+#include <vector>
+
+#include "ComputeElementColoring.h"
+#include "LocalToGlobalIndexMap.h"
+
+namespace AssemblerLib
+{
+
+/// Interface of local assemblers which can apply their local matrix without
+/// assembling it, as required by the MatrixFreeOperator.
+class MatrixFreeLocalAssembler
+{
+public:
+    virtual ~MatrixFreeLocalAssembler() = default;
+
+    /// Computes \f$ y = K x \f$ for the local matrix \f$ K \f$; \c local_y
+    /// has the size of \c local_x.
+    virtual void applyLocalMatrix(std::vector<double> const& local_x,
+                                  std::vector<double>& local_y) const = 0;
+
+    /// Writes the diagonal of the local matrix to \c local_diagonal, which has
+    /// the size of the local matrix.
+    virtual void getLocalMatrixDiagonal(
+        std::vector<double>& local_diagonal) const = 0;
+};
+
+/// Global matrix given implicitly by the local matrices of all mesh elements.
+///
+/// The product with a vector is computed element by element from the local
+/// assemblers; the elements of one color are processed in parallel. No global
+/// matrix is stored.
+///
+/// The known solutions, e.g. Dirichlet boundary conditions, are eliminated
+/// symmetrically: their rows and columns are replaced by the identity and the
+/// right-hand-side is corrected by applyKnownSolution(). The operator is
+/// preconditioned by the inverse of the matrix diagonal (Jacobi), which is
+/// computed once in the construction.
+///
+/// The interface is the one used by the iterative solvers in
+/// MathLib/LinAlg/Solvers/LinearOperatorSolvers.h.
+class MatrixFreeOperator
+{
+public:
+    /// \param local_assemblers the local assemblers in the order of the
+    ///        \c dof_table's mesh items.
+    /// \param known_ids global indices of the known solutions.
+    MatrixFreeOperator(
+        LocalToGlobalIndexMap const& dof_table,
+        ElementColoring const& element_coloring,
+        std::vector<MatrixFreeLocalAssembler const*>&& local_assemblers,
+        std::vector<GlobalIndexType> const& known_ids);
+
+    /// Number of unknowns.
+    std::size_t getNRows() const { return _is_known.size(); }
+
+    /// Computes \f$ y = d A x \f$.
+    void amux(double const d, double const* const x, double* const y) const;
+
+    /// Applies the Jacobi preconditioner in place.
+    void precondApply(double* const x) const;
+
+    /// Subtracts the columns of the known solutions multiplied by their
+    /// \c values from the right-hand-side \c b, and sets the known entries of
+    /// \c b and of the solution \c x to the values.
+    /// \param values the known solutions in the order of the \c known_ids
+    ///        given in the construction.
+    void applyKnownSolution(double* const b, double* const x,
+                            std::vector<double> const& values) const;
+
+private:
+    /// Computes \f$ y = A x \f$ without the elimination of known solutions.
+    void applyUnconstrained(double const* const x, double* const y) const;
+
+    /// Local vectors of one thread.
+    struct LocalBuffers
+    {
+        std::vector<double> x;
+        std::vector<double> y;
+    };
+
+    /// Allocates buffers for the current maximum number of threads.
+    void resizeLocalBuffers() const;
+
+    LocalBuffers& getLocalBuffers() const;
+
+private:
+    LocalToGlobalIndexMap const& _dof_table;
+    ElementColoring const& _element_coloring;
+    std::vector<MatrixFreeLocalAssembler const*> const _local_assemblers;
+
+    std::vector<GlobalIndexType> const _known_ids;
+    std::vector<char> _is_known;
+
+    std::vector<double> _inverse_diagonal;
+
+    /// Copy of the argument of amux() with zeroed known entries.
+    mutable std::vector<double> _free_x;
+
+    /// Maximum number of degrees of freedom of a mesh item.
+    std::size_t _max_num_dof = 0;
+
+    /// Buffers for each thread, indexed by the OpenMP thread number.
+    mutable std::vector<LocalBuffers> _local_buffers;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_MATRIXFREEOPERATOR_H_
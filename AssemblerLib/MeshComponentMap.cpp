@@ -10,6 +10,7 @@
  *
  */
 
+#include <cassert>
 #include <iostream>
 
 #include "MeshLib/MeshSubsets.h"
@@ -25,8 +26,7 @@ namespace AssemblerLib
 
 using namespace detail;
 
-GlobalIndexType const MeshComponentMap::nop =
-    std::numeric_limits<GlobalIndexType>::max();
+GlobalIndexType const MeshComponentMap::nop = ComponentGlobalIndexDict::nop;
 
 #ifdef USE_PETSC
 MeshComponentMap::MeshComponentMap(
@@ -34,6 +34,7 @@ MeshComponentMap::MeshComponentMap(
     : _num_components(components.size())
 
 {
+    std::vector<Line> lines;
     // get number of unknows
     GlobalIndexType num_unknowns = 0;
     for (auto const c : components)
@@ -98,23 +99,25 @@ MeshComponentMap::MeshComponentMap(
                 else
                     _num_local_dof++;
 
-                _dict.insert(
-                    Line(Location(mesh_id, MeshLib::MeshItemType::Node, j),
-                         comp_id, global_id));
+                lines.emplace_back(
+                    Location(mesh_id, MeshLib::MeshItemType::Node, j),
+                    comp_id, global_id);
             }
 
             // Note: If the cells are really used (e.g. for the mixed FEM),
             // the following global cell index must be reconsidered
             // according to the employed cell indexing method.
             for (std::size_t j = 0; j < mesh_subset.getNElements(); j++)
-                _dict.insert(
-                    Line(Location(mesh_id, MeshLib::MeshItemType::Cell, j),
-                         comp_id, cell_index++));
+                lines.emplace_back(
+                    Location(mesh_id, MeshLib::MeshItemType::Cell, j),
+                    comp_id, cell_index++);
 
             _num_global_dof += mesh.getNGlobalNodes();
         }
         comp_id++;
     }
+
+    _dict = ComponentGlobalIndexDict(std::move(lines), _num_components);
 }
 #else
 MeshComponentMap::MeshComponentMap(
@@ -122,6 +125,7 @@ MeshComponentMap::MeshComponentMap(
     : _num_components(components.size())
 {
     // construct dict (and here we number global_index by component type)
+    std::vector<Line> lines;
     GlobalIndexType global_index = 0;
     std::size_t comp_id = 0;
     for (auto const c : components)
@@ -133,15 +137,17 @@ MeshComponentMap::MeshComponentMap(
             std::size_t const mesh_id = mesh_subset.getMeshID();
             // mesh items are ordered first by node, cell, ....
             for (std::size_t j=0; j<mesh_subset.getNNodes(); j++)
-                _dict.insert(Line(Location(mesh_id, MeshLib::MeshItemType::Node, mesh_subset.getNodeID(j)), comp_id, global_index++));
+                lines.emplace_back(Location(mesh_id, MeshLib::MeshItemType::Node, mesh_subset.getNodeID(j)), comp_id, global_index++);
             for (std::size_t j=0; j<mesh_subset.getNElements(); j++)
-                _dict.insert(Line(Location(mesh_id, MeshLib::MeshItemType::Cell, mesh_subset.getElementID(j)), comp_id, global_index++));
+                lines.emplace_back(Location(mesh_id, MeshLib::MeshItemType::Cell, mesh_subset.getElementID(j)), comp_id, global_index++);
         }
         comp_id++;
     }
 
+    _dict = ComponentGlobalIndexDict(std::move(lines), _num_components);
+
     if (order == ComponentOrder::BY_LOCATION)
-        renumberByLocation();
+        _dict.renumberByLocation(0);
 }
 #endif // end of USE_PETSC
 
@@ -149,8 +155,8 @@ MeshComponentMap
 MeshComponentMap::getSubset(std::vector<MeshLib::MeshSubsets*> const& components) const
 {
     assert(components.size() == _num_components);
-    // New dictionary for the subset.
-    ComponentGlobalIndexDict subset_dict;
+    // Lines of the new dictionary for the subset.
+    std::vector<Line> subset_lines;
 
     std::size_t comp_id = 0;
     std::size_t num_comp = 0;
@@ -168,66 +174,56 @@ MeshComponentMap::getSubset(std::vector<MeshLib::MeshSubsets*> const& components
             // Lookup the locations in the current mesh component map and
             // insert the full lines into the subset dictionary.
             for (std::size_t j=0; j<mesh_subset.getNNodes(); j++)
-                subset_dict.insert(getLine(Location(mesh_id,
+                subset_lines.push_back(getLine(Location(mesh_id,
                     MeshLib::MeshItemType::Node, mesh_subset.getNodeID(j)), comp_id));
             for (std::size_t j=0; j<mesh_subset.getNElements(); j++)
-                subset_dict.insert(getLine(Location(mesh_id,
+                subset_lines.push_back(getLine(Location(mesh_id,
                     MeshLib::MeshItemType::Cell, mesh_subset.getElementID(j)), comp_id));
         }
         num_comp++;
         comp_id++;
     }
 
-    return MeshComponentMap(subset_dict, num_comp);
-}
-
-void MeshComponentMap::renumberByLocation(GlobalIndexType offset)
-{
-    GlobalIndexType global_index = offset;
-
-    auto &m = _dict.get<ByLocation>(); // view as sorted by mesh item
-    for (auto itr_mesh_item=m.begin(); itr_mesh_item!=m.end(); ++itr_mesh_item)
-    {
-        Line pos = *itr_mesh_item;
-        pos.global_index = global_index++;
-        m.replace(itr_mesh_item, pos);
-    }
+    // The subset keeps the component ids of this map.
+    return MeshComponentMap(
+        ComponentGlobalIndexDict(std::move(subset_lines), _num_components),
+        num_comp);
 }
 
 std::vector<std::size_t> MeshComponentMap::getComponentIDs(const Location &l) const
 {
-    auto const &m = _dict.get<ByLocation>();
-    auto const p = m.equal_range(Line(l));
     std::vector<std::size_t> vec_compID;
-    for (auto itr=p.first; itr!=p.second; ++itr)
-        vec_compID.push_back(itr->comp_id);
+    if (auto const* const row = _dict.find(l))
+        for (std::size_t c = 0; c < _dict.getNumComponents(); ++c)
+            if (row[c] != nop)
+                vec_compID.push_back(c);
     return vec_compID;
 }
 
 Line MeshComponentMap::getLine(Location const& l,
     std::size_t const comp_id) const
 {
-    auto const &m = _dict.get<ByLocationAndComponent>();
-    auto const itr = m.find(Line(l, comp_id));
-    assert(itr != m.end());     // The line must exist in the current dictionary.
-    return *itr;
+    auto const* const row = _dict.find(l);
+    // The line must exist in the current dictionary.
+    assert(row != nullptr && comp_id < _dict.getNumComponents() &&
+           row[comp_id] != nop);
+    return Line(l, comp_id, row[comp_id]);
 }
 
 GlobalIndexType MeshComponentMap::getGlobalIndex(Location const& l,
     std::size_t const comp_id) const
 {
-    auto const &m = _dict.get<ByLocationAndComponent>();
-    auto const itr = m.find(Line(l, comp_id));
-    return itr!=m.end() ? itr->global_index : nop;
+    auto const* const row = _dict.find(l);
+    return (row && comp_id < _dict.getNumComponents()) ? row[comp_id] : nop;
 }
 
 std::vector<GlobalIndexType> MeshComponentMap::getGlobalIndices(const Location &l) const
 {
-    auto const &m = _dict.get<ByLocation>();
-    auto const p = m.equal_range(Line(l));
     std::vector<GlobalIndexType> global_indices;
-    for (auto itr=p.first; itr!=p.second; ++itr)
-        global_indices.push_back(itr->global_index);
+    if (auto const* const row = _dict.find(l))
+        for (std::size_t c = 0; c < _dict.getNumComponents(); ++c)
+            if (row[c] != nop)
+                global_indices.push_back(row[c]);
     return global_indices;
 }
 
@@ -240,13 +236,11 @@ std::vector<GlobalIndexType> MeshComponentMap::getGlobalIndicesByLocation(
     std::vector<GlobalIndexType> global_indices;
     global_indices.reserve(ls.size());
 
-    auto const &m = _dict.get<ByLocation>();
-    for (auto l = ls.cbegin(); l != ls.cend(); ++l)
-    {
-        auto const p = m.equal_range(Line(*l));
-        for (auto itr = p.first; itr != p.second; ++itr)
-            global_indices.push_back(itr->global_index);
-    }
+    for (auto const& l : ls)
+        if (auto const* const row = _dict.find(l))
+            for (std::size_t c = 0; c < _dict.getNumComponents(); ++c)
+                if (row[c] != nop)
+                    global_indices.push_back(row[c]);
 
     return global_indices;
 }
@@ -254,33 +248,21 @@ std::vector<GlobalIndexType> MeshComponentMap::getGlobalIndicesByLocation(
 std::vector<GlobalIndexType> MeshComponentMap::getGlobalIndicesByComponent(
     std::vector<Location> const& ls) const
 {
-    // vector of (Component, global Index) pairs.
-    typedef std::pair<std::size_t, GlobalIndexType> CIPair;
-    std::vector<CIPair> pairs;
-    pairs.reserve(ls.size());
-
-    // Create a sub dictionary containing all lines with location from ls.
-    auto const &m = _dict.get<ByLocation>();
-    for (auto l = ls.cbegin(); l != ls.cend(); ++l)
-    {
-        auto const p = m.equal_range(Line(*l));
-        for (auto itr = p.first; itr != p.second; ++itr)
-            pairs.emplace_back(itr->comp_id, itr->global_index);
-    }
-
-    auto CIPairLess = [](CIPair const& a, CIPair const& b)
-        {
-            return a.first < b.first;
-        };
-
-    // Create vector of global indices from sub dictionary sorting by component.
-    if (!std::is_sorted(pairs.begin(), pairs.end(), CIPairLess))
-        std::stable_sort(pairs.begin(), pairs.end(), CIPairLess);
-
+    // Rows of the given locations.
+    std::vector<GlobalIndexType const*> rows;
+    rows.reserve(ls.size());
+    for (auto const& l : ls)
+        if (auto const* const row = _dict.find(l))
+            rows.push_back(row);
+
+    // Create vector of global indices sorted by component, and within a
+    // component by the order of the locations.
     std::vector<GlobalIndexType> global_indices;
-    global_indices.reserve(pairs.size());
-    for (auto p = pairs.cbegin(); p != pairs.cend(); ++p)
-        global_indices.push_back(p->second);
+    global_indices.reserve(ls.size());
+    for (std::size_t c = 0; c < _dict.getNumComponents(); ++c)
+        for (auto const* const row : rows)
+            if (row[c] != nop)
+                global_indices.push_back(row[c]);
 
     return global_indices;
 }
@@ -13,6 +13,7 @@
 #ifndef ASSEMBLERLIB_MESHCOMPONENTMAP_H_
 #define ASSEMBLERLIB_MESHCOMPONENTMAP_H_
 
+#include <ostream>
 #include <vector>
 
 #include "MeshLib/Location.h"
@@ -150,25 +151,17 @@ public:
     static GlobalIndexType const nop;
 
 #ifndef NDEBUG
-    const detail::ComponentGlobalIndexDict& getDictionary() const
-    {
-        return _dict;
-    }
-
     friend std::ostream& operator<<(std::ostream& os, MeshComponentMap const& m)
     {
-        os << "Dictionary size: " << m._dict.size() << "\n";
-        for (auto l : m._dict)
-            os << l << "\n";
-        return os;
+        return os << "Dictionary size: " << m._dict.size() << "\n" << m._dict;
     }
 #endif  // NDEBUG
 
 private:
     /// Private constructor used by internally created mesh component maps.
-    MeshComponentMap(detail::ComponentGlobalIndexDict& dict,
+    MeshComponentMap(detail::ComponentGlobalIndexDict&& dict,
                      unsigned const num_components)
-        : _dict(dict), _num_components(num_components)
+        : _dict(std::move(dict)), _num_components(num_components)
     { }
 
     /// Looks up if a line is already stored in the dictionary.
@@ -177,8 +170,6 @@ private:
     /// \return a copy of the line.
     detail::Line getLine(Location const& l, std::size_t const component_id) const;
 
-    void renumberByLocation(GlobalIndexType offset=0);
-
     detail::ComponentGlobalIndexDict _dict;
 
     /// Number of global unknowns.
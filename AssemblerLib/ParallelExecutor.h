@@ -0,0 +1,96 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_PARALLELEXECUTOR_H_
+#define ASSEMBLERLIB_PARALLELEXECUTOR_H_
+
+#include <cassert>
+#include <utility>
+
+#include "ComputeElementColoring.h"
+#include "SerialExecutor.h"
+
+namespace AssemblerLib
+{
+
+/// Executor distributing the global loops over OpenMP threads.
+///
+/// Loops writing into shared objects, like the global assembly, must be
+/// executed through executeColored(), which processes one color class after
+/// the other, and the elements of a single color concurrently.
+/// Without OpenMP support all loops are run sequentially.
+struct ParallelExecutor
+{
+    /// Executes \c f for each element of \c c sequentially.
+    /// Without further information \c f might modify shared data, therefore
+    /// this is the same as SerialExecutor::execute(f, c, args).
+    template <typename F, typename C, typename ...Args_>
+    static
+    void
+#if defined(_MSC_VER) && (_MSC_VER >= 1700)
+    execute(F& f, C const& c, Args_&&... args)
+#else
+    execute(F const& f, C const& c, Args_&&... args)
+#endif
+    {
+        SerialExecutor::execute(f, c, std::forward<Args_>(args)...);
+    }
+
+    /// Same as SerialExecutor::execute(f, c, data, args), but the loop is run
+    /// in parallel. \c f must modify the i-th item of \c data only.
+    template <typename F, typename C, typename Data, typename ...Args_>
+    static
+    void
+#if defined(_MSC_VER) && (_MSC_VER >= 1700)
+    execute(F& f, C const& c, Data& data, Args_&&... args)
+#else
+    execute(F const& f, C const& c, Data& data, Args_&&... args)
+#endif
+    {
+        assert(c.size() == data.size());
+
+        OPENMP_LOOP_TYPE const n = c.size();
+        #pragma omp parallel for
+        for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+            f(i, c[i], data[i], args...);
+    }
+
+    /// Executes \c f for each element from the input container \c c like
+    /// execute(f, c, args), but element positions of the same color are
+    /// processed concurrently.
+    ///
+    /// \param coloring color classes of the positions in \c c, e.g. computed
+    ///                 by computeElementColoring().
+    template <typename F, typename C, typename ...Args_>
+    static
+    void
+#if defined(_MSC_VER) && (_MSC_VER >= 1700)
+    executeColored(ElementColoring const& coloring, F& f, C const& c,
+        Args_&&... args)
+#else
+    executeColored(ElementColoring const& coloring, F const& f, C const& c,
+        Args_&&... args)
+#endif
+    {
+        for (auto const& color : coloring)
+        {
+            OPENMP_LOOP_TYPE const n = color.size();
+            #pragma omp parallel for
+            for (OPENMP_LOOP_TYPE k = 0; k < n; k++)
+            {
+                auto const i = color[k];
+                f(i, c[i], args...);
+            }
+        }
+    }
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_PARALLELEXECUTOR_H_
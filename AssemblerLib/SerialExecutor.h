@@ -13,6 +13,8 @@
 #ifndef ASSEMBLERLIB_SERIALEXECUTOR_H_H
 #define ASSEMBLERLIB_SERIALEXECUTOR_H_H
 
+#include "ComputeElementColoring.h"
+
 namespace AssemblerLib
 {
 
@@ -68,6 +70,24 @@ struct SerialExecutor
         for (std::size_t i = 0; i < c.size(); i++)
             f(i, c[i], data[i], std::forward<Args_>(args)...);
     }
+
+    /// Same as execute(f, c), the coloring is ignored and the elements are
+    /// processed in the order of the input container.
+    ///
+    /// \param coloring color classes of the positions in \c c.
+    template <typename F, typename C, typename ...Args_>
+    static
+    void
+#if defined(_MSC_VER) && (_MSC_VER >= 1700)
+    executeColored(ElementColoring const& /*coloring*/, F& f, C const& c,
+        Args_&&... args)
+#else
+    executeColored(ElementColoring const& /*coloring*/, F const& f, C const& c,
+        Args_&&... args)
+#endif
+    {
+        execute(f, c, std::forward<Args_>(args)...);
+    }
 };
 
 }   // namespace AssemblerLib
@@ -0,0 +1,83 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ASSEMBLERLIB_TRIPLETMATRIXASSEMBLER_H_
+#define ASSEMBLERLIB_TRIPLETMATRIXASSEMBLER_H_
+
+#include "MathLib/LinAlg/SetFromCompressedRows.h"
+
+#include "GlobalMatrixTriplets.h"
+#include "VectorMatrixAssembler.h"
+
+namespace AssemblerLib
+{
+
+/// Collects the results of the local assemblers as triplets instead of adding
+/// them into the global matrix and vector directly.
+///
+/// Works like the VectorMatrixAssembler but calls the local assembler's
+/// \code
+///     addToGlobal(triplets, id, indices)
+/// \endcode
+/// after assemble(). Because each thread appends to its own buffer, all mesh
+/// items can be processed concurrently, e.g. as a single color class. The
+/// triplets are cleared before and turned into the global objects after the
+/// element loop by clear() and setGlobal().
+template<
+    typename GLOBAL_MATRIX_,
+    typename GLOBAL_VECTOR_>
+class TripletMatrixAssembler
+    : public VectorMatrixAssembler<GLOBAL_MATRIX_, GLOBAL_VECTOR_>
+{
+public:
+    TripletMatrixAssembler(
+        GLOBAL_MATRIX_ &A,
+        GLOBAL_VECTOR_ &rhs,
+        LocalToGlobalIndexMap const& data_pos)
+    : VectorMatrixAssembler<GLOBAL_MATRIX_, GLOBAL_VECTOR_>(A, rhs, data_pos)
+    {}
+
+    /// Removes the triplets of the previous assembly.
+    void clear() { _triplets.clear(); }
+
+    /// Executes local assembler for the given mesh item and appends the
+    /// result to the triplets of the calling thread.
+    /// \attention The index \c id is not necesserily the mesh item's id.
+    template <typename LocalAssembler_>
+    void operator()(std::size_t const id,
+        LocalAssembler_* const local_assembler) const
+    {
+        auto const r_c_indices = this->assembleLocal(id, local_assembler);
+        local_assembler->addToGlobal(_triplets, id, r_c_indices);
+    }
+
+    /// Sums the collected triplets and replaces the global matrix by them,
+    /// including its structure; the sums of the vector entries are added to
+    /// the global vector.
+    void setGlobal()
+    {
+        std::size_t const n_rows = this->_data_pos.dofSize();
+        _triplets.compress(n_rows);
+        MathLib::setFromCompressedRows(this->_A, _triplets.getRowOffsets(),
+                                       _triplets.getColumns(),
+                                       _triplets.getValues());
+
+        auto const& vector = _triplets.getVector();
+        for (std::size_t r = 0; r < n_rows; ++r)
+            if (vector[r] != 0.0)
+                this->_rhs.add(r, vector[r]);
+    }
+
+private:
+    mutable GlobalMatrixTriplets _triplets;
+};
+
+}   // namespace AssemblerLib
+
+#endif  // ASSEMBLERLIB_TRIPLETMATRIXASSEMBLER_H_
@@ -10,6 +10,14 @@
 #ifndef ASSEMBLERLIB_VECTORMATRIXASSEMBLER_H_
 #define ASSEMBLERLIB_VECTORMATRIXASSEMBLER_H_
 
+#include <algorithm>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "GlobalMatrixScatterMap.h"
 #include "LocalToGlobalIndexMap.h"
 
 namespace AssemblerLib
@@ -20,6 +28,11 @@ namespace AssemblerLib
 /// and adds the local vector and matrix entries into the global vector and
 /// the global matrix. The indices in global objects are provided by
 /// the LocalToGlobalIndexMap in the construction.
+///
+/// The local solution vectors passed to the local assemblers are kept in
+/// buffers per thread, which are allocated once in the construction for the
+/// maximum number of degrees of freedom of a mesh item. Therefore no memory is
+/// allocated per mesh item during the assembly.
 template<
     typename GLOBAL_MATRIX_,
     typename GLOBAL_VECTOR_>
@@ -34,7 +47,24 @@ public:
         GLOBAL_MATRIX_ &A,
         GLOBAL_VECTOR_ &rhs,
         LocalToGlobalIndexMap const& data_pos)
-    : _A(A), _rhs(rhs), _data_pos(data_pos) {}
+    : _A(A), _rhs(rhs), _data_pos(data_pos)
+    {
+        std::size_t max_num_dof = 0;
+        for (std::size_t id = 0; id < _data_pos.size(); ++id)
+            max_num_dof =
+                std::max(max_num_dof, _data_pos.getNumElementDOF(id));
+
+#ifdef _OPENMP
+        _local_buffers.resize(omp_get_max_threads());
+#else
+        _local_buffers.resize(1);
+#endif
+        for (auto& buffers : _local_buffers)
+        {
+            buffers.x.reserve(max_num_dof);
+            buffers.x_prev_ts.reserve(max_num_dof);
+        }
+    }
 
     ~VectorMatrixAssembler() {}
 
@@ -46,6 +76,15 @@ public:
         _x_prev_ts = x_prev_ts;
     }
 
+    /// Sets the positions of the local matrix entries in the global matrix.
+    /// The map must be computed for the same global matrix and the same
+    /// LocalToGlobalIndexMap; an empty map or a nullptr disables it.
+    void setScatterMap(GlobalMatrixScatterMap const* scatter_map)
+    {
+        _scatter_map =
+            (scatter_map && !scatter_map->empty()) ? scatter_map : nullptr;
+    }
+
     /// Executes local assembler for the given mesh item and adds the result
     /// into the global matrix and vector.
     /// The positions in the global matrix/vector are taken from
@@ -55,24 +94,39 @@ public:
     void operator()(std::size_t const id,
         LocalAssembler_* const local_assembler) const
     {
-        assert(_data_pos.size() > id);
+        auto const r_c_indices = assembleLocal(id, local_assembler);
+        local_assembler->addToGlobal(_A, _rhs, r_c_indices);
+    }
 
-        std::vector<GlobalIndexType> indices;
+protected:
+    /// Executes the local assembler for the given mesh item and returns the
+    /// positions of its local matrix and vector in the global objects.
+    template <typename LocalAssembler_>
+    LocalToGlobalIndexMap::RowColumnIndices assembleLocal(
+        std::size_t const id, LocalAssembler_* const local_assembler) const
+    {
+        assert(_data_pos.size() > id);
 
         // Local matrices and vectors will always be ordered by component,
         // no matter what the order of the global matrix is.
-        for (unsigned c=0; c<_data_pos.getNumComponents(); ++c)
-        {
-            auto const& idcs = _data_pos(id, c).rows;
-            indices.reserve(indices.size() + idcs.size());
-            indices.insert(indices.end(), idcs.begin(), idcs.end());
-        }
-
-        std::vector<double> localX;
-        std::vector<double> localX_pts;
-
-        if (_x)         localX.reserve(indices.size());
-        if (_x_prev_ts) localX_pts.reserve(indices.size());
+        auto const indices = _data_pos(id).rows;
+
+#ifdef _OPENMP
+        std::size_t const thread_id = omp_get_thread_num();
+#else
+        std::size_t const thread_id = 0;
+#endif
+        // The number of threads has been increased after the construction;
+        // fall back to buffers allocated for this mesh item only.
+        LocalBuffers fallback_buffers;
+        LocalBuffers& buffers = thread_id < _local_buffers.size()
+                                    ? _local_buffers[thread_id]
+                                    : fallback_buffers;
+
+        auto& localX = buffers.x;
+        auto& localX_pts = buffers.x_prev_ts;
+        localX.clear();
+        localX_pts.clear();
 
         for (auto i : indices)
         {
@@ -81,18 +135,29 @@ public:
         }
 
         LocalToGlobalIndexMap::RowColumnIndices const r_c_indices(
-                    indices, indices);
+                    indices, indices,
+                    _scatter_map ? _scatter_map->getPositions(id) : nullptr);
 
         local_assembler->assemble(localX, localX_pts);
-        local_assembler->addToGlobal(_A, _rhs, r_c_indices);
+        return r_c_indices;
     }
 
-protected:
     GLOBAL_MATRIX_ &_A;
     GLOBAL_VECTOR_ &_rhs;
     GLOBAL_VECTOR_ const *_x = nullptr;
     GLOBAL_VECTOR_ const *_x_prev_ts = nullptr;
     LocalToGlobalIndexMap const& _data_pos;
+    GlobalMatrixScatterMap const* _scatter_map = nullptr;
+
+    /// Local solution vectors of the current and of the previous time step.
+    struct LocalBuffers
+    {
+        std::vector<double> x;
+        std::vector<double> x_prev_ts;
+    };
+
+    /// Buffers for each thread, indexed by the OpenMP thread number.
+    mutable std::vector<LocalBuffers> _local_buffers;
 };
 
 }   // namespace AssemblerLib
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "MathLib/LinAlg/Dense/DenseTools.h"
+#include "MathLib/LinAlg/KnownSolutionElimination.h"
 
 #ifdef OGS_USE_EIGEN
 #include "MathLib/LinAlg/Eigen/EigenTools.h"
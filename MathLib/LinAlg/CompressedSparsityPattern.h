@@ -0,0 +1,46 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef MATHLIB_COMPRESSEDSPARSITYPATTERN_H_
+#define MATHLIB_COMPRESSEDSPARSITYPATTERN_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace MathLib
+{
+
+/// Non-zero structure of a square matrix in compressed row storage.
+///
+/// The column indices of each row are sorted and unique. Matrix types
+/// supporting it create exactly this structure in setMatrixSparsity(), such
+/// that no entries are inserted during the assembly.
+template <typename IDX_TYPE>
+struct CompressedSparsityPattern
+{
+    /// Offsets of the rows into #col_idx; the last entry is the number of
+    /// non-zero entries.
+    std::vector<IDX_TYPE> row_ptr;
+
+    /// Column indices of the non-zero entries, row by row.
+    std::vector<IDX_TYPE> col_idx;
+
+    /// Number of rows.
+    std::size_t size() const { return row_ptr.empty() ? 0 : row_ptr.size() - 1; }
+
+    /// Number of non-zero entries in the given row.
+    IDX_TYPE getRowSize(std::size_t const row) const
+    {
+        return row_ptr[row + 1] - row_ptr[row];
+    }
+};
+
+} // MathLib
+
+#endif  // MATHLIB_COMPRESSEDSPARSITYPATTERN_H_
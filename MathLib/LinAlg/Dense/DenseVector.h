@@ -20,6 +20,8 @@
 #include <fstream>
 #include <iterator>
 
+#include "MathLib/LinAlg/IndexSpan.h"
+
 namespace MathLib
 {
 
@@ -68,7 +70,7 @@ public:
 	 * @param sub_vec   sub-vector
 	 */
 	template<class T_SUBVEC>
-	void add(const std::vector<std::size_t> &pos, const T_SUBVEC &sub_vec)
+	void add(IndexSpan<std::size_t> const& pos, const T_SUBVEC &sub_vec)
 	{
 		for (std::size_t i=0; i<pos.size(); ++i) {
 			this->add(pos[i], sub_vec[i]);
@@ -74,7 +74,7 @@ public:
 	/// Add sub-matrix at positions \c row_pos and same column positions as the
 	/// given row positions.
 	template<class T_DENSE_MATRIX>
-	void add(std::vector<IDX_TYPE> const& row_pos,
+	void add(IndexSpan<IDX_TYPE> const& row_pos,
 			const T_DENSE_MATRIX &sub_matrix,
 			FP_TYPE fkt = static_cast<FP_TYPE>(1.0))
 	{
@@ -90,8 +90,8 @@ public:
 	}
 
 	template<class T_DENSE_MATRIX>
-	void add(std::vector<IDX_TYPE> const& row_pos,
-			std::vector<IDX_TYPE> const& col_pos, const T_DENSE_MATRIX &sub_matrix,
+	void add(IndexSpan<IDX_TYPE> const& row_pos,
+			IndexSpan<IDX_TYPE> const& col_pos, const T_DENSE_MATRIX &sub_matrix,
 			FP_TYPE fkt = static_cast<FP_TYPE>(1.0));
 
         /// y = mat * x
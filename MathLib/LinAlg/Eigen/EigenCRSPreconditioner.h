@@ -0,0 +1,132 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef EIGENCRSPRECONDITIONER_H_
+#define EIGENCRSPRECONDITIONER_H_
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+#include "MathLib/LinAlg/Preconditioner/AMGPreconditioner.h"
+#include "MathLib/LinAlg/Preconditioner/ILU0Preconditioner.h"
+
+namespace MathLib
+{
+
+/// Adapter of the preconditioners for matrices in compressed row storage
+/// format, e.g. AMGPreconditioner, to the preconditioner interface of the
+/// Eigen iterative solvers, e.g.
+/// \code
+///     Eigen::ConjugateGradient<Matrix, Eigen::Lower,
+///         EigenCRSPreconditioner<AMGPreconditioner>>
+/// \endcode
+/// The solvers call analyzePattern() and factorize() or compute() for a new
+/// matrix only; the matrix is passed to the preconditioner as a full matrix
+/// with sorted column indices.
+///
+/// \tparam Preconditioner provides \c analyzePattern(n, iA, jA),
+///         \c factorize(n, iA, jA, A), \c compute(n, iA, jA, A), and
+///         \c apply(r, z).
+/// \tparam UpLo \c Eigen::Upper if the matrix stores its upper triangle only,
+///         see EigenMatrix::setSymmetric(); the full matrix is used otherwise.
+template <typename Preconditioner, int UpLo = Eigen::Lower | Eigen::Upper>
+class EigenCRSPreconditioner
+{
+public:
+    using StorageIndex = int;
+    enum
+    {
+        ColsAtCompileTime = Eigen::Dynamic,
+        MaxColsAtCompileTime = Eigen::Dynamic
+    };
+
+    EigenCRSPreconditioner() = default;
+
+    template <typename MatType>
+    explicit EigenCRSPreconditioner(MatType const& mat)
+    {
+        compute(mat);
+    }
+
+    template <typename MatType>
+    EigenCRSPreconditioner& analyzePattern(MatType const& mat)
+    {
+        auto const A = toFullRowMajor(mat);
+        _precond.analyzePattern(A.rows(), A.outerIndexPtr(),
+                                A.innerIndexPtr());
+        return *this;
+    }
+
+    template <typename MatType>
+    EigenCRSPreconditioner& factorize(MatType const& mat)
+    {
+        auto const A = toFullRowMajor(mat);
+        _precond.factorize(A.rows(), A.outerIndexPtr(), A.innerIndexPtr(),
+                           A.valuePtr());
+        return *this;
+    }
+
+    template <typename MatType>
+    EigenCRSPreconditioner& compute(MatType const& mat)
+    {
+        auto const A = toFullRowMajor(mat);
+        _precond.compute(A.rows(), A.outerIndexPtr(), A.innerIndexPtr(),
+                         A.valuePtr());
+        return *this;
+    }
+
+    /// Applies the preconditioner to \c b.
+    template <typename Rhs>
+    Eigen::VectorXd solve(Eigen::MatrixBase<Rhs> const& b) const
+    {
+        Eigen::VectorXd const r = b;
+        Eigen::VectorXd z(r.size());
+        _precond.apply(r.data(), z.data());
+        return z;
+    }
+
+    Eigen::ComputationInfo info() { return Eigen::Success; }
+
+private:
+    using RowMajorMatrix =
+        Eigen::SparseMatrix<double, Eigen::RowMajor, StorageIndex>;
+
+    template <typename MatType>
+    static RowMajorMatrix toFullRowMajor(MatType const& mat)
+    {
+        RowMajorMatrix A;
+        if (UpLo == Eigen::Upper)
+        {
+            // The expansion of the triangle leaves the indices unsorted; the
+            // conversion of the storage order sorts them.
+            Eigen::SparseMatrix<double, Eigen::ColMajor, StorageIndex> const
+                full = mat.template selfadjointView<Eigen::Upper>();
+            A = full;
+        }
+        else
+            A = mat;
+        A.makeCompressed();
+        return A;
+    }
+
+    Preconditioner _precond;
+};
+
+/// Smoothed aggregation AMG V-cycle for the Eigen iterative solvers.
+template <int UpLo = Eigen::Lower | Eigen::Upper>
+using EigenAMGPreconditioner = EigenCRSPreconditioner<AMGPreconditioner, UpLo>;
+
+/// Level scheduled ILU(0) for the Eigen iterative solvers.
+template <int UpLo = Eigen::Lower | Eigen::Upper>
+using EigenILU0Preconditioner =
+    EigenCRSPreconditioner<ILU0Preconditioner, UpLo>;
+
+} // MathLib
+
+#endif // EIGENCRSPRECONDITIONER_H_
@@ -9,9 +9,12 @@
 
 #include "EigenLinearSolver.h"
 
+#include <cstdlib>
+
 #include <logog/include/logog.hpp>
 
 #include "BaseLib/ConfigTree.h"
+#include "EigenCRSPreconditioner.h"
 #include "EigenVector.h"
 #include "EigenMatrix.h"
 #include "EigenTools.h"
@@ -29,20 +32,36 @@ template <class T_SOLVER, class T_BASE>
 class EigenDirectLinearSolver final : public T_BASE
 {
 public:
-    explicit EigenDirectLinearSolver(EigenMatrix::RawMatrixType &A) : _A(A)
+    explicit EigenDirectLinearSolver(EigenMatrix &A) : _A(A)
     {
         INFO("-> initialize with the coefficient matrix");
     }
 
-    void solve(EigenVector::RawVectorType &b, EigenVector::RawVectorType &x, EigenOption &/*opt*/) override
+    void solve(EigenVector::RawVectorType &b, EigenVector::RawVectorType &x, EigenOption &/*opt*/,
+               LinearSolverBehaviour behaviour) override
     {
         INFO("-> solve");
-        if (!_A.isCompressed())
-            _A.makeCompressed();
-        _solver.compute(_A);
-        if(_solver.info()!=Eigen::Success) {
-            ERR("Failed during Eigen linear solver initialization");
-            return;
+        auto& A = _A.getRawMatrix();
+        if (!A.isCompressed())
+            A.makeCompressed();
+
+        if (behaviour == LinearSolverBehaviour::REUSE && _is_factorized) {
+            INFO("-> reuse the factorization of the unchanged matrix");
+        } else {
+            // The symbolic analysis (fill-reducing ordering and elimination
+            // tree) depends on the sparsity pattern only, which cannot change
+            // for a frozen matrix structure.
+            if (!_is_pattern_analyzed || !_A.isStructureFrozen()) {
+                _solver.analyzePattern(A);
+                _is_pattern_analyzed = true;
+            }
+            _is_factorized = false;
+            _solver.factorize(A);
+            if(_solver.info()!=Eigen::Success) {
+                ERR("Failed during Eigen linear solver initialization");
+                return;
+            }
+            _is_factorized = true;
         }
 
         x = _solver.solve(b);
@@ -54,7 +73,9 @@ public:
 
 private:
     T_SOLVER _solver;
-    EigenMatrix::RawMatrixType& _A;
+    EigenMatrix& _A;
+    bool _is_pattern_analyzed = false;
+    bool _is_factorized = false;
 };
 
 /// Template class for Eigen iterative linear solvers
@@ -62,22 +83,38 @@ template <class T_SOLVER, class T_BASE>
 class EigenIterativeLinearSolver final : public T_BASE
 {
 public:
-    explicit EigenIterativeLinearSolver(EigenMatrix::RawMatrixType &A) : _A(A)
+    explicit EigenIterativeLinearSolver(EigenMatrix &A) : _A(A)
     {
         INFO("-> initialize with the coefficient matrix");
     }
 
-    void solve(EigenVector::RawVectorType &b, EigenVector::RawVectorType &x, EigenOption &opt) override
+    void solve(EigenVector::RawVectorType &b, EigenVector::RawVectorType &x, EigenOption &opt,
+               LinearSolverBehaviour behaviour) override
     {
         INFO("-> solve");
         _solver.setTolerance(opt.error_tolerance);
         _solver.setMaxIterations(opt.max_iterations);
-        if (!_A.isCompressed())
-            _A.makeCompressed();
-        _solver.compute(_A);
-        if(_solver.info()!=Eigen::Success) {
-            ERR("Failed during Eigen linear solver initialization");
-            return;
+        auto& A = _A.getRawMatrix();
+        if (!A.isCompressed())
+            A.makeCompressed();
+        if (behaviour == LinearSolverBehaviour::REUSE && _is_computed) {
+            INFO("-> reuse the preconditioner of the unchanged matrix");
+        } else {
+            _is_computed = false;
+            // The symbolic part of the preconditioner setup, e.g. the
+            // ordering of an incomplete factorization, is kept for a frozen
+            // matrix structure.
+            if (_is_pattern_analyzed && _A.isStructureFrozen()) {
+                _solver.factorize(A);
+            } else {
+                _solver.compute(A);
+                _is_pattern_analyzed = true;
+            }
+            if(_solver.info()!=Eigen::Success) {
+                ERR("Failed during Eigen linear solver initialization");
+                return;
+            }
+            _is_computed = true;
         }
         x = _solver.solveWithGuess(b, x);
         if(_solver.info()!=Eigen::Success) {
@@ -90,9 +127,55 @@ public:
 
 private:
     T_SOLVER _solver;
-    EigenMatrix::RawMatrixType& _A;
+    EigenMatrix& _A;
+    bool _is_pattern_analyzed = false;
+    bool _is_computed = false;
 };
 
+template <typename T_PRECON>
+using CGLower = Eigen::ConjugateGradient<EigenMatrix::RawMatrixType, Eigen::Lower, T_PRECON>;
+template <typename T_PRECON>
+using CGUpper = Eigen::ConjugateGradient<EigenMatrix::RawMatrixType, Eigen::Upper, T_PRECON>;
+template <typename T_PRECON>
+using BiCGSTAB = Eigen::BiCGSTAB<EigenMatrix::RawMatrixType, T_PRECON>;
+
+/// Creates the iterative solver \c T_SOLVER with the preconditioner of the
+/// given type.
+/// \tparam UpLo \c Eigen::Upper if the matrix stores its upper triangle only,
+///         \c Eigen::Lower|Eigen::Upper for the full matrix.
+template <template <typename> class T_SOLVER, int UpLo, class T_BASE>
+T_BASE* createIterativeSolver(EigenMatrix &A, EigenOption::PreconType const precon_type)
+{
+    switch (precon_type)
+    {
+    case EigenOption::PreconType::NONE:
+        return new EigenIterativeLinearSolver<T_SOLVER<Eigen::IdentityPreconditioner>, T_BASE>(A);
+    case EigenOption::PreconType::DIAGONAL:
+        return new EigenIterativeLinearSolver<T_SOLVER<Eigen::DiagonalPreconditioner<double>>, T_BASE>(A);
+    case EigenOption::PreconType::AMG:
+        return new EigenIterativeLinearSolver<T_SOLVER<EigenAMGPreconditioner<UpLo>>, T_BASE>(A);
+    case EigenOption::PreconType::ILUT:
+        if (UpLo == Eigen::Upper) {
+            ERR("The ILUT preconditioner does not support symmetric matrix "
+                "storage; use IC or ILU0.");
+            std::abort();
+        }
+        return new EigenIterativeLinearSolver<T_SOLVER<Eigen::IncompleteLUT<double>>, T_BASE>(A);
+    case EigenOption::PreconType::IC:
+#if EIGEN_VERSION_AT_LEAST(3,3,0)
+        return new EigenIterativeLinearSolver<T_SOLVER<Eigen::IncompleteCholesky<double, UpLo == Eigen::Upper ? Eigen::Upper : Eigen::Lower>>, T_BASE>(A);
+#else
+        // Before Eigen 3.3 the incomplete Cholesky factorization is part of
+        // the unsupported modules only.
+        ERR("The IC preconditioner requires Eigen 3.3 or later; use ILU0.");
+        std::abort();
+#endif
+    case EigenOption::PreconType::ILU0:
+        return new EigenIterativeLinearSolver<T_SOLVER<EigenILU0Preconditioner<UpLo>>, T_BASE>(A);
+    }
+    return nullptr;
+}
+
 } // details
 
 EigenLinearSolver::EigenLinearSolver(EigenMatrix &A,
@@ -104,15 +187,27 @@ EigenLinearSolver::EigenLinearSolver(EigenMatrix &A,
 
     if (!A.getRawMatrix().isCompressed())
         A.getRawMatrix().makeCompressed();
-    if (_option.solver_type==EigenOption::SolverType::SparseLU) {
+    // A symmetric matrix stores its upper triangle only, which is all the
+    // symmetric solvers read.
+    if (A.isSymmetric()) {
+        if (_option.solver_type==EigenOption::SolverType::SparseLU) {
+            INFO("-> symmetric matrix: using LDLT instead of LU decomposition");
+            using SolverType = Eigen::SimplicialLDLT<EigenMatrix::RawMatrixType, Eigen::Upper>;
+            _solver = new details::EigenDirectLinearSolver<SolverType, IEigenSolver>(A);
+        } else if (_option.solver_type==EigenOption::SolverType::CG) {
+            _solver = details::createIterativeSolver<details::CGUpper, Eigen::Upper, IEigenSolver>(A, _option.precon_type);
+        } else {
+            ERR("The Eigen solver does not support symmetric matrix "
+                "storage; use CG or SparseLU.");
+            std::abort();
+        }
+    } else if (_option.solver_type==EigenOption::SolverType::SparseLU) {
         using SolverType = Eigen::SparseLU<EigenMatrix::RawMatrixType, Eigen::COLAMDOrdering<int>>;
-        _solver = new details::EigenDirectLinearSolver<SolverType, IEigenSolver>(A.getRawMatrix());
+        _solver = new details::EigenDirectLinearSolver<SolverType, IEigenSolver>(A);
     } else if (_option.solver_type==EigenOption::SolverType::BiCGSTAB) {
-        using SolverType = Eigen::BiCGSTAB<EigenMatrix::RawMatrixType, Eigen::DiagonalPreconditioner<double>>;
-        _solver = new details::EigenIterativeLinearSolver<SolverType, IEigenSolver>(A.getRawMatrix());
+        _solver = details::createIterativeSolver<details::BiCGSTAB, Eigen::Lower | Eigen::Upper, IEigenSolver>(A, _option.precon_type);
     } else if (_option.solver_type==EigenOption::SolverType::CG) {
-        using SolverType = Eigen::ConjugateGradient<EigenMatrix::RawMatrixType, Eigen::Lower, Eigen::DiagonalPreconditioner<double>>;
-        _solver = new details::EigenIterativeLinearSolver<SolverType, IEigenSolver>(A.getRawMatrix());
+        _solver = details::createIterativeSolver<details::CGLower, Eigen::Lower | Eigen::Upper, IEigenSolver>(A, _option.precon_type);
     }
 }
 
@@ -137,11 +232,12 @@ void EigenLinearSolver::setOption(BaseLib::ConfigTree const& option)
     }
 }
 
-void EigenLinearSolver::solve(EigenVector &b, EigenVector &x)
+void EigenLinearSolver::solve(EigenVector &b, EigenVector &x,
+                              LinearSolverBehaviour const behaviour)
 {
     INFO("------------------------------------------------------------------");
     INFO("*** Eigen solver computation");
-    _solver->solve(b.getRawVector(), x.getRawVector(), _option);
+    _solver->solve(b.getRawVector(), x.getRawVector(), _option, behaviour);
     INFO("------------------------------------------------------------------");
 }
 
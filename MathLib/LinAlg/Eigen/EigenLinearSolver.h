@@ -14,6 +14,7 @@
 
 
 #include "BaseLib/ConfigTree.h"
+#include "MathLib/LinAlg/LinAlgEnums.h"
 #include "EigenVector.h"
 #include "EigenOption.h"
 
@@ -62,8 +63,13 @@ public:
      *
      * @param b     RHS vector
      * @param x     Solution vector
+     * @param behaviour If the matrix is unchanged since the previous call,
+     *              LinearSolverBehaviour::REUSE skips the factorization or
+     *              the preconditioner setup, respectively.
      */
-    void solve(EigenVector &b, EigenVector &x);
+    void solve(EigenVector &b, EigenVector &x,
+               LinearSolverBehaviour const behaviour =
+                   LinearSolverBehaviour::RECOMPUTE);
 
 protected:
     class IEigenSolver
@@ -73,7 +79,8 @@ protected:
         /**
          * execute a linear solver
          */
-        virtual void solve(EigenVector::RawVectorType &b, EigenVector::RawVectorType &x, EigenOption &) = 0;
+        virtual void solve(EigenVector::RawVectorType &b, EigenVector::RawVectorType &x, EigenOption &,
+                           LinearSolverBehaviour behaviour) = 0;
     };
 
     EigenOption _option;
@@ -15,8 +15,15 @@
 #include <string>
 #endif
 
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
 #include <Eigen/Sparse>
+#include <logog/include/logog.hpp>
 
+#include "MathLib/LinAlg/CompressedSparsityPattern.h"
 #include "MathLib/LinAlg/RowColumnIndices.h"
 #include "MathLib/LinAlg/SetMatrixSparsity.h"
 #include "EigenVector.h"
@@ -28,6 +35,8 @@ namespace MathLib
  * Global matrix based on Eigen sparse matrix
  *
  * The matrix will be dynamically allocated during construction.
+ *
+ * A symmetric matrix may store its upper triangle only, see setSymmetric().
  */
 class EigenMatrix final
 {
@@ -67,12 +76,40 @@ public:
         // don't use _mat.setZero(). it makes a matrix uncompressed
     }
 
+    /// Compresses the matrix and fixes its structure. Setting or adding
+    /// non-zero values to entries not being part of the structure aborts the
+    /// program afterwards, instead of inserting new entries.
+    void freezeStructure()
+    {
+        _mat.makeCompressed();
+        _structure_frozen = true;
+    }
+
+    /// Returns true if the structure has been fixed by freezeStructure().
+    bool isStructureFrozen() const { return _structure_frozen; }
+
+    /// Declares the matrix symmetric; must be called before any entry is
+    /// set. Only the upper triangle including the diagonal is stored then:
+    /// values set or added below the diagonal are ignored, and sub-matrices
+    /// added at the same row and column positions are read in their upper
+    /// triangle only. The other operations act on the full symmetric matrix.
+    void setSymmetric()
+    {
+        assert(_mat.nonZeros() == 0);
+        _symmetric = true;
+    }
+
+    /// Returns true if only the upper triangle is stored, see setSymmetric().
+    bool isSymmetric() const { return _symmetric; }
+
     /// set a value to the given entry. If the entry doesn't exist, this class
     /// dynamically allocates it.
     int setValue(IndexType row, IndexType col, double val)
     {
         assert(row < (IndexType) getNRows() && col < (IndexType) getNCols());
-        if (val != 0.0) _mat.coeffRef(row, col) = val;
+        if (_symmetric && row > col)
+            return 0;
+        if (val != 0.0) coeffRef(row, col) = val;
         return 0;
     }
 
@@ -80,14 +117,16 @@ public:
     /// inserted.
     int add(IndexType row, IndexType col, double val)
     {
-        if (val != 0.0) _mat.coeffRef(row, col) += val;
+        if (_symmetric && row > col)
+            return 0;
+        if (val != 0.0) coeffRef(row, col) += val;
         return 0;
     }
 
     /// Add sub-matrix at positions \c row_pos and same column positions as the
     /// given row positions. If the entry doesn't exist, the value is inserted.
     template<class T_DENSE_MATRIX>
-    void add(std::vector<IndexType> const& row_pos,
+    void add(IndexSpan<IndexType> const& row_pos,
             const T_DENSE_MATRIX &sub_matrix,
             double fkt = 1.0)
     {
@@ -96,12 +135,21 @@ public:
 
     /// Add sub-matrix at positions given by \c indices. If the entry doesn't exist,
     /// this class inserts the value.
+    /// If the value positions are provided by the \c indices, the values are
+    /// added directly to the compressed value storage.
     template<class T_DENSE_MATRIX>
     void add(RowColumnIndices<IndexType> const& indices,
             const T_DENSE_MATRIX &sub_matrix,
             double fkt = 1.0)
     {
-        this->add(indices.rows, indices.columns, sub_matrix, fkt);
+        if (indices.positions && _symmetric)
+            addUpperAtPositions(indices.positions, indices.rows.size(),
+                                sub_matrix, fkt);
+        else if (indices.positions)
+            addAtPositions(indices.positions, indices.rows.size(),
+                           indices.columns.size(), sub_matrix, fkt);
+        else
+            this->add(indices.rows, indices.columns, sub_matrix, fkt);
     }
 
     /// Add sub-matrix at positions \c row_pos and \c col_pos. If the entries doesn't
@@ -113,13 +161,15 @@ public:
     /// @param sub_matrix  a sub-matrix to be added
     /// @param fkt         a scaling factor applied to all entries in the sub-matrix
     template <class T_DENSE_MATRIX>
-    void add(std::vector<IndexType> const& row_pos,
-            std::vector<IndexType> const& col_pos, const T_DENSE_MATRIX &sub_matrix,
+    void add(IndexSpan<IndexType> const& row_pos,
+            IndexSpan<IndexType> const& col_pos, const T_DENSE_MATRIX &sub_matrix,
             double fkt = 1.0);
 
     /// get value. This function returns zero if the element doesn't exist.
     double get(IndexType row, IndexType col) const
     {
+        if (_symmetric && row > col)
+            return _mat.coeff(col, row);
         return _mat.coeff(row, col);
     }
 
@@ -138,7 +188,11 @@ public:
     /// y = mat * x
     void multiply(const EigenVector &x, EigenVector &y) const
     {
-        y.getRawVector() = _mat * x.getRawVector();
+        if (_symmetric)
+            y.getRawVector() =
+                _mat.selfadjointView<Eigen::Upper>() * x.getRawVector();
+        else
+            y.getRawVector() = _mat * x.getRawVector();
     }
 
     /// return always true, i.e. the matrix is always ready for use
@@ -166,17 +220,88 @@ public:
     RawMatrixType& getRawMatrix() { return _mat; }
     const RawMatrixType& getRawMatrix() const { return _mat; }
 
+private:
+    /// Returns a reference to the entry. For a frozen structure the entry is
+    /// searched only, and the program is aborted if it doesn't exist.
+    double& coeffRef(IndexType row, IndexType col)
+    {
+        if (!_structure_frozen)
+            return _mat.coeffRef(row, col);
+
+        auto const* const inner = _mat.innerIndexPtr();
+        auto const* const row_begin = inner + _mat.outerIndexPtr()[row];
+        auto const* const row_end = inner + _mat.outerIndexPtr()[row + 1];
+        auto const* const it = std::lower_bound(row_begin, row_end, col);
+        if (it == row_end || *it != col)
+        {
+            ERR("EigenMatrix: entry (%ld, %ld) is not part of the frozen "
+                "matrix structure.", static_cast<long>(row),
+                static_cast<long>(col));
+            std::abort();
+        }
+        return _mat.valuePtr()[it - inner];
+    }
+
+    /// Adds the \c n_rows x \c n_cols sub-matrix to the entries of the value
+    /// storage at the given positions, which are in row-major order.
+    template <class T_DENSE_MATRIX>
+    void addAtPositions(IndexType const* positions,
+                        std::size_t const n_rows, std::size_t const n_cols,
+                        const T_DENSE_MATRIX &sub_matrix, double fkt)
+    {
+        assert(_structure_frozen);
+        auto* const values = _mat.valuePtr();
+        for (std::size_t i = 0; i < n_rows; i++)
+            for (std::size_t j = 0; j < n_cols; j++)
+                values[*positions++] += fkt * sub_matrix(i, j);
+    }
+
+    /// Adds the upper triangle of the symmetric \c n x \c n sub-matrix to
+    /// the entries of the value storage at the given positions, which are in
+    /// row-major order of the upper triangle.
+    template <class T_DENSE_MATRIX>
+    void addUpperAtPositions(IndexType const* positions, std::size_t const n,
+                             const T_DENSE_MATRIX &sub_matrix, double fkt)
+    {
+        assert(_structure_frozen);
+        auto* const values = _mat.valuePtr();
+        for (std::size_t i = 0; i < n; i++)
+            for (std::size_t j = i; j < n; j++)
+                values[*positions++] += fkt * sub_matrix(i, j);
+    }
+
 protected:
     RawMatrixType _mat;
+
+    /// \see freezeStructure()
+    bool _structure_frozen = false;
+
+    /// \see setSymmetric()
+    bool _symmetric = false;
 };
 
 template <class T_DENSE_MATRIX>
-void EigenMatrix::add(std::vector<IndexType> const& row_pos,
-                      std::vector<IndexType> const& col_pos,
+void EigenMatrix::add(IndexSpan<IndexType> const& row_pos,
+                      IndexSpan<IndexType> const& col_pos,
                       const T_DENSE_MATRIX& sub_matrix, double fkt)
 {
     auto const n_rows = row_pos.size();
     auto const n_cols = col_pos.size();
+
+    // A symmetric diagonal block is read in its upper triangle; the global
+    // entries are stored in the upper triangle.
+    if (_symmetric && row_pos.data() == col_pos.data() && n_rows == n_cols) {
+        for (auto i = decltype(n_rows){0}; i < n_rows; i++) {
+            for (auto j = i; j < n_cols; j++) {
+                auto const row = std::min(row_pos[i], row_pos[j]);
+                auto const col = std::max(row_pos[i], row_pos[j]);
+                double const v = fkt * sub_matrix(i, j);
+                if (v != 0.0) coeffRef(row, col) += v;
+            }
+        }
+        return;
+    }
+
     for (auto i = decltype(n_rows){0}; i < n_rows; i++) {
         auto const row = row_pos[i];
         for (auto j = decltype(n_cols){0}; j < n_cols; j++) {
@@ -205,6 +330,59 @@ void operator()(EigenMatrix &matrix, SPARSITY_PATTERN const& sparsity_pattern)
 }
 };
 
+/// Creates the given non-zero structure with zero values in the underlying
+/// EigenMatrix, such that no entries are inserted during the assembly. A
+/// frozen structure is kept.
+template <typename IDX_TYPE>
+struct SetMatrixSparsity<EigenMatrix, CompressedSparsityPattern<IDX_TYPE>>
+{
+
+void operator()(EigenMatrix &matrix,
+                CompressedSparsityPattern<IDX_TYPE> const& sparsity_pattern)
+{
+    static_assert(EigenMatrix::RawMatrixType::IsRowMajor,
+                  "Set matrix sparsity relies on the EigenMatrix to be in "
+                  "row-major storage order.");
+
+    assert(matrix.getNRows() == sparsity_pattern.size());
+
+    if (matrix.isStructureFrozen())
+        return;
+
+    auto& mat = matrix.getRawMatrix();
+    mat.setZero();
+    mat.makeCompressed();
+
+    if (matrix.isSymmetric()) {
+        // Upper triangle only.
+        auto const n = sparsity_pattern.size();
+        std::vector<IDX_TYPE> col_idx;
+        col_idx.reserve((sparsity_pattern.col_idx.size() + n) / 2);
+        auto* const outer = mat.outerIndexPtr();
+        outer[0] = 0;
+        for (std::size_t row = 0; row < n; ++row) {
+            for (auto k = sparsity_pattern.row_ptr[row];
+                 k < sparsity_pattern.row_ptr[row + 1]; ++k)
+                if (sparsity_pattern.col_idx[k] >= static_cast<IDX_TYPE>(row))
+                    col_idx.push_back(sparsity_pattern.col_idx[k]);
+            outer[row + 1] = col_idx.size();
+        }
+        mat.resizeNonZeros(col_idx.size());
+        std::copy(col_idx.cbegin(), col_idx.cend(), mat.innerIndexPtr());
+        std::fill_n(mat.valuePtr(), mat.nonZeros(), 0.0);
+        return;
+    }
+
+    mat.resizeNonZeros(sparsity_pattern.col_idx.size());
+
+    std::copy(sparsity_pattern.row_ptr.cbegin(),
+              sparsity_pattern.row_ptr.cend(), mat.outerIndexPtr());
+    std::copy(sparsity_pattern.col_idx.cbegin(),
+              sparsity_pattern.col_idx.cend(), mat.innerIndexPtr());
+    std::fill_n(mat.valuePtr(), mat.nonZeros(), 0.0);
+}
+};
+
 } // end namespace MathLib
 
 #endif
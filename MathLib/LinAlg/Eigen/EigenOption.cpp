@@ -9,13 +9,17 @@
 
 #include "EigenOption.h"
 
+#include <cstdlib>
+
+#include <logog/include/logog.hpp>
+
 namespace MathLib
 {
 
 EigenOption::EigenOption()
 {
     solver_type = SolverType::SparseLU;
-    precon_type = PreconType::NONE;
+    precon_type = PreconType::DIAGONAL;
     max_iterations = static_cast<int>(1e6);
     error_tolerance = 1.e-16;
 }
@@ -40,8 +44,13 @@ EigenOption::PreconType EigenOption::getPreconType(const std::string &precon_nam
 
     RETURN_PRECOM_ENUM_IF_SAME_STRING(precon_name, NONE);
     RETURN_PRECOM_ENUM_IF_SAME_STRING(precon_name, DIAGONAL);
+    RETURN_PRECOM_ENUM_IF_SAME_STRING(precon_name, AMG);
+    RETURN_PRECOM_ENUM_IF_SAME_STRING(precon_name, ILUT);
+    RETURN_PRECOM_ENUM_IF_SAME_STRING(precon_name, IC);
+    RETURN_PRECOM_ENUM_IF_SAME_STRING(precon_name, ILU0);
 
-    return PreconType::NONE;
+    ERR("Unknown Eigen preconditioner type `%s'.", precon_name.c_str());
+    std::abort();
 #undef RETURN_PRECOM_ENUM_IF_SAME_STRING
 }
 
@@ -31,7 +31,12 @@ struct EigenOption final
     enum class PreconType : short
     {
         NONE,
-        DIAGONAL
+        DIAGONAL,   ///< Jacobi
+        AMG,        ///< smoothed aggregation algebraic multigrid
+        ILUT,       ///< incomplete LU with dual threshold
+        IC,         ///< incomplete Cholesky, for symmetric positive definite
+                    ///< matrices; requires Eigen 3.3
+        ILU0        ///< incomplete LU without fill-in, with level scheduling
     };
 
     /// Linear solver type
@@ -45,7 +50,7 @@ struct EigenOption final
 
     /// Constructor
     ///
-    /// Default options are CG, no preconditioner, iteration count 500 and
+    /// Default options are CG, diagonal preconditioner, iteration count 500 and
     /// tolerance 1e-10. Default matrix storage type is CRS.
     EigenOption();
 
@@ -61,8 +66,8 @@ struct EigenOption final
     ///
     /// @param precon_name
     /// @return a preconditioner type
-    ///      If there is no preconditioner type matched with the given name, NONE
-    ///      is returned.
+    ///      If there is no preconditioner type matched with the given name, the
+    ///      program is aborted.
     static PreconType getPreconType(const std::string &precon_name);
 
 };
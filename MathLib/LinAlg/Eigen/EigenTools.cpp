@@ -9,60 +9,295 @@
 
 #include "EigenTools.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <numeric>
+
 #include <logog/include/logog.hpp>
 
 #include "EigenVector.h"
 
 namespace MathLib
 {
+namespace
+{
+/// Returns true if both compressed matrices store the same entries.
+bool haveSameStructure(EigenMatrix::RawMatrixType const& A,
+                       EigenMatrix::RawMatrixType const& B)
+{
+    if (!A.isCompressed() || !B.isCompressed())
+        return false;
+    if (A.rows() != B.rows() || A.cols() != B.cols() ||
+        A.nonZeros() != B.nonZeros())
+        return false;
+    if (A.innerIndexPtr() == B.innerIndexPtr())
+        return true;
+    return std::equal(A.outerIndexPtr(), A.outerIndexPtr() + A.outerSize() + 1,
+                      B.outerIndexPtr()) &&
+           std::equal(A.innerIndexPtr(), A.innerIndexPtr() + A.nonZeros(),
+                      B.innerIndexPtr());
+}
+}  // namespace
 
-void applyKnownSolution(EigenMatrix &A_, EigenVector &b_, EigenVector &/*x*/,
-		const std::vector<EigenMatrix::IndexType> &vec_knownX_id,
-		const std::vector<double> &vec_knownX_x, double /*penalty_scaling*/)
+KnownSolutionElimination<EigenMatrix::IndexType> createKnownSolutionElimination(
+		EigenMatrix &A_, const std::vector<EigenMatrix::IndexType> &vec_knownX_id)
 {
     using SpMat = EigenMatrix::RawMatrixType;
+    using IndexType = EigenMatrix::IndexType;
     static_assert(SpMat::IsRowMajor, "matrix is assumed to be row major!");
 
     auto &A = A_.getRawMatrix();
-    auto &b = b_.getRawVector();
 
-    // A(k, j) = 0.
-    // set row to zero
-    for (auto row_id : vec_knownX_id)
-        for (SpMat::InnerIterator it(A,row_id); it; ++it) {
-            if (it.col() != decltype(it.col())(row_id)) it.valueRef() = 0.0;
+    // The diagonal entries of the known rows are needed for the elimination.
+    for (auto const row_id : vec_knownX_id)
+    {
+        bool has_diagonal = false;
+        for (SpMat::InnerIterator it(A, row_id); it; ++it)
+            if (it.col() == row_id)
+                has_diagonal = true;
+        if (has_diagonal)
+            continue;
+        if (A_.isStructureFrozen()) {
+            ERR("applyKnownSolution(): the diagonal entry %ld is not part of "
+                "the frozen matrix structure.", static_cast<long>(row_id));
+            std::abort();
         }
+        A.coeffRef(row_id, row_id) = 0.0;
+    }
+    if (!A.isCompressed())
+        A.makeCompressed();
+
+    auto const* const outer = A.outerIndexPtr();
+    auto const* const inner = A.innerIndexPtr();
+
+    // Index into vec_knownX_id for each known row; for repeated ids the last
+    // occurrence eliminates the column.
+    std::vector<IndexType> known_index(A.rows(), -1);
+    for (std::size_t ix = 0; ix < vec_knownX_id.size(); ++ix)
+        known_index[vec_knownX_id[ix]] = ix;
 
-    SpMat AT = A.transpose();
+    // Calls f(ix, row, p) for each entry A(row, k) at position p in the
+    // value storage of the column of the known entry k = vec_knownX_id[ix] in
+    // an unknown row; the entries in the known rows are zeroed anyway. For a
+    // symmetric matrix the entries below the diagonal are A(k, row) stored in
+    // the upper triangle of the known row.
+    bool const symmetric = A_.isSymmetric();
+    auto const for_each_column_entry = [&](
+        std::function<void(IndexType, IndexType, IndexType)> const& f)
+    {
+        for (IndexType row = 0; row < A.rows(); ++row)
+        {
+            if (known_index[row] == -1)
+            {
+                for (auto p = outer[row]; p < outer[row + 1]; ++p)
+                    if (known_index[inner[p]] != -1)
+                        f(known_index[inner[p]], row, p);
+            }
+            else if (symmetric)
+            {
+                for (auto p = outer[row]; p < outer[row + 1]; ++p)
+                    if (known_index[inner[p]] == -1)
+                        f(known_index[row], inner[p], p);
+            }
+        }
+    };
+
+    KnownSolutionElimination<IndexType> elimination;
+
+    // Count the column entries.
+    elimination.offsets.assign(vec_knownX_id.size() + 1, 0);
+    for_each_column_entry(
+        [&elimination](IndexType const ix, IndexType, IndexType)
+        {
+            ++elimination.offsets[ix + 1];
+        });
+    std::partial_sum(elimination.offsets.begin(), elimination.offsets.end(),
+                     elimination.offsets.begin());
+
+    elimination.rows.resize(elimination.offsets.back());
+    elimination.positions.resize(elimination.offsets.back());
+    std::vector<std::size_t> fill(elimination.offsets.begin(),
+                                  elimination.offsets.end() - 1);
+    for_each_column_entry(
+        [&elimination, &fill](IndexType const ix, IndexType const row,
+                              IndexType const p)
+        {
+            elimination.rows[fill[ix]] = row;
+            elimination.positions[fill[ix]] = p;
+            ++fill[ix];
+        });
+
+    elimination.diagonal_positions.reserve(vec_knownX_id.size());
+    for (auto const row_id : vec_knownX_id)
+    {
+        auto const* const it = std::lower_bound(
+            inner + outer[row_id], inner + outer[row_id + 1], row_id);
+        elimination.diagonal_positions.push_back(it - inner);
+    }
+
+    return elimination;
+}
+
+void applyKnownSolution(EigenMatrix &A_, EigenVector &b_, EigenVector &/*x*/,
+		const std::vector<EigenMatrix::IndexType> &vec_knownX_id,
+		const std::vector<double> &vec_knownX_x,
+		KnownSolutionElimination<EigenMatrix::IndexType> &elimination)
+{
+    // Without a frozen structure the positions may be outdated.
+    if (elimination.empty() || !A_.isStructureFrozen())
+        elimination = createKnownSolutionElimination(A_, vec_knownX_id);
+
+    auto &A = A_.getRawMatrix();
+    auto &b = b_.getRawVector();
+    auto const* const outer = A.outerIndexPtr();
+    auto const* const inner = A.innerIndexPtr();
+    auto* const values = A.valuePtr();
+
+    elimination.values.resize(elimination.rows.size());
+    elimination.diagonal.resize(vec_knownX_id.size());
 
     for (std::size_t ix=0; ix<vec_knownX_id.size(); ix++)
     {
-        SpMat::Index const row_id = vec_knownX_id[ix];
+        auto const row_id = vec_knownX_id[ix];
         auto const x = vec_knownX_x[ix];
 
         // b_i -= A(i,k)*val, i!=k
         // set column to zero, subtract from rhs
-        for (SpMat::InnerIterator it(AT, row_id); it; ++it)
+        for (auto j = elimination.offsets[ix]; j < elimination.offsets[ix + 1]; ++j)
         {
-            if (it.col() == row_id) continue;
-
-            b[it.col()] -= it.value()*x;
-            it.valueRef() = 0.0;
+            auto& v = values[elimination.positions[j]];
+            elimination.values[j] = v;
+            b[elimination.rows[j]] -= v*x;
+            v = 0.0;
         }
 
-        auto& c = AT.coeffRef(row_id, row_id);
+        auto& c = values[elimination.diagonal_positions[ix]];
         if (c != 0.0) {
             b[row_id] = x * c;
         } else {
             b[row_id] = x;
             c = 1.0;
         }
+        elimination.diagonal[ix] = c;
     }
 
-    A = AT.transpose();
+    // A(k, j) = 0.
+    // set row to zero; for symmetric matrices the entries in unknown columns
+    // have been recorded before
+    for (auto const row_id : vec_knownX_id)
+        for (auto p = outer[row_id]; p < outer[row_id + 1]; ++p)
+            if (inner[p] != row_id)
+                values[p] = 0.0;
 }
 
-} // MathLib
+void applyKnownSolution(EigenMatrix &A, EigenVector &b, EigenVector &x,
+		const std::vector<EigenMatrix::IndexType> &vec_knownX_id,
+		const std::vector<double> &vec_knownX_x, double /*penalty_scaling*/)
+{
+    KnownSolutionElimination<EigenMatrix::IndexType> elimination;
+    applyKnownSolution(A, b, x, vec_knownX_id, vec_knownX_x, elimination);
+}
+
+bool linearCombination(EigenMatrix &C_, double const a, EigenMatrix const &A_,
+		double const b, EigenMatrix const &B_)
+{
+    if (A_.isSymmetric() != B_.isSymmetric() ||
+        C_.isSymmetric() != A_.isSymmetric()) {
+        ERR("linearCombination(): the matrices are not all symmetric.");
+        std::abort();
+    }
 
+    auto &C = C_.getRawMatrix();
+    auto const &A = A_.getRawMatrix();
+    auto const &B = B_.getRawMatrix();
 
+    if (!haveSameStructure(A, B))
+    {
+        if (C_.isStructureFrozen()) {
+            ERR("linearCombination(): the matrices' structures differ from "
+                "the frozen structure of the result.");
+            std::abort();
+        }
+        C = a * A + b * B;
+        return true;
+    }
 
+    if (!haveSameStructure(C, A))
+    {
+        if (C_.isStructureFrozen()) {
+            ERR("linearCombination(): the matrices' structure differs from "
+                "the frozen structure of the result.");
+            std::abort();
+        }
+        C = A;
+    }
+
+    auto const* const a_values = A.valuePtr();
+    auto const* const b_values = B.valuePtr();
+    auto* const c_values = C.valuePtr();
+
+    OPENMP_LOOP_TYPE const n = C.nonZeros();
+    #pragma omp parallel for
+    for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+        c_values[i] = a * a_values[i] + b * b_values[i];
+
+    return true;
+}
+
+bool setSymmetricStorage(EigenMatrix &A)
+{
+    A.setSymmetric();
+    return true;
+}
+
+void setFromCompressedRows(EigenMatrix &A_,
+		const std::vector<EigenMatrix::IndexType> &row_offsets,
+		const std::vector<EigenMatrix::IndexType> &columns,
+		const std::vector<double> &values)
+{
+    if (A_.isStructureFrozen()) {
+        ERR("setFromCompressedRows(): the matrix structure is frozen.");
+        std::abort();
+    }
+    assert(row_offsets.size() == A_.getNRows() + 1);
+
+    using Index = EigenMatrix::RawMatrixType::Index;
+    bool const upper_only = A_.isSymmetric();
+    std::size_t const n_rows = A_.getNRows();
+
+    // First entry of each row to be stored; the columns are sorted, so the
+    // lower triangle of a symmetric matrix is skipped.
+    std::vector<EigenMatrix::IndexType> row_begin(row_offsets.begin(),
+                                                  row_offsets.end() - 1);
+    std::size_t nnz = 0;
+    for (std::size_t r = 0; r < n_rows; r++)
+    {
+        if (upper_only)
+            row_begin[r] = std::lower_bound(
+                columns.begin() + row_offsets[r],
+                columns.begin() + row_offsets[r + 1],
+                static_cast<EigenMatrix::IndexType>(r)) - columns.begin();
+        nnz += row_offsets[r + 1] - row_begin[r];
+    }
+
+    auto &A = A_.getRawMatrix();
+    A.setZero();
+    A.makeCompressed();
+    A.resizeNonZeros(nnz);
+
+    Index n = 0;
+    for (std::size_t r = 0; r < n_rows; r++)
+    {
+        A.outerIndexPtr()[r] = n;
+        for (auto k = row_begin[r]; k < row_offsets[r + 1]; k++, n++)
+        {
+            A.innerIndexPtr()[n] = static_cast<Index>(columns[k]);
+            A.valuePtr()[n] = values[k];
+        }
+    }
+    A.outerIndexPtr()[n_rows] = n;
+}
+
+} // MathLib
@@ -13,6 +13,10 @@
 #include <vector>
 
 #include "EigenMatrix.h" // for EigenMatrix::IndexType
+#include "MathLib/LinAlg/KnownSolutionElimination.h"
+#include "MathLib/LinAlg/LinearCombination.h"
+#include "MathLib/LinAlg/SetFromCompressedRows.h"
+#include "MathLib/LinAlg/SymmetricMatrixStorage.h"
 
 namespace MathLib
 {
@@ -32,6 +36,74 @@ void applyKnownSolution(EigenMatrix &A, EigenVector &b, EigenVector &/*x*/,
 		const std::vector<EigenMatrix::IndexType> &_vec_knownX_id,
 		const std::vector<double> &_vec_knownX_x, double penalty_scaling = 1e+10);
 
+/**
+ * Precomputes the elimination of the known solution entries for the current
+ * structure of the matrix. Missing diagonal entries of the known rows are
+ * inserted and the matrix is compressed.
+ *
+ * @param A                 Coefficient matrix
+ * @param _vec_knownX_id    a vector of known solution entry IDs
+ * @return the positions of the column and diagonal entries of the known
+ *         solution entries in the matrix' value storage
+ */
+KnownSolutionElimination<EigenMatrix::IndexType> createKnownSolutionElimination(
+		EigenMatrix &A, const std::vector<EigenMatrix::IndexType> &_vec_knownX_id);
+
+/**
+ * apply known solutions to a system of linear equations in place using the
+ * precomputed elimination, and record the eliminated matrix entries for later
+ * right-hand-side updates
+ *
+ * @param A                 Coefficient matrix
+ * @param b                 RHS vector
+ * @param _vec_knownX_id    a vector of known solution entry IDs
+ * @param _vec_knownX_x     a vector of known solutions
+ * @param elimination       the elimination as created by
+ *                          createKnownSolutionElimination(); it is created if
+ *                          empty or if the matrix structure is not frozen
+ */
+void applyKnownSolution(EigenMatrix &A, EigenVector &b, EigenVector &/*x*/,
+		const std::vector<EigenMatrix::IndexType> &_vec_knownX_id,
+		const std::vector<double> &_vec_knownX_x,
+		KnownSolutionElimination<EigenMatrix::IndexType> &elimination);
+
+/**
+ * compute the linear combination C = a A + b B
+ *
+ * If A and B are compressed and have the same structure, only the value
+ * storages are combined and C gets the structure of A; a frozen C must already
+ * have it. Otherwise the sum is computed by Eigen, which requires C not to be
+ * frozen.
+ *
+ * @param C                 result matrix, may be A or B; all matrices have to
+ *                          be symmetric or not
+ * @return true
+ */
+bool linearCombination(EigenMatrix &C, double const a, EigenMatrix const &A,
+		double const b, EigenMatrix const &B);
+
+/**
+ * store the upper triangle of the matrix only, see EigenMatrix::setSymmetric()
+ *
+ * @return true
+ */
+bool setSymmetricStorage(EigenMatrix &A);
+
+/**
+ * replace the structure and the values of the matrix by the given compressed
+ * rows; entries below the diagonal are dropped for a symmetric matrix
+ *
+ * @param A                 matrix, whose structure must not be frozen
+ * @param row_offsets       offsets of the rows in columns and values; the last
+ *                          entry is the number of entries
+ * @param columns           column indices, ascending in each row
+ * @param values            values of the entries
+ */
+void setFromCompressedRows(EigenMatrix &A,
+		const std::vector<EigenMatrix::IndexType> &row_offsets,
+		const std::vector<EigenMatrix::IndexType> &columns,
+		const std::vector<double> &values);
+
 } // MathLib
 
 #endif //EIGENTOOLS_H_
@@ -19,6 +19,8 @@
 #include <Eigen/Eigen>
 #include <Eigen/Sparse>
 
+#include "MathLib/LinAlg/IndexSpan.h"
+
 namespace MathLib
 {
 
@@ -79,7 +81,7 @@ public:
 
     /// add entries
     template<class T_SUBVEC>
-    void add(const std::vector<IndexType> &pos, const T_SUBVEC &sub_vec)
+    void add(IndexSpan<IndexType> const& pos, const T_SUBVEC &sub_vec)
     {
         for (std::size_t i=0; i<pos.size(); ++i) {
             this->add(pos[i], sub_vec[i]);
@@ -12,6 +12,9 @@
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+
+#include <cstdlib>
+
 #include <logog/include/logog.hpp>
 
 #include "BaseLib/ConfigTree.h"
@@ -31,10 +34,15 @@ EigenLisLinearSolver::EigenLisLinearSolver(
 {
 }
 
-void EigenLisLinearSolver::solve(EigenVector &b_, EigenVector &x_)
+void EigenLisLinearSolver::solve(EigenVector &b_, EigenVector &x_,
+                                 LinearSolverBehaviour const /*behaviour*/)
 {
     static_assert(EigenMatrix::RawMatrixType::IsRowMajor,
                   "Sparse matrix is required to be in row major storage.");
+    if (_A.isSymmetric()) {
+        ERR("EigenLisLinearSolver: symmetric matrix storage is not supported.");
+        std::abort();
+    }
     auto &A = _A.getRawMatrix();
     auto &b = b_.getRawVector();
     auto &x = x_.getRawVector();
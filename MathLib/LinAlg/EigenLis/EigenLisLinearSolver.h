@@ -15,6 +15,8 @@
 #include <lis.h>
 
 #include "BaseLib/ConfigTree.h"
+#include "MathLib/LinAlg/LinAlgEnums.h"
+#include "MathLib/LinAlg/SymmetricMatrixStorage.h"
 #include "MathLib/LinAlg/Lis/LisOption.h"
 
 namespace MathLib
@@ -50,14 +52,23 @@ public:
      *
      * @param b     RHS vector
      * @param x     Solution vector
+     * @param behaviour Ignored; the Lis solver is set up in each call.
      */
-    void solve(EigenVector &b, EigenVector &x);
+    void solve(EigenVector &b, EigenVector &x,
+               LinearSolverBehaviour const behaviour =
+                   LinearSolverBehaviour::RECOMPUTE);
 
 private:
     EigenMatrix& _A;
     LisOption _lis_option;
 };
 
+/// Lis reads the full matrix.
+template <>
+struct SupportsSymmetricStorage<EigenLisLinearSolver> : std::false_type
+{
+};
+
 } // MathLib
 
 #endif //EIGENLISLINEARSOLVER_H_
@@ -0,0 +1,71 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef INDEXSPAN_H_
+#define INDEXSPAN_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace MathLib
+{
+
+/// Non-owning view of a contiguous range of indices, e.g. of a std::vector or
+/// of a part of a larger index array. The viewed data must outlive the span.
+template <typename IDX_TYPE>
+class IndexSpan
+{
+public:
+	IndexSpan() = default;
+
+	IndexSpan(IDX_TYPE const* data, std::size_t const size)
+		: _data(data), _size(size)
+	{ }
+
+	/// Implicit conversion allows to pass vectors wherever spans are expected.
+	IndexSpan(std::vector<IDX_TYPE> const& v)
+		: _data(v.data()), _size(v.size())
+	{ }
+
+	IDX_TYPE const* data() const { return _data; }
+	std::size_t size() const { return _size; }
+	bool empty() const { return _size == 0; }
+
+	IDX_TYPE const& operator[](std::size_t const i) const
+	{
+		assert(i < _size);
+		return _data[i];
+	}
+
+	IDX_TYPE const* begin() const { return _data; }
+	IDX_TYPE const* end() const { return _data + _size; }
+
+private:
+	IDX_TYPE const* _data = nullptr;
+	std::size_t _size = 0;
+};
+
+/// Element-wise comparison of two spans.
+template <typename IDX_TYPE>
+bool operator==(IndexSpan<IDX_TYPE> const& a, IndexSpan<IDX_TYPE> const& b)
+{
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename IDX_TYPE>
+bool operator!=(IndexSpan<IDX_TYPE> const& a, IndexSpan<IDX_TYPE> const& b)
+{
+	return !(a == b);
+}
+
+} // MathLib
+
+#endif  // INDEXSPAN_H_
@@ -0,0 +1,102 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef KNOWNSOLUTIONELIMINATION_H_
+#define KNOWNSOLUTIONELIMINATION_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace MathLib
+{
+
+/// Elimination of known solution entries from a linear system as done by
+/// applyKnownSolution().
+///
+/// For each known entry k the rows i, i != k, of the non-zero entries A(i,k)
+/// of its column are stored. Matrix types supporting it additionally store
+/// the positions of these entries and of the diagonal entries A(k,k) in their
+/// value storage, such that the elimination is done in place.
+///
+/// When applied, the values A(i,k) as they were before the elimination are
+/// recorded together with the final diagonal entries A(k,k). This allows to
+/// apply the same elimination to a new right-hand-side vector, possibly with
+/// changed known values, without touching the matrix again.
+template <typename IDX_TYPE>
+struct KnownSolutionElimination
+{
+	/// Offsets into #rows, #positions, and #values for each known entry. The
+	/// last entry is the total number of stored column entries.
+	std::vector<std::size_t> offsets;
+	std::vector<IDX_TYPE> rows;
+
+	/// Positions of the column entries in the matrix' value storage.
+	std::vector<IDX_TYPE> positions;
+	/// Positions of the diagonal entries in the matrix' value storage.
+	std::vector<IDX_TYPE> diagonal_positions;
+
+	/// Recorded values of the column entries before the elimination.
+	std::vector<double> values;
+	/// Recorded diagonal entries of the known rows after the elimination.
+	std::vector<double> diagonal;
+
+	/// Returns true if nothing has been prepared, i.e. the matrix type does
+	/// not support the recording of the elimination.
+	bool empty() const { return offsets.empty(); }
+};
+
+/// Generic variant for matrix types not supporting a precomputed elimination;
+/// an empty elimination is returned.
+template <typename MAT_T, typename IDX_TYPE>
+KnownSolutionElimination<IDX_TYPE> createKnownSolutionElimination(
+		MAT_T& /*A*/, std::vector<IDX_TYPE> const& /*vec_knownX_id*/)
+{
+	return KnownSolutionElimination<IDX_TYPE>();
+}
+
+/// Applies known solutions to the right-hand-side vector \c b only, using
+/// the matrix entries recorded by a previous call of applyKnownSolution() for
+/// the same known entries \c vec_knownX_id.
+template <typename VEC_T, typename IDX_TYPE>
+void applyKnownSolution(KnownSolutionElimination<IDX_TYPE> const& elimination,
+		VEC_T& b, std::vector<IDX_TYPE> const& vec_knownX_id,
+		std::vector<double> const& vec_knownX_x)
+{
+	assert(elimination.diagonal.size() == vec_knownX_id.size());
+	assert(elimination.values.size() == elimination.rows.size());
+	assert(vec_knownX_x.size() == vec_knownX_id.size());
+
+	for (std::size_t k = 0; k < vec_knownX_id.size(); ++k)
+	{
+		double const x = vec_knownX_x[k];
+		for (std::size_t j = elimination.offsets[k];
+		     j < elimination.offsets[k + 1]; ++j)
+			b.add(elimination.rows[j], -elimination.values[j] * x);
+	}
+
+	for (std::size_t k = 0; k < vec_knownX_id.size(); ++k)
+		b.set(vec_knownX_id[k], elimination.diagonal[k] * vec_knownX_x[k]);
+}
+
+/// Generic variant for matrix types not supporting the recording; the known
+/// solutions are applied as usual and the \c elimination is left empty.
+template <typename MAT_T, typename VEC_T, typename IDX_TYPE>
+void applyKnownSolution(MAT_T& A, VEC_T& b, VEC_T& x,
+		std::vector<IDX_TYPE> const& vec_knownX_id,
+		std::vector<double> const& vec_knownX_x,
+		KnownSolutionElimination<IDX_TYPE>& elimination)
+{
+	elimination = KnownSolutionElimination<IDX_TYPE>();
+	applyKnownSolution(A, b, x, vec_knownX_id, vec_knownX_x);
+}
+
+} // MathLib
+
+#endif  // KNOWNSOLUTIONELIMINATION_H_
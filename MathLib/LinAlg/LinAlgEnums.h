@@ -32,6 +32,14 @@ std::string convertVecNormTypeToString(VecNormType normType);
 /// convert string to VecNormType
 VecNormType convertVecNormTypeToString(const std::string &str);
 
+/// Tells a linear solver whether the coefficient matrix has changed since
+/// its previous solve.
+enum class LinearSolverBehaviour
+{
+    RECOMPUTE,    ///< set up the solver, e.g. factorize, for the current matrix
+    REUSE         ///< the matrix is unchanged; reuse the previous setup
+};
+
 } // end namespace MathLib
 
 #endif /* LINALGENUMS_H_ */
@@ -0,0 +1,38 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef MATHLIB_LINEARCOMBINATION_H_
+#define MATHLIB_LINEARCOMBINATION_H_
+
+namespace MathLib
+{
+
+/// Computes the sparse linear combination \f$ C = a A + b B \f$ of two global
+/// matrices.
+///
+/// Matrix types supporting it combine the value storages directly if \c A
+/// and \c B share their structure, e.g. if both are assembled over the same
+/// sparsity pattern; \c C then gets the same structure.
+///
+/// Generic variant for matrix types not supporting the combination; nothing is
+/// done and false is returned.
+template <typename MAT_T>
+bool linearCombination(MAT_T& /*C*/, double const /*a*/, MAT_T const& /*A*/,
+                       double const /*b*/, MAT_T const& /*B*/)
+{
+	return false;
+}
+
+} // MathLib
+
+#ifdef OGS_USE_EIGEN
+#include "MathLib/LinAlg/Eigen/EigenTools.h"
+#endif // OGS_USE_EIGEN
+
+#endif  // MATHLIB_LINEARCOMBINATION_H_
@@ -32,7 +32,8 @@ LisLinearSolver::LisLinearSolver(LisMatrix &A,
 {
 }
 
-void LisLinearSolver::solve(LisVector &b, LisVector &x)
+void LisLinearSolver::solve(LisVector &b, LisVector &x,
+                            LinearSolverBehaviour const /*behaviour*/)
 {
     finalizeMatrixAssembly(_A);
 
@@ -21,6 +21,7 @@
 #include <lis.h>
 
 #include "BaseLib/ConfigTree.h"
+#include "MathLib/LinAlg/LinAlgEnums.h"
 
 #include "LisOption.h"
 #include "LisVector.h"
@@ -59,8 +60,11 @@ public:
      *
      * @param b     RHS vector
      * @param x     Solution vector
+     * @param behaviour Ignored; the Lis solver is set up in each call.
      */
-    void solve(LisVector &b, LisVector &x);
+    void solve(LisVector &b, LisVector &x,
+               LinearSolverBehaviour const behaviour =
+                   LinearSolverBehaviour::RECOMPUTE);
 
 
 private:
@@ -15,11 +15,13 @@
 #ifndef LISMATRIX_H_
 #define LISMATRIX_H_
 
+#include <cassert>
 #include <string>
 #include <vector>
 
 #include <lis.h>
 
+#include "MathLib/LinAlg/CompressedSparsityPattern.h"
 #include "MathLib/LinAlg/RowColumnIndices.h"
 #include "MathLib/LinAlg/SetMatrixSparsity.h"
 
@@ -124,7 +126,7 @@ public:
     /// Add sub-matrix at positions \c row_pos and same column positions as the
     /// given row positions.
     template<class T_DENSE_MATRIX>
-    void add(std::vector<IndexType> const& row_pos,
+    void add(IndexSpan<IndexType> const& row_pos,
             const T_DENSE_MATRIX &sub_matrix,
             double fkt = 1.0)
     {
@@ -141,8 +143,8 @@ public:
     }
 
     template <class T_DENSE_MATRIX>
-    void add(std::vector<IndexType> const& row_pos,
-             std::vector<IndexType> const& col_pos,
+    void add(IndexSpan<IndexType> const& row_pos,
+             IndexSpan<IndexType> const& col_pos,
              const T_DENSE_MATRIX& sub_matrix, double fkt = 1.0);
 
     /// get this matrix type
@@ -169,8 +171,8 @@ private:
 };
 
 template <class T_DENSE_MATRIX>
-void LisMatrix::add(std::vector<IndexType> const& row_pos,
-                    std::vector<IndexType> const& col_pos,
+void LisMatrix::add(IndexSpan<IndexType> const& row_pos,
+                    IndexSpan<IndexType> const& col_pos,
                     const T_DENSE_MATRIX& sub_matrix, double fkt)
 {
     auto const n_rows = row_pos.size();
@@ -208,6 +210,28 @@ void operator()(LisMatrix &matrix, SPARSITY_PATTERN const& sparsity_pattern)
 }
 };
 
+/// Allocates the exact number of entries per row of the given structure.
+template <typename IDX_TYPE>
+struct SetMatrixSparsity<LisMatrix, CompressedSparsityPattern<IDX_TYPE>>
+{
+
+void operator()(LisMatrix &matrix,
+                CompressedSparsityPattern<IDX_TYPE> const& sparsity_pattern)
+{
+    auto const n_rows = matrix.getNRows();
+    assert(n_rows == sparsity_pattern.size());
+    std::vector<LisMatrix::IndexType> row_sizes;
+    row_sizes.reserve(n_rows);
+
+    // LIS needs 1 more entry, otherewise it starts reallocating arrays.
+    for (std::size_t i = 0; i < n_rows; ++i)
+        row_sizes.push_back(sparsity_pattern.getRowSize(i) + 1);
+
+    int ierr = lis_matrix_malloc(matrix._AA, 0, row_sizes.data());
+    checkLisError(ierr);
+}
+};
+
 
 } // MathLib
 
@@ -20,6 +20,8 @@
 
 #include <lis.h>
 
+#include "MathLib/LinAlg/IndexSpan.h"
+
 namespace MathLib
 {
 /**
@@ -99,7 +101,7 @@ public:
 
 	///
 	template <class T_SUBVEC>
-	void add(const std::vector<IndexType>& pos, const T_SUBVEC& sub_vec)
+	void add(IndexSpan<IndexType> const& pos, const T_SUBVEC& sub_vec)
 	{
 		for (std::size_t i = 0; i < pos.size(); ++i)
 		{
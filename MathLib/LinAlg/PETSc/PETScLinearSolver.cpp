@@ -47,7 +47,8 @@ PETScLinearSolver::PETScLinearSolver(PETScMatrix& A,
     KSPSetFromOptions(_solver);  // set running time option
 }
 
-bool PETScLinearSolver::solve(const PETScVector &b, PETScVector &x)
+bool PETScLinearSolver::solve(const PETScVector &b, PETScVector &x,
+                              LinearSolverBehaviour const /*behaviour*/)
 {
     BaseLib::RunTime wtimer;
     wtimer.start();
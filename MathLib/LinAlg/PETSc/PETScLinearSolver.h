@@ -24,6 +24,7 @@
 #include "logog/include/logog.hpp"
 
 #include "BaseLib/ConfigTree.h"
+#include "MathLib/LinAlg/LinAlgEnums.h"
 
 #include "PETScMatrix.h"
 #include "PETScVector.h"
@@ -64,9 +65,12 @@ class PETScLinearSolver
             Solve a system of equations.
             \param b The right hand side of the equations.
             \param x The solutions to be solved.
+            \param behaviour Ignored; the KSP operators are set in each call.
             \return  true: converged, false: diverged.
         */
-        bool solve(const PETScVector &b, PETScVector &x);
+        bool solve(const PETScVector &b, PETScVector &x,
+                   LinearSolverBehaviour const behaviour =
+                       LinearSolverBehaviour::RECOMPUTE);
 
         /// Get number of iterations.
         PetscInt getNumberOfIterations() const
@@ -188,8 +188,8 @@ class PETScMatrix
           \param sub_mat A dense matrix to be added on.
         */
         template <class T_DENSE_MATRIX>
-        void add(std::vector<PetscInt> const& row_pos,
-                 std::vector<PetscInt> const& col_pos,
+        void add(IndexSpan<PetscInt> const& row_pos,
+                 IndexSpan<PetscInt> const& col_pos,
                  const T_DENSE_MATRIX &sub_mat );
 
         /*! View the global vector for test purpose. Do not use it for output a big vector.
@@ -259,14 +259,14 @@ class PETScMatrix
     \param sub_mat  A dense sub-matrix to be added.
 */
 template<class T_DENSE_MATRIX>
-void PETScMatrix::add(std::vector<PetscInt> const& row_pos,
-                      std::vector<PetscInt> const& col_pos,
+void PETScMatrix::add(IndexSpan<PetscInt> const& row_pos,
+                      IndexSpan<PetscInt> const& col_pos,
                       const T_DENSE_MATRIX &sub_mat)
 {
     const PetscInt nrows = static_cast<PetscInt> (row_pos.size());
     const PetscInt ncols = static_cast<PetscInt> (col_pos.size());
 
-    MatSetValues(_A, nrows, &row_pos[0], ncols, &col_pos[0], &sub_mat(0,0), ADD_VALUES);
+    MatSetValues(_A, nrows, row_pos.data(), ncols, col_pos.data(), &sub_mat(0,0), ADD_VALUES);
 };
 
 /*!
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include <petscvec.h>
+#include "MathLib/LinAlg/IndexSpan.h"
 #include "MathLib/LinAlg/VectorNorms.h"
 
 typedef Vec PETSc_Vec;
@@ -141,10 +142,10 @@ class PETScVector
                           Note: std::size_t cannot be the type of e_idxs template argument
            \param sub_vec Entries to be added
         */
-        template<class T_SUBVEC> void add(const std::vector<PetscInt> &e_idxs,
+        template<class T_SUBVEC> void add(IndexSpan<PetscInt> const& e_idxs,
                                           const T_SUBVEC &sub_vec)
         {
-            VecSetValues(_v, e_idxs.size(), &e_idxs[0], &sub_vec[0], ADD_VALUES);
+            VecSetValues(_v, e_idxs.size(), e_idxs.data(), &sub_vec[0], ADD_VALUES);
         }
 
         /*!
@@ -0,0 +1,433 @@
+/**
+ * \file
+ * \brief  Implementation of the AMGPreconditioner class.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "AMGPreconditioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <logog/include/logog.hpp>
+
+#include "../Dense/DenseMatrix.h"
+#include "../Solvers/GaussAlgorithm.h"
+
+namespace MathLib
+{
+
+namespace
+{
+using CRS = AMGPreconditioner::CRS;
+
+std::size_t const not_aggregated = std::numeric_limits<std::size_t>::max();
+
+/// y = A x
+void amux(CRS const& A, double const* const x, double* const y)
+{
+	OPENMP_LOOP_TYPE const n = A.n_rows;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+	{
+		double s = 0.0;
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+			s += A.data[k] * x[A.col_idx[k]];
+		y[i] = s;
+	}
+}
+
+CRS transpose(CRS const& A)
+{
+	CRS T;
+	T.n_rows = A.n_cols;
+	T.n_cols = A.n_rows;
+	T.row_ptr.assign(T.n_rows + 1, 0);
+	for (std::size_t k = 0; k < A.row_ptr[A.n_rows]; ++k)
+		T.row_ptr[A.col_idx[k] + 1]++;
+	for (std::size_t i = 0; i < T.n_rows; ++i)
+		T.row_ptr[i + 1] += T.row_ptr[i];
+
+	T.col_idx.resize(A.col_idx.size());
+	T.data.resize(A.data.size());
+	std::vector<std::size_t> position(T.row_ptr.begin(), T.row_ptr.end() - 1);
+	for (std::size_t i = 0; i < A.n_rows; ++i)
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+		{
+			std::size_t const p = position[A.col_idx[k]]++;
+			T.col_idx[p] = i;
+			T.data[p] = A.data[k];
+		}
+	return T;
+}
+
+/// C = A B, computed row by row with a dense marker of the columns.
+CRS multiply(CRS const& A, CRS const& B)
+{
+	CRS C;
+	C.n_rows = A.n_rows;
+	C.n_cols = B.n_cols;
+	C.row_ptr.assign(1, 0);
+
+	// Position of each column in C or any value before the current row.
+	std::vector<std::size_t> marker(B.n_cols,
+	                                std::numeric_limits<std::size_t>::max());
+	for (std::size_t i = 0; i < A.n_rows; ++i)
+	{
+		std::size_t const row_begin = C.col_idx.size();
+		for (std::size_t ka = A.row_ptr[i]; ka < A.row_ptr[i + 1]; ++ka)
+		{
+			std::size_t const j = A.col_idx[ka];
+			for (std::size_t kb = B.row_ptr[j]; kb < B.row_ptr[j + 1]; ++kb)
+			{
+				std::size_t const c = B.col_idx[kb];
+				double const v = A.data[ka] * B.data[kb];
+				if (marker[c] == std::numeric_limits<std::size_t>::max() ||
+				    marker[c] < row_begin)
+				{
+					marker[c] = C.col_idx.size();
+					C.col_idx.push_back(c);
+					C.data.push_back(v);
+				}
+				else
+					C.data[marker[c]] += v;
+			}
+		}
+		C.row_ptr.push_back(C.col_idx.size());
+	}
+	return C;
+}
+
+std::vector<double> getDiagonal(CRS const& A)
+{
+	std::vector<double> diag(A.n_rows, 0.0);
+	for (std::size_t i = 0; i < A.n_rows; ++i)
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+			if (A.col_idx[k] == i)
+				diag[i] += A.data[k];
+	return diag;
+}
+
+/// Groups the unknowns into aggregates of strongly connected neighbours in
+/// the three phases of Vanek et al.; returns the aggregate of each unknown,
+/// which is not_aggregated for unknowns without strong connections.
+std::vector<std::size_t> aggregate(CRS const& A,
+                                   std::vector<double> const& diag,
+                                   double const theta,
+                                   std::size_t& n_aggregates)
+{
+	std::size_t const n = A.n_rows;
+
+	// Strong connections of each row, excluding the diagonal.
+	CRS S;
+	S.n_rows = S.n_cols = n;
+	S.row_ptr.assign(1, 0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+		{
+			std::size_t const j = A.col_idx[k];
+			if (j != i && A.data[k] != 0.0 &&
+			    std::abs(A.data[k]) >
+			        theta * std::sqrt(std::abs(diag[i] * diag[j])))
+				S.col_idx.push_back(j);
+		}
+		S.row_ptr.push_back(S.col_idx.size());
+	}
+
+	std::vector<std::size_t> aggregates(n, not_aggregated);
+	n_aggregates = 0;
+
+	// 1. Root unknowns, whose strong neighbours are all free, form an
+	// aggregate with them.
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (aggregates[i] != not_aggregated ||
+		    S.row_ptr[i] == S.row_ptr[i + 1])
+			continue;
+		bool const all_free = std::all_of(
+		    S.col_idx.begin() + S.row_ptr[i],
+		    S.col_idx.begin() + S.row_ptr[i + 1],
+		    [&aggregates](std::size_t const j)
+		    { return aggregates[j] == not_aggregated; });
+		if (!all_free)
+			continue;
+		aggregates[i] = n_aggregates;
+		for (std::size_t k = S.row_ptr[i]; k < S.row_ptr[i + 1]; ++k)
+			aggregates[S.col_idx[k]] = n_aggregates;
+		n_aggregates++;
+	}
+
+	// 2. The remaining unknowns join an aggregate of the first phase of a
+	// strong neighbour.
+	std::vector<std::size_t> const first_phase = aggregates;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (aggregates[i] != not_aggregated)
+			continue;
+		for (std::size_t k = S.row_ptr[i]; k < S.row_ptr[i + 1]; ++k)
+		{
+			if (first_phase[S.col_idx[k]] != not_aggregated)
+			{
+				aggregates[i] = first_phase[S.col_idx[k]];
+				break;
+			}
+		}
+	}
+
+	// 3. Still remaining unknowns with strong connections form new
+	// aggregates with their free strong neighbours.
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (aggregates[i] != not_aggregated ||
+		    S.row_ptr[i] == S.row_ptr[i + 1])
+			continue;
+		aggregates[i] = n_aggregates;
+		for (std::size_t k = S.row_ptr[i]; k < S.row_ptr[i + 1]; ++k)
+			if (aggregates[S.col_idx[k]] == not_aggregated)
+				aggregates[S.col_idx[k]] = n_aggregates;
+		n_aggregates++;
+	}
+
+	return aggregates;
+}
+
+/// Smoothed prolongation \f$ P = (I - \omega D^{-1} A) P_0 \f$ of the
+/// piecewise constant interpolation \f$ P_0 \f$ of the aggregates, where
+/// \f$ \omega = 4 / (3 \rho(D^{-1} A)) \f$ with the spectral radius bounded by
+/// the maximum absolute row sum.
+CRS smoothedProlongation(CRS const& A, std::vector<double> const& inv_diag,
+                         std::vector<std::size_t> const& aggregates,
+                         std::size_t const n_aggregates)
+{
+	std::size_t const n = A.n_rows;
+
+	CRS P0;
+	P0.n_rows = n;
+	P0.n_cols = n_aggregates;
+	P0.row_ptr.assign(1, 0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (aggregates[i] != not_aggregated)
+		{
+			P0.col_idx.push_back(aggregates[i]);
+			P0.data.push_back(1.0);
+		}
+		P0.row_ptr.push_back(P0.col_idx.size());
+	}
+
+	double rho = 0.0;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		double s = 0.0;
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+			s += std::abs(A.data[k]);
+		rho = std::max(rho, s * std::abs(inv_diag[i]));
+	}
+	double const omega = rho > 0.0 ? 4.0 / (3.0 * rho) : 0.0;
+
+	// P = P0 - omega D^-1 A P0
+	CRS P = multiply(A, P0);
+	for (std::size_t i = 0; i < n; ++i)
+		for (std::size_t k = P.row_ptr[i]; k < P.row_ptr[i + 1]; ++k)
+		{
+			P.data[k] *= -omega * inv_diag[i];
+			if (aggregates[i] == P.col_idx[k])
+				P.data[k] += 1.0;
+		}
+	return P;
+}
+
+void gaussSeidelForward(CRS const& A, std::vector<double> const& inv_diag,
+                        double const* const b, double* const x)
+{
+	for (std::size_t i = 0; i < A.n_rows; ++i)
+	{
+		double r = b[i];
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+			r -= A.data[k] * x[A.col_idx[k]];
+		x[i] += inv_diag[i] * r;
+	}
+}
+
+void gaussSeidelBackward(CRS const& A, std::vector<double> const& inv_diag,
+                         double const* const b, double* const x)
+{
+	for (std::size_t i = A.n_rows; i-- > 0;)
+	{
+		double r = b[i];
+		for (std::size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+			r -= A.data[k] * x[A.col_idx[k]];
+		x[i] += inv_diag[i] * r;
+	}
+}
+}  // namespace
+
+AMGPreconditioner::AMGPreconditioner(AMGOptions const& options)
+    : _options(options)
+{
+}
+
+AMGPreconditioner::~AMGPreconditioner() = default;
+
+void AMGPreconditioner::setup(CRS&& A)
+{
+	_levels.clear();
+	_coarse_solver.reset();
+	_coarse_matrix.reset();
+
+	_levels.emplace_back();
+	_levels.back().A = std::move(A);
+
+	while (true)
+	{
+		Level& level = _levels.back();
+		std::size_t const n = level.A.n_rows;
+		auto const diag = getDiagonal(level.A);
+		level.inv_diag.resize(n);
+		for (std::size_t i = 0; i < n; ++i)
+			level.inv_diag[i] = diag[i] != 0.0 ? 1.0 / diag[i] : 0.0;
+		level.b.resize(n);
+		level.x.resize(n);
+		level.r.resize(n);
+
+		if (n <= _options.max_coarse_size ||
+		    _levels.size() >= _options.max_levels)
+			break;
+
+		std::size_t n_aggregates = 0;
+		auto const aggregates = aggregate(
+		    level.A, diag, _options.strength_threshold, n_aggregates);
+		// No further coarsening possible.
+		if (n_aggregates == 0 || n_aggregates >= n)
+			break;
+
+		level.P = smoothedProlongation(level.A, level.inv_diag, aggregates,
+		                               n_aggregates);
+		level.R = transpose(level.P);
+		CRS coarse = multiply(level.R, multiply(level.A, level.P));
+
+		_levels.emplace_back();
+		_levels.back().A = std::move(coarse);
+	}
+
+	std::size_t const n_coarse = _levels.back().A.n_rows;
+	if (n_coarse > _options.max_coarse_size)
+	{
+		WARN(
+		    "AMG: the coarsest level has %u rows, more than %u for the direct "
+		    "solution; it is smoothed instead.",
+		    static_cast<unsigned>(n_coarse),
+		    static_cast<unsigned>(_options.max_coarse_size));
+	}
+	else if (!decomposeCoarseMatrix())
+	{
+		WARN(
+		    "AMG: the coarsest matrix is singular; the coarsest level is "
+		    "smoothed instead.");
+	}
+
+	DBUG("AMG hierarchy with %u levels:",
+	     static_cast<unsigned>(_levels.size()));
+	for (std::size_t l = 0; l < _levels.size(); ++l)
+		DBUG("\t%u rows, %u non-zero entries.",
+		     static_cast<unsigned>(_levels[l].A.n_rows),
+		     static_cast<unsigned>(_levels[l].A.data.size()));
+}
+
+bool AMGPreconditioner::decomposeCoarseMatrix()
+{
+	CRS const& A_c = _levels.back().A;
+	_coarse_matrix.reset(
+	    new DenseMatrix<double, std::size_t>(A_c.n_rows, A_c.n_cols, 0.0));
+	double max_abs = 0.0;
+	for (std::size_t i = 0; i < A_c.n_rows; ++i)
+		for (std::size_t k = A_c.row_ptr[i]; k < A_c.row_ptr[i + 1]; ++k)
+		{
+			(*_coarse_matrix)(i, A_c.col_idx[k]) += A_c.data[k];
+			max_abs = std::max(max_abs, std::abs(A_c.data[k]));
+		}
+	_coarse_solver.reset(new GaussAlgorithm<DenseMatrix<double, std::size_t>,
+	                                        std::vector<double>>(
+	    *_coarse_matrix));
+	std::vector<double> decomposition_rhs(A_c.n_rows, 0.0);
+	_coarse_solver->solve(decomposition_rhs, true);
+
+	// The pivots are the diagonal entries of the upper triangular factor.
+	double const pivot_tolerance =
+	    A_c.n_rows * std::numeric_limits<double>::epsilon() * max_abs;
+	for (std::size_t i = 0; i < A_c.n_rows; ++i)
+		if (!(std::abs((*_coarse_matrix)(i, i)) > pivot_tolerance))
+		{
+			_coarse_solver.reset();
+			_coarse_matrix.reset();
+			return false;
+		}
+	return true;
+}
+
+void AMGPreconditioner::apply(double const* const r, double* const z) const
+{
+	auto& finest = _levels.front();
+	std::copy(r, r + finest.A.n_rows, finest.b.begin());
+	cycle(0);
+	std::copy(finest.x.begin(), finest.x.end(), z);
+}
+
+void AMGPreconditioner::precondApply(double* const x) const
+{
+	apply(x, x);
+}
+
+void AMGPreconditioner::cycle(std::size_t const l) const
+{
+	Level const& level = _levels[l];
+	if (l + 1 == _levels.size())
+	{
+		if (_coarse_solver)
+		{
+			level.x = level.b;
+			_coarse_solver->solve(level.x, false);
+			return;
+		}
+		std::fill(level.x.begin(), level.x.end(), 0.0);
+		for (unsigned s = 0; s < _options.coarse_sweeps; ++s)
+		{
+			gaussSeidelForward(level.A, level.inv_diag, level.b.data(),
+			                   level.x.data());
+			gaussSeidelBackward(level.A, level.inv_diag, level.b.data(),
+			                    level.x.data());
+		}
+		return;
+	}
+
+	std::fill(level.x.begin(), level.x.end(), 0.0);
+	gaussSeidelForward(level.A, level.inv_diag, level.b.data(),
+	                   level.x.data());
+
+	// Restrict the residual.
+	amux(level.A, level.x.data(), level.r.data());
+	for (std::size_t i = 0; i < level.r.size(); ++i)
+		level.r[i] = level.b[i] - level.r[i];
+	Level const& coarse = _levels[l + 1];
+	amux(level.R, level.r.data(), coarse.b.data());
+
+	cycle(l + 1);
+
+	// Prolongate the correction.
+	amux(level.P, coarse.x.data(), level.r.data());
+	for (std::size_t i = 0; i < level.x.size(); ++i)
+		level.x[i] += level.r[i];
+
+	gaussSeidelBackward(level.A, level.inv_diag, level.b.data(),
+	                    level.x.data());
+}
+
+} // end namespace MathLib
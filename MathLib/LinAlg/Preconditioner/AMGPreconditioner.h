@@ -0,0 +1,170 @@
+/**
+ * \file
+ * \brief  Definition of the AMGPreconditioner class.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef AMGPRECONDITIONER_H_
+#define AMGPRECONDITIONER_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace MathLib
+{
+
+template <typename FP_TYPE, typename IDX_TYPE> class DenseMatrix;
+template <typename MAT_T, typename VEC_T> class GaussAlgorithm;
+
+/// Settings of the AMGPreconditioner.
+struct AMGOptions
+{
+	/// An off-diagonal entry \f$ a_{ij} \f$ is a strong connection if
+	/// \f$ |a_{ij}| > \theta \sqrt{|a_{ii} a_{jj}|} \f$.
+	double strength_threshold = 0.08;
+
+	/// Levels with at most this number of rows are solved directly.
+	std::size_t max_coarse_size = 100;
+
+	/// Maximum number of levels including the finest one.
+	unsigned max_levels = 10;
+
+	/// Number of symmetric Gauss-Seidel sweeps replacing the direct solution
+	/// on a coarsest level which is larger than max_coarse_size or singular.
+	unsigned coarse_sweeps = 10;
+};
+
+/**
+ * Smoothed aggregation algebraic multigrid preconditioner for symmetric
+ * positive definite matrices, e.g. from diffusion problems.
+ *
+ * compute() sets up the hierarchy of coarse matrices once for a matrix in
+ * compressed row storage format; it can then be reused for any number of
+ * applications while the matrix values do not change. The unknowns are
+ * grouped into aggregates of strongly connected neighbours, whose piecewise
+ * constant interpolation is smoothed by one damped Jacobi step. The coarse
+ * matrices are the Galerkin products \f$ P^T A P \f$ and the coarsest one is
+ * solved by an LU decomposition. Rows without strong connections, e.g. those
+ * of eliminated known solutions, are left to the smoother. If the coarsening
+ * stops early, e.g. because it stalls, or if the coarsest matrix is singular,
+ * the coarsest level is smoothed instead of solved.
+ *
+ * One application is a V-cycle with one forward Gauss-Seidel sweep before
+ * and one backward sweep after the coarse grid correction, hence the
+ * preconditioner is symmetric and can be used with CG. The number of CG
+ * iterations is nearly independent of the mesh size.
+ *
+ * \attention apply() uses work vectors stored in the object; one object must
+ * not be applied concurrently.
+ */
+class AMGPreconditioner
+{
+public:
+	explicit AMGPreconditioner(AMGOptions const& options = AMGOptions());
+	~AMGPreconditioner();
+
+	/**
+	 * Sets up the hierarchy for the given \f$ n \times n \f$ matrix.
+	 * @param n number of rows / columns
+	 * @param iA row pointer of compressed row storage format
+	 * @param jA column index of compressed row storage format
+	 * @param A data entries of compressed row storage format
+	 */
+	template <typename IDX_TYPE>
+	void compute(std::size_t const n, IDX_TYPE const* const iA,
+	             IDX_TYPE const* const jA, double const* const A)
+	{
+		CRS matrix;
+		matrix.n_rows = n;
+		matrix.n_cols = n;
+		matrix.row_ptr.assign(iA, iA + n + 1);
+		matrix.col_idx.assign(jA, jA + iA[n]);
+		matrix.data.assign(A, A + iA[n]);
+		setup(std::move(matrix));
+	}
+
+	/// Does nothing; the aggregates depend on the values of the matrix.
+	template <typename IDX_TYPE>
+	void analyzePattern(std::size_t const /*n*/, IDX_TYPE const* const /*iA*/,
+	                    IDX_TYPE const* const /*jA*/)
+	{
+	}
+
+	/// Sets up the hierarchy, same as compute().
+	template <typename IDX_TYPE>
+	void factorize(std::size_t const n, IDX_TYPE const* const iA,
+	               IDX_TYPE const* const jA, double const* const A)
+	{
+		compute(n, iA, jA, A);
+	}
+
+	/// Computes \f$ z = M^{-1} r \f$ by one V-cycle.
+	void apply(double const* const r, double* const z) const;
+
+	/// Applies the preconditioner in place.
+	void precondApply(double* const x) const;
+
+	/// Number of levels of the hierarchy; zero before compute().
+	std::size_t getNLevels() const { return _levels.size(); }
+
+	/// Number of rows of the matrix of the given level.
+	std::size_t getNRows(std::size_t const level) const
+	{
+		return _levels[level].A.n_rows;
+	}
+
+	/// Compressed row storage of the level and transfer matrices.
+	struct CRS
+	{
+		std::size_t n_rows = 0;
+		std::size_t n_cols = 0;
+		std::vector<std::size_t> row_ptr;
+		std::vector<std::size_t> col_idx;
+		std::vector<double> data;
+	};
+
+private:
+	struct Level
+	{
+		CRS A;
+		/// Prolongation from the next coarser level and its transpose.
+		CRS P;
+		CRS R;
+		std::vector<double> inv_diag;
+
+		/// Work vectors: right-hand-side, solution, and residual.
+		mutable std::vector<double> b;
+		mutable std::vector<double> x;
+		mutable std::vector<double> r;
+	};
+
+	void setup(CRS&& A);
+
+	/// Computes the LU decomposition of the coarsest level's matrix; returns
+	/// false if the matrix is singular.
+	bool decomposeCoarseMatrix();
+
+	/// Approximately solves the system of the given level for its
+	/// right-hand-side work vector.
+	void cycle(std::size_t const level) const;
+
+	AMGOptions const _options;
+	std::vector<Level> _levels;
+
+	/// LU decomposition of the coarsest level's matrix; nullptr if the
+	/// coarsest level is smoothed.
+	std::unique_ptr<DenseMatrix<double, std::size_t>> _coarse_matrix;
+	std::unique_ptr<GaussAlgorithm<DenseMatrix<double, std::size_t>,
+	                               std::vector<double>>> _coarse_solver;
+};
+
+} // end namespace MathLib
+
+#endif /* AMGPRECONDITIONER_H_ */
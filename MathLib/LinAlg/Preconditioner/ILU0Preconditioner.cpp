@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \brief  Implementation of the ILU0Preconditioner class.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "ILU0Preconditioner.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include <logog/include/logog.hpp>
+
+namespace MathLib
+{
+
+namespace
+{
+std::size_t const not_in_row = std::numeric_limits<std::size_t>::max();
+
+/// Sorts the rows by the given levels keeping the order of the rows within a
+/// level.
+void groupByLevel(std::vector<std::size_t> const& level,
+                  std::vector<std::size_t>& levels,
+                  std::vector<std::size_t>& rows)
+{
+	std::size_t const n_levels =
+	    level.empty() ? 0 : *std::max_element(level.begin(), level.end()) + 1;
+	levels.assign(n_levels + 1, 0);
+	for (std::size_t const l : level)
+		levels[l + 1]++;
+	for (std::size_t l = 0; l < n_levels; ++l)
+		levels[l + 1] += levels[l];
+
+	rows.resize(level.size());
+	std::vector<std::size_t> position(levels.begin(), levels.end() - 1);
+	for (std::size_t i = 0; i < level.size(); ++i)
+		rows[position[level[i]]++] = i;
+}
+} // namespace
+
+void ILU0Preconditioner::analyzePattern()
+{
+	std::size_t const n = _row_ptr.size() - 1;
+
+	_diag_pos.resize(n);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		auto const begin = _col_idx.begin() + _row_ptr[i];
+		auto const end = _col_idx.begin() + _row_ptr[i + 1];
+		if (!std::is_sorted(begin, end))
+		{
+			ERR("ILU0Preconditioner: the column indices of row %d are not "
+			    "sorted.", i);
+			std::abort();
+		}
+		auto const diag = std::lower_bound(begin, end, i);
+		if (diag == end || *diag != i)
+		{
+			ERR("ILU0Preconditioner: row %d has no diagonal entry.", i);
+			std::abort();
+		}
+		_diag_pos[i] = diag - _col_idx.begin();
+	}
+
+	// A row depends on the rows of its entries left of the diagonal in the
+	// factorization and the forward substitution, and on the rows of its
+	// entries right of the diagonal in the backward substitution.
+	std::vector<std::size_t> level(n, 0);
+	for (std::size_t i = 0; i < n; ++i)
+		for (std::size_t k = _row_ptr[i]; k < _diag_pos[i]; ++k)
+			level[i] = std::max(level[i], level[_col_idx[k]] + 1);
+	groupByLevel(level, _lower_levels, _lower_rows);
+
+	std::fill(level.begin(), level.end(), 0);
+	for (std::size_t i = n; i-- > 0;)
+		for (std::size_t k = _diag_pos[i] + 1; k < _row_ptr[i + 1]; ++k)
+			level[i] = std::max(level[i], level[_col_idx[k]] + 1);
+	groupByLevel(level, _upper_levels, _upper_rows);
+
+	DBUG("ILU0Preconditioner: %d rows in %d forward and %d backward levels.",
+	     n, getNLowerLevels(), getNUpperLevels());
+}
+
+void ILU0Preconditioner::factorize()
+{
+	std::size_t const n = _row_ptr.size() - 1;
+
+	// Row by row (IKJ) elimination restricted to the pattern; the rows of a
+	// level only read rows of previous levels.
+	#pragma omp parallel
+	{
+		// Position of each column in the current row.
+		std::vector<std::size_t> position(n, not_in_row);
+		for (std::size_t l = 0; l < getNLowerLevels(); ++l)
+		{
+			OPENMP_LOOP_TYPE const begin = _lower_levels[l];
+			OPENMP_LOOP_TYPE const end = _lower_levels[l + 1];
+			#pragma omp for
+			for (OPENMP_LOOP_TYPE p = begin; p < end; p++)
+			{
+				std::size_t const i = _lower_rows[p];
+				for (std::size_t k = _row_ptr[i]; k < _row_ptr[i + 1]; ++k)
+					position[_col_idx[k]] = k;
+
+				for (std::size_t k = _row_ptr[i]; k < _diag_pos[i]; ++k)
+				{
+					std::size_t const j = _col_idx[k];
+					_lu[k] /= _lu[_diag_pos[j]];
+					for (std::size_t m = _diag_pos[j] + 1; m < _row_ptr[j + 1];
+					     ++m)
+					{
+						std::size_t const pos = position[_col_idx[m]];
+						if (pos != not_in_row)
+							_lu[pos] -= _lu[k] * _lu[m];
+					}
+				}
+
+				for (std::size_t k = _row_ptr[i]; k < _row_ptr[i + 1]; ++k)
+					position[_col_idx[k]] = not_in_row;
+			}
+		}
+	}
+
+	for (std::size_t i = 0; i < n; ++i)
+		if (_lu[_diag_pos[i]] == 0.0)
+		{
+			ERR("ILU0Preconditioner: zero pivot in row %d.", i);
+			std::abort();
+		}
+}
+
+void ILU0Preconditioner::apply(double const* const r, double* const z) const
+{
+	std::copy(r, r + _row_ptr.size() - 1, z);
+	precondApply(z);
+}
+
+void ILU0Preconditioner::precondApply(double* const x) const
+{
+	#pragma omp parallel
+	{
+		// Forward substitution with the unit lower triangular factor.
+		for (std::size_t l = 0; l < getNLowerLevels(); ++l)
+		{
+			OPENMP_LOOP_TYPE const begin = _lower_levels[l];
+			OPENMP_LOOP_TYPE const end = _lower_levels[l + 1];
+			#pragma omp for
+			for (OPENMP_LOOP_TYPE p = begin; p < end; p++)
+			{
+				std::size_t const i = _lower_rows[p];
+				double s = x[i];
+				for (std::size_t k = _row_ptr[i]; k < _diag_pos[i]; ++k)
+					s -= _lu[k] * x[_col_idx[k]];
+				x[i] = s;
+			}
+		}
+
+		// Backward substitution with the upper triangular factor.
+		for (std::size_t l = 0; l < getNUpperLevels(); ++l)
+		{
+			OPENMP_LOOP_TYPE const begin = _upper_levels[l];
+			OPENMP_LOOP_TYPE const end = _upper_levels[l + 1];
+			#pragma omp for
+			for (OPENMP_LOOP_TYPE p = begin; p < end; p++)
+			{
+				std::size_t const i = _upper_rows[p];
+				double s = x[i];
+				for (std::size_t k = _diag_pos[i] + 1; k < _row_ptr[i + 1]; ++k)
+					s -= _lu[k] * x[_col_idx[k]];
+				x[i] = s / _lu[_diag_pos[i]];
+			}
+		}
+	}
+}
+
+} // end namespace MathLib
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief  Definition of the ILU0Preconditioner class.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef ILU0PRECONDITIONER_H_
+#define ILU0PRECONDITIONER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace MathLib
+{
+
+/**
+ * Incomplete LU factorization without fill-in, ILU(0), for matrices in
+ * compressed row storage format. The factors \f$ L \f$ (unit lower
+ * triangular) and \f$ U \f$ have the sparsity pattern of the matrix.
+ *
+ * The work is split like in the direct solvers: analyzePattern() finds the
+ * diagonal entries and groups the rows into levels, whose rows do not depend
+ * on each other in the factorization and the forward substitution or in the
+ * backward substitution, respectively. factorize() computes the values of
+ * the factors; it can be called alone for new values of a matrix with the
+ * analyzed pattern, e.g. in each time step. The rows of one level are
+ * processed in parallel if OpenMP is enabled.
+ *
+ * The column indices of each row must be sorted in ascending order and each
+ * row must contain its diagonal entry.
+ */
+class ILU0Preconditioner
+{
+public:
+	/**
+	 * Analyzes the sparsity pattern of the given \f$ n \times n \f$ matrix.
+	 * @param n number of rows / columns
+	 * @param iA row pointer of compressed row storage format
+	 * @param jA column index of compressed row storage format
+	 */
+	template <typename IDX_TYPE>
+	void analyzePattern(std::size_t const n, IDX_TYPE const* const iA,
+	                    IDX_TYPE const* const jA)
+	{
+		_row_ptr.assign(iA, iA + n + 1);
+		_col_idx.assign(jA, jA + iA[n]);
+		analyzePattern();
+	}
+
+	/**
+	 * Computes the factors of a matrix having the pattern given to
+	 * analyzePattern() before.
+	 * @param n number of rows / columns
+	 * @param iA row pointer of compressed row storage format
+	 * @param jA column index of compressed row storage format
+	 * @param A data entries of compressed row storage format
+	 */
+	template <typename IDX_TYPE>
+	void factorize(std::size_t const n, IDX_TYPE const* const iA,
+	               IDX_TYPE const* const jA, double const* const A)
+	{
+		assert(n + 1 == _row_ptr.size());
+		assert(static_cast<std::size_t>(iA[n]) == _col_idx.size());
+		(void)jA;
+		_lu.assign(A, A + iA[n]);
+		factorize();
+	}
+
+	/// Analyzes the pattern and computes the factors of the given matrix.
+	template <typename IDX_TYPE>
+	void compute(std::size_t const n, IDX_TYPE const* const iA,
+	             IDX_TYPE const* const jA, double const* const A)
+	{
+		analyzePattern(n, iA, jA);
+		factorize(n, iA, jA, A);
+	}
+
+	/// Computes \f$ z = (LU)^{-1} r \f$.
+	void apply(double const* const r, double* const z) const;
+
+	/// Applies the preconditioner in place.
+	void precondApply(double* const x) const;
+
+	/// Number of levels of the factorization and the forward substitution.
+	std::size_t getNLowerLevels() const { return _lower_levels.size() - 1; }
+
+	/// Number of levels of the backward substitution.
+	std::size_t getNUpperLevels() const { return _upper_levels.size() - 1; }
+
+private:
+	void analyzePattern();
+	void factorize();
+
+	std::vector<std::size_t> _row_ptr;
+	std::vector<std::size_t> _col_idx;
+	/// Position of the diagonal entry of each row.
+	std::vector<std::size_t> _diag_pos;
+	/// Factors \f$ L \f$ without its unit diagonal and \f$ U \f$ in the
+	/// pattern of the matrix.
+	std::vector<double> _lu;
+
+	/// Rows ordered by their level; a level \c l consists of the rows
+	/// <tt>_lower_rows[_lower_levels[l]]</tt> to
+	/// <tt>_lower_rows[_lower_levels[l+1]-1]</tt>.
+	std::vector<std::size_t> _lower_levels = {0};
+	std::vector<std::size_t> _lower_rows;
+	std::vector<std::size_t> _upper_levels = {0};
+	std::vector<std::size_t> _upper_rows;
+};
+
+} // end namespace MathLib
+
+#endif /* ILU0PRECONDITIONER_H_ */
@@ -10,7 +10,7 @@
 #ifndef ROWCOLUMNINDICES_H_
 #define ROWCOLUMNINDICES_H_
 
-#include <vector>
+#include "MathLib/LinAlg/IndexSpan.h"
 
 namespace MathLib
 {
@@ -18,13 +18,21 @@ namespace MathLib
 template <typename IDX_TYPE>
 struct RowColumnIndices
 {
-	typedef typename std::vector<IDX_TYPE> LineIndex;
-	RowColumnIndices(LineIndex const& rows_, LineIndex const& columns_)
-		: rows(rows_), columns(columns_)
+	/// Non-owning view of the indices; the viewed data, e.g. the rows of a
+	/// local to global index map, must outlive this object.
+	typedef IndexSpan<IDX_TYPE> LineIndex;
+	RowColumnIndices(LineIndex const rows_, LineIndex const columns_,
+		IDX_TYPE const* positions_ = nullptr)
+		: rows(rows_), columns(columns_), positions(positions_)
 	{ }
 
-	LineIndex const& rows;
-	LineIndex const& columns;
+	LineIndex const rows;
+	LineIndex const columns;
+
+	/// Optional positions of the rows x columns block entries (in row-major
+	/// order) in the value storage of the global matrix. If given, matrices
+	/// supporting it add the values directly without searching the entries.
+	IDX_TYPE const* positions;
 };
 
 } // MathLib
@@ -0,0 +1,42 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef MATHLIB_SETFROMCOMPRESSEDROWS_H_
+#define MATHLIB_SETFROMCOMPRESSEDROWS_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace MathLib
+{
+
+/// Replaces the entries of a global matrix by the given compressed rows, in
+/// which each column appears at most once per row. Matrix types supporting
+/// it take over the new structure directly.
+///
+/// Generic variant setting all values to zero and adding the entries one by
+/// one; the matrix keeps its previous structure in addition.
+template <typename MAT_T, typename IndexType>
+void setFromCompressedRows(MAT_T& A, std::vector<IndexType> const& row_offsets,
+                           std::vector<IndexType> const& columns,
+                           std::vector<double> const& values)
+{
+	A.setZero();
+	for (std::size_t r = 0; r + 1 < row_offsets.size(); ++r)
+		for (IndexType k = row_offsets[r]; k < row_offsets[r + 1]; ++k)
+			A.add(r, columns[k], values[k]);
+}
+
+} // MathLib
+
+#ifdef OGS_USE_EIGEN
+#include "MathLib/LinAlg/Eigen/EigenTools.h"
+#endif // OGS_USE_EIGEN
+
+#endif  // MATHLIB_SETFROMCOMPRESSEDROWS_H_
@@ -16,6 +16,8 @@
 
 #include "MathTools.h"
 #include "blas.h"
+#include "LinearOperatorSolvers.h"
+#include "../Sparse/CRSMatrixOpenMPOperator.h"
 
 namespace MathLib {
 
@@ -146,4 +148,12 @@ unsigned BiCGStab(CRSMatrix<double, unsigned> const& A, double* const b, double*
 	return 1;
 }
 
+#ifdef _OPENMP
+unsigned BiCGStabParallel(CRSMatrix<double, unsigned> const& A, double const* const b,
+		double* const x, double& eps, unsigned& nsteps)
+{
+	return BiCGStab(CRSMatrixOpenMPOperator(A), b, x, eps, nsteps);
+}
+#endif
+
 } // end namespace MathLib
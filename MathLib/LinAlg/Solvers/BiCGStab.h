@@ -24,6 +24,13 @@ namespace MathLib {
 unsigned BiCGStab(CRSMatrix<double, unsigned> const& A, double* const b, double* const x,
                   double& eps, unsigned& nsteps);
 
+#ifdef _OPENMP
+/// OpenMP parallel BiCGStab with OpenMP parallel matrix vector
+/// multiplication, see the BiCGStab() template for linear operators.
+unsigned BiCGStabParallel(CRSMatrix<double, unsigned> const& A, double const* const b,
+                  double* const x, double& eps, unsigned& nsteps);
+#endif
+
 } // end namespace MathLib
 
 #endif /* BICGSTAB_H_ */
@@ -16,6 +16,7 @@
 
 #include "MathTools.h"
 #include "blas.h"
+#include "LinearOperatorSolvers.h"
 #include "../Sparse/CRSMatrix.h"
 #include "../Sparse/CRSMatrixDiagPrecond.h"
 
@@ -118,4 +119,10 @@ unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
 	return 1;
 }
 
+unsigned PipelinedCG(CRSMatrix<double,unsigned> const * mat, double const * const b,
+		double* const x, double& eps, unsigned& nsteps)
+{
+	return PipelinedCG(*mat, b, x, eps, nsteps);
+}
+
 } // end namespace MathLib
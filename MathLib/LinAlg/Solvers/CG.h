@@ -23,6 +23,11 @@ template <typename PF_TYPE, typename IDX_TYPE> class CRSMatrix;
 unsigned CG(CRSMatrix<double,unsigned> const * mat, double const * const b,
 		double* const x, double& eps, unsigned& nsteps);
 
+/// Pipelined variant of CG() with fused vector operations, see the
+/// PipelinedCG() template for linear operators.
+unsigned PipelinedCG(CRSMatrix<double,unsigned> const * mat, double const * const b,
+		double* const x, double& eps, unsigned& nsteps);
+
 #ifdef _OPENMP
 unsigned CGParallel(CRSMatrix<double,unsigned> const * mat, double const * const b,
 		double* const x, double& eps, unsigned& nsteps);
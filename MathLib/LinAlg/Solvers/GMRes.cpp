@@ -17,6 +17,8 @@
 #include <cmath>
 #include <limits>
 #include "blas.h"
+#include "LinearOperatorSolvers.h"
+#include "../Sparse/CRSMatrixOpenMPOperator.h"
 
 namespace MathLib {
 
@@ -171,4 +173,13 @@ unsigned GMRes(const CRSMatrix<double,unsigned>& A, double* const b, double* con
 	return 1;
 }
 
+#ifdef _OPENMP
+unsigned GMResParallel(const CRSMatrix<double,unsigned>& A, double const* const b,
+		double* const x, double& eps, unsigned m, unsigned& nsteps,
+		bool tune_restart)
+{
+	return GMRes(CRSMatrixOpenMPOperator(A), b, x, eps, m, nsteps, tune_restart);
+}
+#endif
+
 } // end namespace MathLib
@@ -22,6 +22,15 @@ namespace MathLib {
 unsigned GMRes(const CRSMatrix<double,unsigned>& mat, double* const b, double* const x,
                         double& eps, unsigned m, unsigned& steps);
 
+#ifdef _OPENMP
+/// OpenMP parallel GMRes with OpenMP parallel matrix vector multiplication,
+/// see the GMRes() template for linear operators. If tune_restart is set, the
+/// restart length varies between one and m.
+unsigned GMResParallel(const CRSMatrix<double,unsigned>& mat, double const* const b,
+                        double* const x, double& eps, unsigned m, unsigned& steps,
+                        bool tune_restart = false);
+#endif
+
 } // end namespace MathLib
 
 #endif /* GMRES_H_ */
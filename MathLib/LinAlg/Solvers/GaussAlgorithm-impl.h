@@ -96,6 +96,13 @@ void GaussAlgorithm<MAT_T, VEC_T>::solve (VEC_T const& b, VEC_T & x,
 	solve(x, decompose);
 }
 
+template <typename MAT_T, typename VEC_T>
+void GaussAlgorithm<MAT_T, VEC_T>::solve (VEC_T const& b, VEC_T & x,
+	LinearSolverBehaviour behaviour)
+{
+	solve(b, x, behaviour != LinearSolverBehaviour::REUSE);
+}
+
 template <typename MAT_T, typename VEC_T>
 template <typename V>
 void GaussAlgorithm<MAT_T, VEC_T>::permuteRHS (V & b) const
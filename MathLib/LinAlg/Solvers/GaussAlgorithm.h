@@ -20,6 +20,7 @@
 
 #include "BaseLib/ConfigTree.h"
 #include "../Dense/DenseMatrix.h"
+#include "../LinAlgEnums.h"
 #include "TriangularSolve.h"
 
 namespace MathLib {
@@ -83,6 +84,13 @@ public:
 	 */
 	void solve(VEC_T const& b, VEC_T & x, bool decompose = true);
 
+	/**
+	 * Same as solve(b, x, decompose) with the common interface of the
+	 * linear solvers; LinearSolverBehaviour::REUSE skips the LU
+	 * decomposition of the unchanged matrix.
+	 */
+	void solve(VEC_T const& b, VEC_T & x, LinearSolverBehaviour behaviour);
+
 private:
 	void performLU();
 	/**
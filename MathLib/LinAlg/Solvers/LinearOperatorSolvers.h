@@ -0,0 +1,636 @@
+/**
+ * \brief  Preconditioned CG, BiCGStab, and GMRes methods for linear operators
+ *         given without an explicit matrix.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef LINEAROPERATORSOLVERS_H_
+#define LINEAROPERATORSOLVERS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace MathLib
+{
+
+namespace detail
+{
+/// x * y
+inline double dot(std::size_t const n, double const* const x,
+				  double const* const y)
+{
+	double s = 0.0;
+	OPENMP_LOOP_TYPE const n_ = n;
+	#pragma omp parallel for reduction(+:s)
+	for (OPENMP_LOOP_TYPE i = 0; i < n_; i++)
+		s += x[i] * y[i];
+	return s;
+}
+
+/// y += a x
+inline void axpy(std::size_t const n, double const a, double const* const x,
+				 double* const y)
+{
+	OPENMP_LOOP_TYPE const n_ = n;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE i = 0; i < n_; i++)
+		y[i] += a * x[i];
+}
+
+/// y = x
+inline void copy(std::size_t const n, double const* const x, double* const y)
+{
+	OPENMP_LOOP_TYPE const n_ = n;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE i = 0; i < n_; i++)
+		y[i] = x[i];
+}
+
+/// r = b - A x
+template <typename LinearOperator>
+void residual(LinearOperator const& A, double const* const b,
+			  double const* const x, double* const r)
+{
+	std::size_t const n = A.getNRows();
+	A.amux(-1.0, x, r);
+	axpy(n, 1.0, b, r);
+}
+
+/// Orthogonalizes \c w against the \c k orthonormal columns of the n x k
+/// matrix \c V (column major) by classical Gram-Schmidt with one
+/// reorthogonalization, and stores the coefficients \f$ V^T w \f$ in \c h.
+///
+/// Each pass computes all k inner products in one sweep with a single
+/// reduction, and subtracts all projections in a second sweep. The static
+/// schedule assigns each thread the same rows of \c w in all loops, such
+/// that the threads work on their own part of \c w between the barriers.
+inline void orthogonalize(std::size_t const n, std::size_t const k,
+						  double const* const V, double* const w,
+						  double* const h)
+{
+	std::fill_n(h, k, 0.0);
+	std::vector<double> c(k);
+	OPENMP_LOOP_TYPE const n_ = n;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		std::fill(c.begin(), c.end(), 0.0);
+		#pragma omp parallel
+		{
+			// c = V^T w
+			std::vector<double> c_thread(k);
+			for (std::size_t j = 0; j < k; ++j)
+			{
+				double const* const v = V + j * n;
+				double s = 0.0;
+				#pragma omp for schedule(static) nowait
+				for (OPENMP_LOOP_TYPE i = 0; i < n_; i++)
+					s += v[i] * w[i];
+				c_thread[j] = s;
+			}
+			#pragma omp critical
+			for (std::size_t j = 0; j < k; ++j)
+				c[j] += c_thread[j];
+			#pragma omp barrier
+
+			// w -= V c
+			for (std::size_t j = 0; j < k; ++j)
+			{
+				double const* const v = V + j * n;
+				double const c_j = c[j];
+				#pragma omp for schedule(static) nowait
+				for (OPENMP_LOOP_TYPE i = 0; i < n_; i++)
+					w[i] -= c_j * v[i];
+			}
+		}
+		for (std::size_t j = 0; j < k; ++j)
+			h[j] += c[j];
+	}
+}
+
+/// Computes the Givens rotation (cs, sn) which eliminates dy in (dx, dy).
+inline void generatePlaneRotation(double const dx, double const dy,
+								  double& cs, double& sn)
+{
+	if (dy == 0.0)
+	{
+		cs = 1.0;
+		sn = 0.0;
+	}
+	else if (std::abs(dy) > std::abs(dx))
+	{
+		double const t = dx / dy;
+		sn = 1.0 / std::sqrt(1.0 + t * t);
+		cs = t * sn;
+	}
+	else
+	{
+		double const t = dy / dx;
+		cs = 1.0 / std::sqrt(1.0 + t * t);
+		sn = t * cs;
+	}
+}
+
+inline void applyPlaneRotation(double& dx, double& dy, double const cs,
+							   double const sn)
+{
+	double const t = cs * dx + sn * dy;
+	dy = cs * dy - sn * dx;
+	dx = t;
+}
+
+/// Solves the upper triangular k x k system H y = s and adds C V y to x; z is
+/// a work vector of length n.
+template <typename LinearOperator>
+void updateGMResSolution(LinearOperator const& A, std::size_t const k,
+						 double const* const H, std::size_t const ldH,
+						 double const* const s, double const* const V,
+						 double* const z, double* const x)
+{
+	std::vector<double> y(s, s + k);
+	for (std::size_t i = k; i-- > 0;)
+	{
+		for (std::size_t j = i + 1; j < k; ++j)
+			y[i] -= H[i + j * ldH] * y[j];
+		y[i] /= H[i + i * ldH];
+	}
+
+	// z = V y
+	std::size_t const n = A.getNRows();
+	OPENMP_LOOP_TYPE const n_ = n;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE i = 0; i < n_; i++)
+	{
+		double t = 0.0;
+		for (std::size_t j = 0; j < k; ++j)
+			t += V[i + j * n] * y[j];
+		z[i] = t;
+	}
+
+	A.precondApply(z);
+	axpy(n, 1.0, z, x);
+}
+
+/// Restart length of the next GMRes cycle after Baker, Jessup, and Kolev,
+/// "A simple strategy for varying the restart parameter in GMRES(m)", 2009:
+/// the cycle is restarted with the maximal length \c m_max if the residual
+/// stagnated, is kept if the residual dropped fast, and is shortened by three
+/// otherwise, starting over at \c m_max when it would drop below one.
+inline unsigned nextRestartLength(double const convergence_factor,
+								  unsigned const m, unsigned const m_max)
+{
+	double const stagnation = 0.99;  // cos(8 degrees)
+	double const fast = 0.17;        // cos(80 degrees)
+	unsigned const decrement = 3;
+
+	if (convergence_factor > stagnation)
+		return m_max;
+	if (convergence_factor < fast)
+		return m;
+	return m > decrement ? m - decrement : m_max;
+}
+}  // namespace detail
+
+/// Preconditioned conjugate gradient method for symmetric positive definite
+/// operators and preconditioners.
+///
+/// The solver accesses the linear operator \c A through the same functions as
+/// the CRSMatrix based CG() and BiCGStab():
+///  - \c A.getNRows() returns the number of unknowns,
+///  - \c A.amux(d, x, y) computes \f$ y = d A x \f$, overwriting \c y,
+///  - \c A.precondApply(x) applies the preconditioner in place.
+///
+/// The return value is 0 if the relative residual \f$ |b - A x| / |b| \f$ has
+/// dropped below \c eps within \c nsteps iterations, and 1 if not. On return
+/// \c eps holds the achieved relative residual and \c nsteps the number of
+/// iterations performed.
+template <typename LinearOperator>
+unsigned CG(LinearOperator const& A, double const* const b, double* const x,
+			double& eps, unsigned& nsteps)
+{
+	std::size_t const n = A.getNRows();
+
+	double const nrmb = std::sqrt(detail::dot(n, b, b));
+	if (nrmb < std::numeric_limits<double>::epsilon())
+	{
+		std::fill_n(x, n, 0.0);
+		eps = 0.0;
+		nsteps = 0;
+		return 0;
+	}
+
+	std::vector<double> r(n), z(n), p(n), q(n);
+
+	detail::residual(A, b, x, r.data());
+	double resid = std::sqrt(detail::dot(n, r.data(), r.data()));
+	if (resid <= eps * nrmb)
+	{
+		eps = resid / nrmb;
+		nsteps = 0;
+		return 0;
+	}
+
+	double rho_prev = 0.0;
+	for (unsigned l = 1; l <= nsteps; ++l)
+	{
+		// z = C r
+		std::copy(r.cbegin(), r.cend(), z.begin());
+		A.precondApply(z.data());
+
+		double const rho = detail::dot(n, r.data(), z.data());
+		if (l == 1)
+		{
+			std::copy(z.cbegin(), z.cend(), p.begin());
+		}
+		else
+		{
+			// p = z + beta p
+			double const beta = rho / rho_prev;
+			for (std::size_t k = 0; k < n; ++k)
+				p[k] = z[k] + beta * p[k];
+		}
+
+		// q = A p
+		A.amux(1.0, p.data(), q.data());
+
+		double const alpha = rho / detail::dot(n, p.data(), q.data());
+		detail::axpy(n, alpha, p.data(), x);
+		detail::axpy(n, -alpha, q.data(), r.data());
+
+		resid = std::sqrt(detail::dot(n, r.data(), r.data()));
+		if (resid <= eps * nrmb)
+		{
+			eps = resid / nrmb;
+			nsteps = l;
+			return 0;
+		}
+
+		rho_prev = rho;
+	}
+
+	eps = resid / nrmb;
+	return 1;
+}
+
+/// Pipelined preconditioned conjugate gradient method of Ghysels and
+/// Vanroose for symmetric positive definite operators and preconditioners.
+/// The arguments and the return value are the same as of CG().
+///
+/// Mathematically equivalent to CG(), but the preconditioned residual
+/// \f$ u = C r \f$ and \f$ w = A u \f$ are updated by recurrences. Thereby
+/// all vector updates and the three inner products \f$ (r, u) \f$,
+/// \f$ (w, u) \f$, and \f$ (r, r) \f$ of an iteration are done in a single
+/// pass over the vectors, instead of the separate passes of CG(), and there
+/// is one global reduction per iteration. The inner products are needed only
+/// after the next preconditioner and operator applications; a distributed
+/// version can overlap their reduction with these.
+///
+/// The recurrences let the residual drift from \f$ b - A x \f$ by some
+/// orders of the machine precision times the condition number.
+template <typename LinearOperator>
+unsigned PipelinedCG(LinearOperator const& A, double const* const b,
+					 double* const x, double& eps, unsigned& nsteps)
+{
+	std::size_t const n = A.getNRows();
+
+	double const nrmb = std::sqrt(detail::dot(n, b, b));
+	if (nrmb < std::numeric_limits<double>::epsilon())
+	{
+		std::fill_n(x, n, 0.0);
+		eps = 0.0;
+		nsteps = 0;
+		return 0;
+	}
+
+	// r = b - A x, u = C r, w = A u, m = C w, am = A m, and the search
+	// directions p and s = A p, q = C s, z = A q.
+	std::vector<double> r(n), u(n), w(n), m(n), am(n);
+	std::vector<double> p(n, 0.0), s(n, 0.0), q(n, 0.0), z(n, 0.0);
+
+	detail::residual(A, b, x, r.data());
+	std::copy(r.cbegin(), r.cend(), u.begin());
+	A.precondApply(u.data());
+	A.amux(1.0, u.data(), w.data());
+
+	double gamma = detail::dot(n, r.data(), u.data());
+	double delta = detail::dot(n, w.data(), u.data());
+	double resid = std::sqrt(detail::dot(n, r.data(), r.data()));
+	if (resid <= eps * nrmb)
+	{
+		eps = resid / nrmb;
+		nsteps = 0;
+		return 0;
+	}
+
+	std::copy(w.cbegin(), w.cend(), m.begin());
+	A.precondApply(m.data());
+	A.amux(1.0, m.data(), am.data());
+
+	double gamma_prev = 0.0;
+	double alpha = 0.0;
+	for (unsigned l = 1; l <= nsteps; ++l)
+	{
+		double const beta = l > 1 ? gamma / gamma_prev : 0.0;
+		alpha = l > 1 ? gamma / (delta - beta * gamma / alpha)
+		              : gamma / delta;
+
+		// The fused updates; m is prepared for the in-place preconditioner.
+		double rr = 0.0;
+		gamma_prev = gamma;
+		gamma = 0.0;
+		delta = 0.0;
+		OPENMP_LOOP_TYPE const n_ = n;
+		#pragma omp parallel for reduction(+:rr, gamma, delta)
+		for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+		{
+			z[k] = am[k] + beta * z[k];
+			q[k] = m[k] + beta * q[k];
+			s[k] = w[k] + beta * s[k];
+			p[k] = u[k] + beta * p[k];
+			x[k] += alpha * p[k];
+			r[k] -= alpha * s[k];
+			u[k] -= alpha * q[k];
+			w[k] -= alpha * z[k];
+			m[k] = w[k];
+			rr += r[k] * r[k];
+			gamma += r[k] * u[k];
+			delta += w[k] * u[k];
+		}
+
+		// A distributed version starts the reduction of rr, gamma, and
+		// delta here and completes it after the following two lines.
+		A.precondApply(m.data());
+		A.amux(1.0, m.data(), am.data());
+
+		resid = std::sqrt(rr);
+		if (resid <= eps * nrmb)
+		{
+			eps = resid / nrmb;
+			nsteps = l;
+			return 0;
+		}
+	}
+
+	eps = resid / nrmb;
+	return 1;
+}
+
+/// Right-preconditioned BiCGStab method for general operators; the operator
+/// is accessed as in CG(). The return value is 0 on convergence, 1 if the
+/// maximal number of iterations is reached, and 2 or 3 on a breakdown.
+///
+/// The vector updates are OpenMP parallel and fused with the inner products
+/// computed from their results.
+template <typename LinearOperator>
+unsigned BiCGStab(LinearOperator const& A, double const* const b,
+				  double* const x, double& eps, unsigned& nsteps)
+{
+	std::size_t const n = A.getNRows();
+	OPENMP_LOOP_TYPE const n_ = n;
+	double const breakdown = std::numeric_limits<double>::epsilon();
+
+	double nrmb = std::sqrt(detail::dot(n, b, b));
+	if (nrmb < breakdown)
+		nrmb = 1.0;
+
+	std::vector<double> r(n), r0(n), p(n), phat(n), v(n), s(n), shat(n), t(n);
+
+	detail::residual(A, b, x, r.data());
+	detail::copy(n, r.data(), r0.data());
+
+	double resid = std::sqrt(detail::dot(n, r.data(), r.data())) / nrmb;
+	if (resid < eps)
+	{
+		eps = resid;
+		nsteps = 0;
+		return 0;
+	}
+
+	double alpha = 0.0, omega = 0.0, rho_prev = 0.0;
+	for (unsigned l = 1; l <= nsteps; ++l)
+	{
+		double const rho = detail::dot(n, r0.data(), r.data());
+		if (std::abs(rho) < breakdown)
+		{
+			eps = resid;
+			nsteps = l;
+			return 2;
+		}
+
+		if (l == 1)
+		{
+			detail::copy(n, r.data(), p.data());
+		}
+		else
+		{
+			// p = r + beta (p - omega v)
+			double const beta = (rho / rho_prev) * (alpha / omega);
+			#pragma omp parallel for
+			for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+				p[k] = r[k] + beta * (p[k] - omega * v[k]);
+		}
+
+		// v = A C p
+		detail::copy(n, p.data(), phat.data());
+		A.precondApply(phat.data());
+		A.amux(1.0, phat.data(), v.data());
+
+		alpha = rho / detail::dot(n, r0.data(), v.data());
+
+		// s = r - alpha v
+		double ss = 0.0;
+		#pragma omp parallel for reduction(+:ss)
+		for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+		{
+			s[k] = r[k] - alpha * v[k];
+			ss += s[k] * s[k];
+		}
+
+		resid = std::sqrt(ss) / nrmb;
+		if (resid < eps)
+		{
+			detail::axpy(n, alpha, phat.data(), x);
+			eps = resid;
+			nsteps = l;
+			return 0;
+		}
+
+		// t = A C s
+		detail::copy(n, s.data(), shat.data());
+		A.precondApply(shat.data());
+		A.amux(1.0, shat.data(), t.data());
+
+		double ts = 0.0, tt = 0.0;
+		#pragma omp parallel for reduction(+:ts, tt)
+		for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+		{
+			ts += t[k] * s[k];
+			tt += t[k] * t[k];
+		}
+		omega = ts / tt;
+
+		// x += alpha C p + omega C s, r = s - omega t
+		double rr = 0.0;
+		#pragma omp parallel for reduction(+:rr)
+		for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+		{
+			x[k] += alpha * phat[k] + omega * shat[k];
+			r[k] = s[k] - omega * t[k];
+			rr += r[k] * r[k];
+		}
+
+		resid = std::sqrt(rr) / nrmb;
+		if (resid < eps)
+		{
+			eps = resid;
+			nsteps = l;
+			return 0;
+		}
+
+		if (std::abs(omega) < breakdown)
+		{
+			eps = resid;
+			nsteps = l;
+			return 3;
+		}
+		rho_prev = rho;
+	}
+
+	eps = resid;
+	return 1;
+}
+
+/// Restarted right-preconditioned GMRes method for general operators; the
+/// operator is accessed as in CG(). At most \c nsteps iterations are done in
+/// cycles of at most \c m iterations. The return value is 0 on convergence
+/// and 1 if the maximal number of iterations is reached.
+///
+/// The Krylov basis is orthogonalized by classical Gram-Schmidt with
+/// reorthogonalization, see detail::orthogonalize(). It needs twice the
+/// operations of the modified Gram-Schmidt method of the CRSMatrix based
+/// GMRes(), but only two reductions per iteration instead of one per basis
+/// vector, and is as stable as the modified method.
+///
+/// If \c tune_restart is set, the length of each cycle is chosen between one
+/// and \c m from the residual reduction of the previous cycle, see
+/// detail::nextRestartLength(). Shorter cycles save orthogonalization work
+/// while the residual decreases well.
+template <typename LinearOperator>
+unsigned GMRes(LinearOperator const& A, double const* const b,
+			   double* const x, double& eps, unsigned const m,
+			   unsigned& nsteps, bool const tune_restart = false)
+{
+	std::size_t const n = A.getNRows();
+
+	double const nrmb = std::sqrt(detail::dot(n, b, b));
+	if (nrmb < std::numeric_limits<double>::epsilon())
+	{
+		std::fill_n(x, n, 0.0);
+		eps = 0.0;
+		nsteps = 0;
+		return 0;
+	}
+
+	// The basis V (n x (m + 1)), the Hessenberg matrix H ((m + 1) x m) which
+	// is reduced to upper triangular form by the Givens rotations (cs, sn),
+	// and the rotated right hand side s of the least squares problem.
+	unsigned const m_max = std::max(m, 1u);
+	std::size_t const ldH = m_max + 1;
+	std::vector<double> r(n), z(n), V(n * ldH), H(ldH * m_max);
+	std::vector<double> cs(m_max), sn(m_max), s(m_max + 1);
+
+	detail::residual(A, b, x, r.data());
+	double beta = std::sqrt(detail::dot(n, r.data(), r.data()));
+	double resid = beta / nrmb;
+	if (resid <= eps)
+	{
+		eps = resid;
+		nsteps = 0;
+		return 0;
+	}
+
+	OPENMP_LOOP_TYPE const n_ = n;
+	unsigned restart = m_max;
+	unsigned j = 0;
+	while (j < nsteps)
+	{
+		// v_0 = r / |r|
+		double const scale_r = 1.0 / beta;
+		#pragma omp parallel for
+		for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+			V[k] = scale_r * r[k];
+		s[0] = beta;
+		std::fill(s.begin() + 1, s.end(), 0.0);
+
+		unsigned i = 0;
+		while (i < restart && j < nsteps)
+		{
+			// v_{i+1} = A C v_i, orthonormalized against v_0, ..., v_i
+			double* const v = V.data() + (i + 1) * n;
+			detail::copy(n, V.data() + i * n, z.data());
+			A.precondApply(z.data());
+			A.amux(1.0, z.data(), v);
+
+			double* const h = H.data() + i * ldH;
+			detail::orthogonalize(n, i + 1, V.data(), v, h);
+			h[i + 1] = std::sqrt(detail::dot(n, v, v));
+			if (h[i + 1] > 0.0)
+			{
+				double const scale_v = 1.0 / h[i + 1];
+				#pragma omp parallel for
+				for (OPENMP_LOOP_TYPE k = 0; k < n_; k++)
+					v[k] *= scale_v;
+			}
+
+			for (std::size_t k = 0; k < i; ++k)
+				detail::applyPlaneRotation(h[k], h[k + 1], cs[k], sn[k]);
+			detail::generatePlaneRotation(h[i], h[i + 1], cs[i], sn[i]);
+			detail::applyPlaneRotation(h[i], h[i + 1], cs[i], sn[i]);
+			detail::applyPlaneRotation(s[i], s[i + 1], cs[i], sn[i]);
+
+			++i;
+			++j;
+			resid = std::abs(s[i]) / nrmb;
+			if (resid <= eps)
+				break;
+		}
+
+		detail::updateGMResSolution(A, i, H.data(), ldH, s.data(), V.data(),
+									z.data(), x);
+		if (resid <= eps)
+		{
+			eps = resid;
+			nsteps = j;
+			return 0;
+		}
+
+		detail::residual(A, b, x, r.data());
+		double const beta_prev = beta;
+		beta = std::sqrt(detail::dot(n, r.data(), r.data()));
+		resid = beta / nrmb;
+		if (resid <= eps)
+		{
+			eps = resid;
+			nsteps = j;
+			return 0;
+		}
+
+		if (tune_restart)
+			restart = detail::nextRestartLength(beta / beta_prev, restart,
+												m_max);
+	}
+
+	eps = resid;
+	return 1;
+}
+
+}  // namespace MathLib
+
+#endif  // LINEAROPERATORSOLVERS_H_
@@ -23,6 +23,7 @@
 // MathLib
 #include "SparseMatrixBase.h"
 #include "MatrixSparsityPattern.h"
+#include "MathLib/LinAlg/CompressedSparsityPattern.h"
 #include "sparse.h"
 #include "amuxCRS.h"
 #include "../Preconditioner/generateDiagPrecond.h"
@@ -85,6 +86,24 @@ public:
 		setZero();
 	}
 
+	explicit CRSMatrix(CompressedSparsityPattern<IDX_TYPE> const& sparsity_pattern) :
+			SparseMatrixBase<FP_TYPE, IDX_TYPE>(sparsity_pattern.size(),
+					sparsity_pattern.size()),
+			_row_ptr(nullptr), _col_idx(nullptr), _data(nullptr)
+	{
+		_row_ptr = new IDX_TYPE [this->_n_rows + 1];
+		std::copy(sparsity_pattern.row_ptr.cbegin(),
+			sparsity_pattern.row_ptr.cend(), _row_ptr);
+
+		std::size_t const nnz = _row_ptr[this->_n_rows];
+		_col_idx = new IDX_TYPE [nnz];
+		std::copy(sparsity_pattern.col_idx.cbegin(),
+			sparsity_pattern.col_idx.cend(), _col_idx);
+
+		_data = new FP_TYPE [nnz];
+		setZero();
+	}
+
 	/// Reset data entries to zero.
 	virtual void setZero()
 	{
@@ -0,0 +1,77 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CRSMATRIXAMGPRECOND_H
+#define CRSMATRIXAMGPRECOND_H
+
+#include <string>
+
+#include "CRSMatrix.h"
+#include "../Preconditioner/AMGPreconditioner.h"
+
+namespace MathLib {
+
+/**
+ * Class CRSMatrixAMGPrecond represents a matrix in compressed row storage
+ * format associated with an algebraic multigrid preconditioner, see
+ * AMGPreconditioner. It is used like the CRSMatrixDiagPrecond, e.g. by CG().
+ *
+ * The user has to compute the preconditioner explicitly via calcPrecond();
+ * the hierarchy is kept until the next call of calcPrecond().
+ */
+class CRSMatrixAMGPrecond : public CRSMatrix<double, unsigned>
+{
+public:
+	/**
+	 * Constructor takes a file name. The file is read in binary format
+	 * by the constructor of the base class (template) CRSMatrix.
+	 *
+	 * @param fname the name of the file that contains the matrix in
+	 * binary compressed row storage format
+	 * @param options settings of the multigrid hierarchy
+	 */
+	explicit CRSMatrixAMGPrecond(std::string const &fname,
+		AMGOptions const& options = AMGOptions()) :
+		CRSMatrix<double, unsigned> (fname), _amg(options)
+	{}
+
+	/**
+	 * Constructs a matrix object from given data.
+	 *
+	 * @param n number of rows / columns of the matrix
+	 * @param iA row pointer of matrix in compressed row storage format
+	 * @param jA column index of matrix in compressed row storage format
+	 * @param A data entries of matrix in compressed row storage format
+	 * @param options settings of the multigrid hierarchy
+	 */
+	CRSMatrixAMGPrecond(unsigned n, unsigned *iA, unsigned *jA, double* A,
+		AMGOptions const& options = AMGOptions()) :
+		CRSMatrix<double, unsigned> (n, iA, jA, A), _amg(options)
+	{}
+
+	void calcPrecond()
+	{
+		_amg.compute(_n_rows, _row_ptr, _col_idx, _data);
+	}
+
+	void precondApply(double* x) const
+	{
+		_amg.precondApply(x);
+	}
+
+	/// The multigrid hierarchy computed by calcPrecond().
+	AMGPreconditioner const& getPreconditioner() const { return _amg; }
+
+private:
+	AMGPreconditioner _amg;
+};
+
+}
+
+#endif
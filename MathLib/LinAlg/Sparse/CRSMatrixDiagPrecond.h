@@ -68,7 +68,9 @@ public:
 
 	void precondApply(double* x) const
 	{
-		for (unsigned k=0; k<_n_rows; ++k) {
+		OPENMP_LOOP_TYPE const n_rows = _n_rows;
+		#pragma omp parallel for
+		for (OPENMP_LOOP_TYPE k = 0; k < n_rows; k++) {
 			x[k] = _inv_diag[k]*x[k];
 		}
 	}
@@ -33,6 +33,11 @@ public:
 		CRSMatrix<FP_TYPE, IDX_TYPE>(n, iA, jA, A)
 	{}
 
+	explicit CRSMatrixOpenMP(
+		CompressedSparsityPattern<IDX_TYPE> const& sparsity_pattern) :
+		CRSMatrix<FP_TYPE, IDX_TYPE>(sparsity_pattern)
+	{}
+
 	CRSMatrixOpenMP(unsigned n1) :
 		CRSMatrix<FP_TYPE, IDX_TYPE>(n1)
 	{}
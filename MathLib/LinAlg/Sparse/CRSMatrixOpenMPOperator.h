@@ -0,0 +1,50 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CRSMATRIXOPENMPOPERATOR_H_
+#define CRSMATRIXOPENMPOPERATOR_H_
+
+#ifdef _OPENMP
+#include "CRSMatrix.h"
+#include "amuxCRS.h"
+
+namespace MathLib {
+
+/**
+ * Linear operator view of a CRSMatrix for the solvers in
+ * LinearOperatorSolvers.h. The matrix vector multiplication is OpenMP
+ * parallel independently of the type of the matrix, the preconditioner is the
+ * one of the matrix.
+ */
+class CRSMatrixOpenMPOperator
+{
+public:
+	explicit CRSMatrixOpenMPOperator(CRSMatrix<double, unsigned> const& A) :
+		_A(A)
+	{}
+
+	unsigned getNRows() const { return _A.getNRows(); }
+
+	void amux(double const d, double const* const x, double* const y) const
+	{
+		amuxCRSParallelOpenMP(d, _A.getNRows(), _A.getRowPtrArray(),
+			_A.getColIdxArray(), _A.getEntryArray(), x, y);
+	}
+
+	void precondApply(double* const x) const { _A.precondApply(x); }
+
+private:
+	CRSMatrix<double, unsigned> const& _A;
+};
+
+} // end namespace MathLib
+
+#endif // _OPENMP
+
+#endif /* CRSMATRIXOPENMPOPERATOR_H_ */
@@ -0,0 +1,81 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef CRSMATRIXSELL_H
+#define CRSMATRIXSELL_H
+
+#include <memory>
+#include <string>
+
+#include "CRSMatrix.h"
+#include "SELLMatrix.h"
+
+namespace MathLib {
+
+/**
+ * Class CRSMatrixSELL represents a matrix in compressed row storage format
+ * whose matrix vector multiplication uses a copy in SELL-C-sigma format, see
+ * SELLMatrix. It can be used by the solvers instead of the CRSMatrix, e.g.
+ * by CG(), BiCGStab(), or GMRes().
+ *
+ * The copy is made by the constructors; the user has to call convertToSELL()
+ * after changing the matrix entries.
+ */
+class CRSMatrixSELL : public CRSMatrix<double, unsigned>
+{
+public:
+	/**
+	 * Constructor takes a file name. The file is read in binary format
+	 * by the constructor of the base class (template) CRSMatrix.
+	 *
+	 * @param fname the name of the file that contains the matrix in
+	 * binary compressed row storage format
+	 */
+	explicit CRSMatrixSELL(std::string const &fname) :
+		CRSMatrix<double, unsigned> (fname)
+	{
+		convertToSELL();
+	}
+
+	/**
+	 * Constructs a matrix object from given data.
+	 *
+	 * @param n number of rows / columns of the matrix
+	 * @param iA row pointer of matrix in compressed row storage format
+	 * @param jA column index of matrix in compressed row storage format
+	 * @param A data entries of matrix in compressed row storage format
+	 */
+	CRSMatrixSELL(unsigned n, unsigned *iA, unsigned *jA, double* A) :
+		CRSMatrix<double, unsigned> (n, iA, jA, A)
+	{
+		convertToSELL();
+	}
+
+	/// Copies the current entries to the SELL-C-sigma format.
+	void convertToSELL()
+	{
+		_sell.reset(new SELLMatrix(_n_rows, _row_ptr, _col_idx, _data));
+	}
+
+	virtual void amux(double const d, double const* const __restrict__ x,
+	                  double* __restrict__ y) const
+	{
+		_sell->amux(d, x, y);
+	}
+
+	SELLMatrix const& getSELLMatrix() const { return *_sell; }
+	SELLMatrix& getSELLMatrix() { return *_sell; }
+
+private:
+	std::unique_ptr<SELLMatrix> _sell;
+};
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+/**
+ * \file
+ * \brief  Implementation of the SELLMatrix class.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "SELLMatrix.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+
+#include <logog/include/logog.hpp>
+
+// The AVX kernels are compiled for their instruction sets by function
+// attributes and selected at run time, such that the library runs on any
+// x86-64 processor.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define SELL_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace MathLib
+{
+
+std::size_t const SELLMatrix::chunk_size;
+
+namespace
+{
+std::size_t const C = SELLMatrix::chunk_size;
+
+/// The arrays of a SELLMatrix read by the kernels.
+struct SELLArrays
+{
+	std::size_t n_rows;
+	std::size_t n_chunks;
+	std::size_t const* perm;
+	std::size_t const* chunk_ptr;
+	std::int32_t const* col_idx;
+	double const* data;
+};
+
+/// Writes the scaled sums of a chunk's rows to their original positions.
+inline void storeChunk(SELLArrays const& m, std::size_t const c,
+                       double const d, double const* const sum,
+                       double* const y)
+{
+	std::size_t const first = c * C;
+	std::size_t const last = std::min(first + C, m.n_rows);
+	for (std::size_t k = first; k < last; ++k)
+		y[m.perm[k]] = d * sum[k - first];
+}
+
+void amuxScalar(SELLArrays const& m, double const d, double const* const x,
+                double* const y)
+{
+	OPENMP_LOOP_TYPE const n_chunks = m.n_chunks;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE c = 0; c < n_chunks; c++)
+	{
+		double sum[C] = {};
+		for (std::size_t k = m.chunk_ptr[c]; k < m.chunk_ptr[c + 1]; k += C)
+			for (std::size_t r = 0; r < C; ++r)
+				sum[r] += m.data[k + r] * x[m.col_idx[k + r]];
+		storeChunk(m, c, d, sum, y);
+	}
+}
+
+#ifdef SELL_X86_KERNELS
+/// Processes a chunk as two halves of four rows.
+/// The gathers are masked with an initialized source, which the unmasked
+/// intrinsics leave undefined.
+__attribute__((target("avx2,fma")))
+void amuxAVX2(SELLArrays const& m, double const d, double const* const x,
+              double* const y)
+{
+	__m256d const zero = _mm256_setzero_pd();
+	__m256d const all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+	OPENMP_LOOP_TYPE const n_chunks = m.n_chunks;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE c = 0; c < n_chunks; c++)
+	{
+		__m256d s0 = _mm256_setzero_pd();
+		__m256d s1 = _mm256_setzero_pd();
+		for (std::size_t k = m.chunk_ptr[c]; k < m.chunk_ptr[c + 1]; k += C)
+		{
+			__m128i const i0 = _mm_loadu_si128(
+			    reinterpret_cast<__m128i const*>(m.col_idx + k));
+			__m128i const i1 = _mm_loadu_si128(
+			    reinterpret_cast<__m128i const*>(m.col_idx + k + 4));
+			s0 = _mm256_fmadd_pd(_mm256_loadu_pd(m.data + k),
+			                     _mm256_mask_i32gather_pd(zero, x, i0, all, 8),
+			                     s0);
+			s1 = _mm256_fmadd_pd(_mm256_loadu_pd(m.data + k + 4),
+			                     _mm256_mask_i32gather_pd(zero, x, i1, all, 8),
+			                     s1);
+		}
+		alignas(32) double sum[C];
+		_mm256_store_pd(sum, s0);
+		_mm256_store_pd(sum + 4, s1);
+		storeChunk(m, c, d, sum, y);
+	}
+}
+
+/// Processes a chunk in one register; the gather is masked as in amuxAVX2().
+__attribute__((target("avx512f")))
+void amuxAVX512(SELLArrays const& m, double const d, double const* const x,
+                double* const y)
+{
+	__m512d const zero = _mm512_setzero_pd();
+	OPENMP_LOOP_TYPE const n_chunks = m.n_chunks;
+	#pragma omp parallel for
+	for (OPENMP_LOOP_TYPE c = 0; c < n_chunks; c++)
+	{
+		__m512d s = _mm512_setzero_pd();
+		for (std::size_t k = m.chunk_ptr[c]; k < m.chunk_ptr[c + 1]; k += C)
+		{
+			__m256i const i = _mm256_loadu_si256(
+			    reinterpret_cast<__m256i const*>(m.col_idx + k));
+			s = _mm512_fmadd_pd(_mm512_loadu_pd(m.data + k),
+			                    _mm512_mask_i32gather_pd(zero, 0xFF, i, x, 8),
+			                    s);
+		}
+		alignas(64) double sum[C];
+		_mm512_store_pd(sum, s);
+		storeChunk(m, c, d, sum, y);
+	}
+}
+#endif  // SELL_X86_KERNELS
+} // namespace
+
+void SELLMatrix::setupStructure(std::vector<std::size_t> const& row_lengths,
+                                std::size_t const sigma)
+{
+	std::size_t const n = row_lengths.size();
+	if (n > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+	{
+		ERR("SELLMatrix: %d rows exceed the 32 bit column indices.", n);
+		std::abort();
+	}
+
+	// Sort the rows of each window by decreasing length; rows of equal
+	// length keep their order.
+	_perm.resize(n);
+	std::iota(_perm.begin(), _perm.end(), 0);
+	std::size_t const window = std::max<std::size_t>(sigma, 1);
+	for (std::size_t first = 0; first < n; first += window)
+	{
+		std::stable_sort(
+		    _perm.begin() + first,
+		    _perm.begin() + std::min(first + window, n),
+		    [&row_lengths](std::size_t const a, std::size_t const b)
+		    {
+			    return row_lengths[a] > row_lengths[b];
+		    });
+	}
+
+	std::size_t const n_chunks = (n + chunk_size - 1) / chunk_size;
+	_chunk_ptr.resize(n_chunks + 1);
+	_chunk_ptr[0] = 0;
+	for (std::size_t c = 0; c < n_chunks; ++c)
+	{
+		std::size_t width = 0;
+		for (std::size_t k = c * chunk_size;
+		     k < std::min((c + 1) * chunk_size, n); ++k)
+			width = std::max(width, row_lengths[_perm[k]]);
+		_chunk_ptr[c + 1] = _chunk_ptr[c] + width * chunk_size;
+	}
+
+	_col_idx.assign(_chunk_ptr[n_chunks], 0);
+	_data.assign(_chunk_ptr[n_chunks], 0.0);
+
+	for (Kernel const kernel : {Kernel::AVX512, Kernel::AVX2, Kernel::Scalar})
+		if (isSupported(kernel))
+		{
+			_kernel = kernel;
+			break;
+		}
+}
+
+void SELLMatrix::amux(double const d, double const* const x,
+                      double* const y) const
+{
+	SELLArrays const m{_perm.size(), _chunk_ptr.size() - 1, _perm.data(),
+	                   _chunk_ptr.data(), _col_idx.data(), _data.data()};
+	switch (_kernel)
+	{
+#ifdef SELL_X86_KERNELS
+		case Kernel::AVX512:
+			amuxAVX512(m, d, x, y);
+			return;
+		case Kernel::AVX2:
+			amuxAVX2(m, d, x, y);
+			return;
+#endif
+		default:
+			amuxScalar(m, d, x, y);
+	}
+}
+
+void SELLMatrix::setKernel(Kernel const kernel)
+{
+	if (!isSupported(kernel))
+	{
+		ERR("SELLMatrix: the kernel is not supported on this processor.");
+		std::abort();
+	}
+	_kernel = kernel;
+}
+
+bool SELLMatrix::isSupported(Kernel const kernel)
+{
+	if (kernel == Kernel::Scalar)
+		return true;
+#ifdef SELL_X86_KERNELS
+	if (kernel == Kernel::AVX2)
+		return __builtin_cpu_supports("avx2") &&
+		       __builtin_cpu_supports("fma");
+	if (kernel == Kernel::AVX512)
+		return __builtin_cpu_supports("avx512f");
+#endif
+	return false;
+}
+
+} // end namespace MathLib
@@ -0,0 +1,132 @@
+/**
+ * \file
+ * \brief  Definition of the SELLMatrix class.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef SELLMATRIX_H_
+#define SELLMATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MathLib
+{
+
+/**
+ * Sparse matrix in sliced ELLPACK format, SELL-C-\f$ \sigma \f$, for fast
+ * matrix vector multiplications with SIMD instructions.
+ *
+ * The rows are sorted by their number of entries within windows of
+ * \f$ \sigma \f$ rows and then cut into chunks of \f$ C \f$ = chunk_size
+ * rows. The entries of a chunk are padded with zeros to the length of its
+ * longest row and stored column by column, i.e. the j-th entries of the
+ * chunk's rows are contiguous. Thereby one SIMD instruction processes one
+ * entry of each row of a chunk. The sorting keeps the padding small for
+ * varying row lengths.
+ *
+ * amux() uses AVX-512 or AVX2 kernels if the processor supports them, which
+ * is checked at run time, and a portable kernel otherwise. The chunks are
+ * processed in parallel if OpenMP is enabled.
+ */
+class SELLMatrix
+{
+public:
+	/// The matrix vector multiplication kernels.
+	enum class Kernel
+	{
+		Scalar,
+		AVX2,
+		AVX512
+	};
+
+	/// Number of rows of a chunk; the width of AVX-512 registers of doubles.
+	static std::size_t const chunk_size = 8;
+
+	/**
+	 * Converts the given \f$ n \times n \f$ matrix.
+	 * @param n number of rows / columns
+	 * @param iA row pointer of compressed row storage format
+	 * @param jA column index of compressed row storage format
+	 * @param A data entries of compressed row storage format
+	 * @param sigma number of rows of the windows sorted by row length
+	 */
+	template <typename IDX_TYPE>
+	SELLMatrix(std::size_t const n, IDX_TYPE const* const iA,
+	           IDX_TYPE const* const jA, double const* const A,
+	           std::size_t const sigma = 128)
+	{
+		std::vector<std::size_t> row_lengths(n);
+		for (std::size_t i = 0; i < n; ++i)
+			row_lengths[i] = iA[i + 1] - iA[i];
+		setupStructure(row_lengths, sigma);
+
+		for (std::size_t k = 0; k < n; ++k)
+		{
+			std::size_t const row = _perm[k];
+			std::size_t const c = k / chunk_size;
+			std::size_t const width =
+			    (_chunk_ptr[c + 1] - _chunk_ptr[c]) / chunk_size;
+			std::int32_t* const cols = &_col_idx[_chunk_ptr[c] + k % chunk_size];
+			double* const values = &_data[_chunk_ptr[c] + k % chunk_size];
+
+			std::size_t j = 0;
+			for (IDX_TYPE p = iA[row]; p < iA[row + 1]; ++p, ++j)
+			{
+				cols[j * chunk_size] = static_cast<std::int32_t>(jA[p]);
+				values[j * chunk_size] = A[p];
+			}
+			// The zero padding reads an entry of x the row reads anyway.
+			std::int32_t const padding_col =
+			    j > 0 ? cols[(j - 1) * chunk_size]
+			          : static_cast<std::int32_t>(row);
+			for (; j < width; ++j)
+				cols[j * chunk_size] = padding_col;
+		}
+	}
+
+	/// Computes \f$ y = d A x \f$.
+	void amux(double const d, double const* const x, double* const y) const;
+
+	std::size_t getNRows() const { return _perm.size(); }
+
+	/// Number of stored entries including the padding.
+	std::size_t getNStoredEntries() const { return _data.size(); }
+
+	/// The kernel used by amux(); the fastest supported one by default.
+	Kernel getKernel() const { return _kernel; }
+
+	/// Selects the kernel used by amux(); aborts if it is not supported.
+	void setKernel(Kernel const kernel);
+
+	/// Returns true if the processor and the compiler support the kernel.
+	static bool isSupported(Kernel const kernel);
+
+private:
+	/// Sets the permutation, the chunk pointers, and allocates the padded
+	/// entries.
+	void setupStructure(std::vector<std::size_t> const& row_lengths,
+	                    std::size_t const sigma);
+
+	/// Original row of each sorted row.
+	std::vector<std::size_t> _perm;
+	/// First entry of each chunk; chunk c has
+	/// <tt>(_chunk_ptr[c+1]-_chunk_ptr[c])/chunk_size</tt> columns.
+	std::vector<std::size_t> _chunk_ptr;
+	/// Column indices; 32 bit for the gather instructions.
+	std::vector<std::int32_t> _col_idx;
+	std::vector<double> _data;
+
+	Kernel _kernel = Kernel::Scalar;
+};
+
+} // end namespace MathLib
+
+#endif /* SELLMATRIX_H_ */
@@ -0,0 +1,43 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef MATHLIB_SYMMETRICMATRIXSTORAGE_H_
+#define MATHLIB_SYMMETRICMATRIXSTORAGE_H_
+
+#include <type_traits>
+
+namespace MathLib
+{
+
+/// Tells whether the linear solver accepts a matrix storing its upper
+/// triangle only; specialized for the solvers which do not.
+template <typename LinearSolver>
+struct SupportsSymmetricStorage : std::true_type
+{
+};
+
+/// Declares a newly created global matrix symmetric. Matrix types supporting
+/// it store and assemble only the upper triangle afterwards; the linear
+/// solver has to be created after this call.
+///
+/// Generic variant for matrix types without symmetric storage; the matrix is
+/// stored completely and false is returned.
+template <typename MAT_T>
+bool setSymmetricStorage(MAT_T& /*A*/)
+{
+	return false;
+}
+
+} // MathLib
+
+#ifdef OGS_USE_EIGEN
+#include "MathLib/LinAlg/Eigen/EigenTools.h"
+#endif // OGS_USE_EIGEN
+
+#endif  // MATHLIB_SYMMETRICMATRIXSTORAGE_H_
@@ -8,6 +8,7 @@
  */
 
 
+#include <algorithm>
 #include <cassert>
 
 #include <logog/include/logog.hpp>
@@ -15,6 +16,9 @@
 #include "MathLib/LinAlg/MatrixTools.h"
 #include "MeshLib/ElementCoordinatesMappingLocal.h"
 #include "MeshLib/CoordinateSystem.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Node.h"
+#include "NumLib/Fem/ShapeFunctionTable.h"
 
 namespace NumLib
 {
@@ -24,48 +28,82 @@ namespace detail
 
 template <ShapeMatrixType FIELD_TYPE> struct FieldType {};
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+/// Evaluates the shape functions at a point given in natural coordinates.
+template <class T_SHAPE_FUNC, class T_N>
+inline void computeShapeFunction(const double* natural_pt, T_N &N)
+{
+    T_SHAPE_FUNC::computeShapeFunction(natural_pt, N);
+}
+
+/// Copies the tabulated shape functions.
+template <class T_SHAPE_FUNC, class T_N>
+inline void computeShapeFunction(
+        const ShapeFunctionValues<T_SHAPE_FUNC> &values, T_N &N)
+{
+    std::copy(values.N.cbegin(), values.N.cend(), N.data());
+}
+
+/// Evaluates the shape function derivatives at a point given in natural
+/// coordinates.
+template <class T_SHAPE_FUNC>
+inline void computeGradShapeFunction(const double* natural_pt, double* dNdr)
+{
+    T_SHAPE_FUNC::computeGradShapeFunction(natural_pt, dNdr);
+}
+
+/// Copies the tabulated shape function derivatives.
+template <class T_SHAPE_FUNC>
+inline void computeGradShapeFunction(
+        const ShapeFunctionValues<T_SHAPE_FUNC> &values, double* dNdr)
+{
+    std::copy(values.dNdr.cbegin(), values.dNdr.cend(), dNdr);
+}
+
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &/*ele*/,
-        const double* natural_pt,
+        const T_NATURAL_PT& natural_pt,
         const MeshLib::ElementCoordinatesMappingLocal &/*ele_local_coord*/,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::N>)
 {
-    T_SHAPE_FUNC::computeShapeFunction(natural_pt, shapemat.N);
+    computeShapeFunction<T_SHAPE_FUNC>(natural_pt, shapemat.N);
 }
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline
 typename std::enable_if<T_SHAPE_FUNC::DIM!=0>::type
 computeMappingMatrices(
         const T_MESH_ELEMENT &/*ele*/,
-        const double* natural_pt,
+        const T_NATURAL_PT& natural_pt,
         const MeshLib::ElementCoordinatesMappingLocal &/*ele_local_coord*/,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDR>)
 {
-    double* const dNdr = shapemat.dNdr.data();
-    T_SHAPE_FUNC::computeGradShapeFunction(natural_pt, dNdr);
+    computeGradShapeFunction<T_SHAPE_FUNC>(natural_pt, shapemat.dNdr.data());
 }
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline
 typename std::enable_if<T_SHAPE_FUNC::DIM==0>::type
 computeMappingMatrices(
         const T_MESH_ELEMENT &/*ele*/,
-        const double* /*natural_pt*/,
+        const T_NATURAL_PT& /*natural_pt*/,
         const MeshLib::ElementCoordinatesMappingLocal &/*ele_local_coord*/,
         T_SHAPE_MATRICES &/*shapemat*/,
         FieldType<ShapeMatrixType::DNDR>)
 {
 }
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline
 typename std::enable_if<T_SHAPE_FUNC::DIM!=0>::type
 computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_NATURAL_PT& natural_pt,
         const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDR_J>)
@@ -94,12 +132,13 @@ computeMappingMatrices(
         ERR("***error: det|J|=%e is not positive.\n", shapemat.detJ);
 #endif
 }
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline
 typename std::enable_if<T_SHAPE_FUNC::DIM==0>::type
 computeMappingMatrices(
         const T_MESH_ELEMENT &/*ele*/,
-        const double* /*natural_pt*/,
+        const T_NATURAL_PT& /*natural_pt*/,
         const MeshLib::ElementCoordinatesMappingLocal &/*ele_local_coord*/,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDR_J>)
@@ -107,10 +146,11 @@ computeMappingMatrices(
     shapemat.detJ = 1.0;
 }
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_NATURAL_PT& natural_pt,
         const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::N_J>)
@@ -121,12 +161,35 @@ inline void computeMappingMatrices(
         (ele, natural_pt, ele_local_coord, shapemat, FieldType<ShapeMatrixType::DNDR_J>());
 }
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+/// dshape/dx from dNdr and invJ
+template <class T_MESH_ELEMENT, class T_SHAPE_MATRICES>
+inline void computeGlobalGradients(
+        const T_MESH_ELEMENT &ele,
+        const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
+        T_SHAPE_MATRICES &shapemat)
+{
+    (void)ele;
+    auto const nnodes(shapemat.dNdr.cols());
+    auto const ele_dim(shapemat.dNdr.rows());
+    assert(shapemat.dNdr.rows()==ele.getDimension());
+    const unsigned global_dim(ele_local_coord.getGlobalCoordinateSystem().getDimension());
+    if (global_dim==ele_dim) {
+        shapemat.dNdx.topLeftCorner(ele_dim, nnodes).noalias() = shapemat.invJ * shapemat.dNdr;
+    } else {
+        auto const& matR = ele_local_coord.getRotationMatrixToGlobal(); // 3 x 3
+        auto invJ_dNdr = shapemat.invJ * shapemat.dNdr;
+        auto dshape_global = matR.topLeftCorner(3u, ele_dim) * invJ_dNdr; //3 x nnodes
+        shapemat.dNdx = dshape_global.topLeftCorner(global_dim, nnodes);;
+    }
+}
+
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline
 typename std::enable_if<T_SHAPE_FUNC::DIM!=0>::type
 computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_NATURAL_PT& natural_pt,
         const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::DNDX>)
@@ -138,27 +201,16 @@ computeMappingMatrices(
         //J^-1, dshape/dx
         //shapemat.invJ.noalias() = shapemat.J.inverse();
         MathLib::inverse(shapemat.J, shapemat.detJ, shapemat.invJ);
-
-        auto const nnodes(shapemat.dNdr.cols());
-        auto const ele_dim(shapemat.dNdr.rows());
-        assert(shapemat.dNdr.rows()==ele.getDimension());
-        const unsigned global_dim(ele_local_coord.getGlobalCoordinateSystem().getDimension());
-        if (global_dim==ele_dim) {
-            shapemat.dNdx.topLeftCorner(ele_dim, nnodes).noalias() = shapemat.invJ * shapemat.dNdr;
-        } else {
-            auto const& matR = ele_local_coord.getRotationMatrixToGlobal(); // 3 x 3
-            auto invJ_dNdr = shapemat.invJ * shapemat.dNdr;
-            auto dshape_global = matR.topLeftCorner(3u, ele_dim) * invJ_dNdr; //3 x nnodes
-            shapemat.dNdx = dshape_global.topLeftCorner(global_dim, nnodes);;
-        }
+        computeGlobalGradients(ele, ele_local_coord, shapemat);
     }
 }
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline
 typename std::enable_if<T_SHAPE_FUNC::DIM==0>::type
 computeMappingMatrices(
        const T_MESH_ELEMENT &ele,
-       const double* natural_pt,
+       const T_NATURAL_PT& natural_pt,
        const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
        T_SHAPE_MATRICES &shapemat,
        FieldType<ShapeMatrixType::DNDX>)
@@ -168,10 +220,11 @@ computeMappingMatrices(
 }
 
 
-template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES,
+          class T_NATURAL_PT>
 inline void computeMappingMatrices(
         const T_MESH_ELEMENT &ele,
-        const double* natural_pt,
+        const T_NATURAL_PT& natural_pt,
         const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
         T_SHAPE_MATRICES &shapemat,
         FieldType<ShapeMatrixType::ALL>)
@@ -182,6 +235,113 @@ inline void computeMappingMatrices(
         (ele, natural_pt, ele_local_coord, shapemat, FieldType<ShapeMatrixType::DNDX>());
 }
 
+/// Computes the mapping matrices from the tabulated values and the Jacobian
+/// of another point of the same element, which is valid if the Jacobian is
+/// constant over the element.
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+inline
+typename std::enable_if<T_SHAPE_FUNC::DIM!=0>::type
+computeMappingMatricesWithJacobian(
+        const T_MESH_ELEMENT &ele,
+        const ShapeFunctionValues<T_SHAPE_FUNC> &values,
+        const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
+        const T_SHAPE_MATRICES &jacobian_shapemat,
+        T_SHAPE_MATRICES &shapemat)
+{
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
+        (ele, values, ele_local_coord, shapemat, FieldType<ShapeMatrixType::N>());
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
+        (ele, values, ele_local_coord, shapemat, FieldType<ShapeMatrixType::DNDR>());
+
+    shapemat.J = jacobian_shapemat.J;
+    shapemat.detJ = jacobian_shapemat.detJ;
+    shapemat.invJ = jacobian_shapemat.invJ;
+    if (shapemat.detJ>.0)
+        computeGlobalGradients(ele, ele_local_coord, shapemat);
+}
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+inline
+typename std::enable_if<T_SHAPE_FUNC::DIM==0>::type
+computeMappingMatricesWithJacobian(
+        const T_MESH_ELEMENT &ele,
+        const ShapeFunctionValues<T_SHAPE_FUNC> &values,
+        const MeshLib::ElementCoordinatesMappingLocal &ele_local_coord,
+        const T_SHAPE_MATRICES &/*jacobian_shapemat*/,
+        T_SHAPE_MATRICES &shapemat)
+{
+    computeMappingMatrices<T_MESH_ELEMENT, T_SHAPE_FUNC, T_SHAPE_MATRICES>
+        (ele, values, ele_local_coord, shapemat, FieldType<ShapeMatrixType::ALL>());
+}
+
+/// True if x_a + x_c = x_b + x_d for the nodes a, b, c, d given in cyclic
+/// order, i.e. if they form a parallelogram. The tolerance is relative to the
+/// diagonals' lengths.
+inline bool isParallelogram(const MeshLib::Element &e,
+        unsigned a, unsigned b, unsigned c, unsigned d)
+{
+    auto const& xa = *e.getNode(a);
+    auto const& xb = *e.getNode(b);
+    auto const& xc = *e.getNode(c);
+    auto const& xd = *e.getNode(d);
+
+    double deviation = 0;
+    double diagonals = 0;
+    for (unsigned k = 0; k < 3; k++) {
+        double const dev = xa[k] + xc[k] - xb[k] - xd[k];
+        double const ac = xa[k] - xc[k];
+        double const bd = xb[k] - xd[k];
+        deviation += dev * dev;
+        diagonals += ac * ac + bd * bd;
+    }
+    return deviation <= 1e-24 * diagonals;
+}
+
+/// Checks if the Jacobian of the mapping is constant over the element. By
+/// default it is not assumed to be.
+template <class T_SHAPE_FUNC>
+struct ConstantJacobian
+{
+    static bool check(const MeshLib::Element &/*e*/) { return false; }
+};
+
+/// Linear simplices are always mapped affinely.
+template <class T_SHAPE_FUNC>
+struct ConstantJacobianAlways
+{
+    static bool check(const MeshLib::Element &/*e*/) { return true; }
+};
+
+template <> struct ConstantJacobian<ShapePoint1> : ConstantJacobianAlways<ShapePoint1> {};
+template <> struct ConstantJacobian<ShapeLine2> : ConstantJacobianAlways<ShapeLine2> {};
+template <> struct ConstantJacobian<ShapeTri3> : ConstantJacobianAlways<ShapeTri3> {};
+template <> struct ConstantJacobian<ShapeTet4> : ConstantJacobianAlways<ShapeTet4> {};
+
+/// A bilinear quadrilateral is affine if it is a parallelogram.
+template <>
+struct ConstantJacobian<ShapeQuad4>
+{
+    static bool check(const MeshLib::Element &e)
+    {
+        return isParallelogram(e, 0, 1, 2, 3);
+    }
+};
+
+/// A trilinear hexahedron is affine if all faces are parallelograms, i.e. if
+/// it is a parallelepiped.
+template <>
+struct ConstantJacobian<ShapeHex8>
+{
+    static bool check(const MeshLib::Element &e)
+    {
+        return isParallelogram(e, 0, 1, 2, 3) &&  // bottom
+               isParallelogram(e, 4, 5, 6, 7) &&  // top
+               isParallelogram(e, 0, 1, 5, 4) &&  // front
+               isParallelogram(e, 3, 2, 6, 7) &&  // back
+               isParallelogram(e, 0, 3, 7, 4) &&  // left
+               isParallelogram(e, 1, 2, 6, 5);    // right
+    }
+};
+
 } // detail
 
 template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
@@ -233,4 +393,87 @@ inline void NaturalCoordinatesMapping<
              detail::FieldType<T_SHAPE_MATRIX_TYPE>());
 }
 
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+inline bool NaturalCoordinatesMapping<
+    T_MESH_ELEMENT,
+    T_SHAPE_FUNC,
+    T_SHAPE_MATRICES>
+::hasConstantJacobian(const T_MESH_ELEMENT &ele)
+{
+    return detail::ConstantJacobian<T_SHAPE_FUNC>::check(ele);
+}
+
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+inline void NaturalCoordinatesMapping<
+    T_MESH_ELEMENT,
+    T_SHAPE_FUNC,
+    T_SHAPE_MATRICES>
+::computeShapeMatrices(
+        const T_MESH_ELEMENT &ele,
+        const std::vector<ShapeFunctionValues<T_SHAPE_FUNC>> &values,
+        std::vector<T_SHAPE_MATRICES> &shapemats)
+{
+    assert(values.size() == shapemats.size());
+    if (values.empty())
+        return;
+
+    const MeshLib::CoordinateSystem coords(ele);
+    const MeshLib::ElementCoordinatesMappingLocal ele_local_coord(ele, coords);
+
+    detail::computeMappingMatrices<
+        T_MESH_ELEMENT,
+        T_SHAPE_FUNC,
+        T_SHAPE_MATRICES>
+            (ele,
+             values[0],
+             ele_local_coord,
+             shapemats[0],
+             detail::FieldType<ShapeMatrixType::ALL>());
+
+    bool const constant_jacobian = hasConstantJacobian(ele);
+    for (std::size_t i = 1; i < values.size(); i++) {
+        if (constant_jacobian)
+            detail::computeMappingMatricesWithJacobian<
+                T_MESH_ELEMENT,
+                T_SHAPE_FUNC,
+                T_SHAPE_MATRICES>
+                    (ele, values[i], ele_local_coord, shapemats[0],
+                     shapemats[i]);
+        else
+            detail::computeMappingMatrices<
+                T_MESH_ELEMENT,
+                T_SHAPE_FUNC,
+                T_SHAPE_MATRICES>
+                    (ele,
+                     values[i],
+                     ele_local_coord,
+                     shapemats[i],
+                     detail::FieldType<ShapeMatrixType::ALL>());
+    }
+}
+
+template <class T_MESH_ELEMENT, class T_SHAPE_FUNC, class T_SHAPE_MATRICES>
+inline void NaturalCoordinatesMapping<
+    T_MESH_ELEMENT,
+    T_SHAPE_FUNC,
+    T_SHAPE_MATRICES>
+::computeShapeMatrices(
+        const T_MESH_ELEMENT &ele,
+        const ShapeFunctionValues<T_SHAPE_FUNC> &values,
+        T_SHAPE_MATRICES &shapemat)
+{
+    const MeshLib::CoordinateSystem coords(ele);
+    const MeshLib::ElementCoordinatesMappingLocal ele_local_coord(ele, coords);
+
+    detail::computeMappingMatrices<
+        T_MESH_ELEMENT,
+        T_SHAPE_FUNC,
+        T_SHAPE_MATRICES>
+            (ele,
+             values,
+             ele_local_coord,
+             shapemat,
+             detail::FieldType<ShapeMatrixType::ALL>());
+}
+
 } // NumLib
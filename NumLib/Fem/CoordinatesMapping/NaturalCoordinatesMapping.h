@@ -15,11 +15,31 @@
 #define NATURALCOORDINATESMAPPING_H_
 
 
+#include <type_traits>
+#include <vector>
+
 #include "ShapeMatrices.h"
+#include "NumLib/Fem/ShapeFunctionTable.h"
 
 namespace NumLib
 {
 
+class ShapeLine2;
+class ShapePoint1;
+class ShapeQuad4;
+class ShapeHex8;
+class ShapeTet4;
+class ShapeTri3;
+
+/// True for shape functions whose derivatives are constant in natural
+/// coordinates, i.e. the linear simplices. On these the derivatives dNdx and
+/// the Jacobian are constant over the element.
+template <class T_SHAPE_FUNC>
+struct ShapeFunctionGradientsAreConstant : std::false_type {};
+template <> struct ShapeFunctionGradientsAreConstant<ShapeLine2> : std::true_type {};
+template <> struct ShapeFunctionGradientsAreConstant<ShapeTri3> : std::true_type {};
+template <> struct ShapeFunctionGradientsAreConstant<ShapeTet4> : std::true_type {};
+
 /**
  * Coordinates mapping tools for natural coordinates
  *
@@ -53,6 +73,35 @@ struct NaturalCoordinatesMapping
      */
     template <ShapeMatrixType T_SHAPE_MATRIX_TYPE>
     static void computeShapeMatrices(const T_MESH_ELEMENT &ele, const double* natural_pt, T_SHAPE_MATRICES &shapemat);
+
+    /**
+     * compute all mapping matrices from tabulated shape function values,
+     * e.g. at an integration point, see ShapeFunctionTable
+     *
+     * @param ele               Mesh element object
+     * @param values            Shape functions and their derivatives in natural coordinates
+     * @param shapemat          Shape matrix data where calculated shape functions are stored
+     */
+    static void computeShapeMatrices(const T_MESH_ELEMENT &ele, const ShapeFunctionValues<T_SHAPE_FUNC> &values, T_SHAPE_MATRICES &shapemat);
+
+    /**
+     * compute all mapping matrices from tabulated shape function values at
+     * several points of the same element. If the Jacobian is constant, see
+     * hasConstantJacobian(), J, detJ and invJ are computed once.
+     *
+     * @param ele               Mesh element object
+     * @param values            Shape functions and their derivatives in natural coordinates
+     * @param shapemats         Shape matrix data for each of the values
+     */
+    static void computeShapeMatrices(const T_MESH_ELEMENT &ele, const std::vector<ShapeFunctionValues<T_SHAPE_FUNC>> &values, std::vector<T_SHAPE_MATRICES> &shapemats);
+
+    /**
+     * check if the mapping is affine, i.e. the Jacobian is constant over the
+     * element; true for linear simplices, parallelograms and parallelepipeds
+     *
+     * @param ele               Mesh element object
+     */
+    static bool hasConstantJacobian(const T_MESH_ELEMENT &ele);
 };
 
 } // NumLib
@@ -102,6 +102,30 @@ public:
         NaturalCoordsMappingType::template computeShapeMatrices<T_SHAPE_MATRIX_TYPE>(*_ele, natural_pt, shape);
     }
 
+    /**
+     * compute shape functions from tabulated values in natural coordinates,
+     * which avoids the evaluation of the shape functions
+     *
+     * @param values        shape functions and derivatives, e.g. from ShapeFunctionTable
+     * @param shape         evaluated shape function matrices
+     */
+    void computeShapeFunctions(const ShapeFunctionValues<ShapeFunctionType> &values, ShapeMatrices &shape) const
+    {
+        NaturalCoordsMappingType::computeShapeMatrices(*_ele, values, shape);
+    }
+
+    /**
+     * compute shape functions at several points from tabulated values; for
+     * affine elements the Jacobian is computed once
+     *
+     * @param values        shape functions and derivatives, e.g. from ShapeFunctionTable
+     * @param shapes        evaluated shape function matrices for each of the values
+     */
+    void computeShapeFunctions(const std::vector<ShapeFunctionValues<ShapeFunctionType>> &values, std::vector<ShapeMatrices> &shapes) const
+    {
+        NaturalCoordsMappingType::computeShapeMatrices(*_ele, values, shapes);
+    }
+
 
 private:
     const MeshElementType* _ele;
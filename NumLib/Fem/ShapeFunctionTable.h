@@ -0,0 +1,111 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef NUMLIB_SHAPEFUNCTIONTABLE_H_
+#define NUMLIB_SHAPEFUNCTIONTABLE_H_
+
+#include <array>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include <logog/include/logog.hpp>
+
+namespace NumLib
+{
+
+/// Shape function values \f$ N \f$ and their derivatives \f$ dN/dr \f$ with
+/// respect to the natural coordinates at one point. The derivatives are stored
+/// row by row, i.e. in the layout of the shape matrices' dNdr.
+template <typename ShapeFunction>
+struct ShapeFunctionValues
+{
+    std::array<double, ShapeFunction::NPOINTS> N;
+    std::array<double, ShapeFunction::DIM * ShapeFunction::NPOINTS> dNdr;
+};
+
+/// Shape function values at the integration points of an integration method.
+///
+/// The values in natural coordinates depend on the shape function and the
+/// integration order only. They are evaluated once for all integration orders
+/// up to #max_integration_order on the first call of get() and shared by all
+/// elements; the coordinates mapping then only combines them with the element
+/// coordinates.
+template <typename ShapeFunction, typename IntegrationMethod>
+class ShapeFunctionTable
+{
+public:
+    using Values = ShapeFunctionValues<ShapeFunction>;
+
+    /// Highest integration order of the Gauss-Legendre rules.
+    static const unsigned max_integration_order = 4;
+
+    /// Returns the values at all integration points of the given order; the
+    /// table is empty if the integration method has no rule of this order.
+    static std::vector<Values> const& get(unsigned const integration_order)
+    {
+        // Initialized once in a thread-safe way.
+        static std::array<std::vector<Values>, max_integration_order + 1> const
+            tables = createTables();
+
+        if (integration_order > max_integration_order)
+        {
+            ERR("Integration order %u is not supported; the maximum is %u.",
+                integration_order, max_integration_order);
+            std::abort();
+        }
+        return tables[integration_order];
+    }
+
+private:
+    static std::array<std::vector<Values>, max_integration_order + 1>
+    createTables()
+    {
+        std::array<std::vector<Values>, max_integration_order + 1> tables;
+        for (unsigned order = 0; order <= max_integration_order; ++order)
+        {
+            IntegrationMethod integration_method(order);
+            std::size_t const n_integration_points =
+                integration_method.getNPoints();
+
+            auto& table = tables[order];
+            table.resize(n_integration_points);
+            for (std::size_t ip = 0; ip < n_integration_points; ++ip)
+            {
+                auto const& wp = integration_method.getWeightedPoint(ip);
+                ShapeFunction::computeShapeFunction(wp.getCoords(),
+                                                    table[ip].N);
+                computeGradShapeFunction(wp.getCoords(), table[ip]);
+            }
+        }
+        return tables;
+    }
+
+    template <typename Coords, typename SF = ShapeFunction>
+    static typename std::enable_if<SF::DIM != 0>::type
+    computeGradShapeFunction(Coords const& r, Values& values)
+    {
+        double* const dNdr = values.dNdr.data();
+        ShapeFunction::computeGradShapeFunction(r, dNdr);
+    }
+
+    template <typename Coords, typename SF = ShapeFunction>
+    static typename std::enable_if<SF::DIM == 0>::type
+    computeGradShapeFunction(Coords const& /*r*/, Values& /*values*/)
+    {
+    }
+};
+
+template <typename ShapeFunction, typename IntegrationMethod>
+const unsigned
+    ShapeFunctionTable<ShapeFunction, IntegrationMethod>::max_integration_order;
+
+}   // namespace NumLib
+
+#endif  // NUMLIB_SHAPEFUNCTIONTABLE_H_
@@ -0,0 +1,81 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include "ShapeMatricesCache.h"
+
+#include <cstring>
+#include <functional>
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Node.h"
+
+namespace NumLib
+{
+
+std::size_t ShapeMatricesCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _shape_matrices.size();
+}
+
+std::size_t ShapeMatricesCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t seed = key.shape_matrices_type.hash_code() ^
+                       (key.element_type.hash_code() << 1) ^
+                       key.integration_order;
+    std::hash<std::uint64_t> const hash;
+    for (auto const o : key.offsets)
+        seed ^= hash(o) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+ShapeMatricesCache::Key ShapeMatricesCache::makeKey(
+    std::type_index const shape_matrices_type, MeshLib::Element const& e,
+    unsigned const integration_order)
+{
+    // Ignore the last mantissa bits to absorb round-off differences.
+    std::uint64_t const mask = ~((std::uint64_t{1} << 12) - 1);
+
+    Key key{shape_matrices_type, typeid(e), integration_order, {}};
+    unsigned const n_nodes = e.getNNodes();
+    key.offsets.reserve(3 * (n_nodes - 1));
+
+    double const* const x0 = e.getNode(0)->getCoords();
+    for (unsigned i = 1; i < n_nodes; ++i)
+    {
+        double const* const x = e.getNode(i)->getCoords();
+        for (unsigned d = 0; d < 3; ++d)
+        {
+            // Adding zero turns a negative zero into a positive one.
+            double const offset = (x[d] - x0[d]) + 0.0;
+            std::uint64_t bits;
+            std::memcpy(&bits, &offset, sizeof(bits));
+            key.offsets.push_back(bits & mask);
+        }
+    }
+    return key;
+}
+
+std::shared_ptr<void const> ShapeMatricesCache::find(Key const& key) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto const it = _shape_matrices.find(key);
+    if (it == _shape_matrices.end())
+        return nullptr;
+    return it->second;
+}
+
+std::shared_ptr<void const> ShapeMatricesCache::insert(
+    Key&& key, std::shared_ptr<void const> const& sm)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _shape_matrices.emplace(std::move(key), sm).first->second;
+}
+
+}   // namespace NumLib
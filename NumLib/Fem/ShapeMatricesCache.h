@@ -0,0 +1,121 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef NUMLIB_SHAPEMATRICESCACHE_H_
+#define NUMLIB_SHAPEMATRICESCACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace MeshLib
+{
+class Element;
+}
+
+namespace NumLib
+{
+
+/// Shares the shape matrices at the integration points among geometrically
+/// congruent elements.
+///
+/// Two elements are congruent if they are of the same type and their nodes
+/// differ by a translation only, i.e. the node coordinates relative to the
+/// first node are equal. Their shape function derivatives and Jacobian
+/// determinants are then equal, too. On structured meshes, e.g. created by
+/// the MeshGenerator or by layer mapping, few distinct shape matrix sets are
+/// stored for all elements.
+///
+/// The relative coordinates are compared with the last 12 mantissa bits
+/// cleared, so that round-off differences of the node coordinates do not
+/// prevent sharing.
+///
+/// The cache is thread-safe; the shape matrices of an element are computed
+/// outside of the lock.
+class ShapeMatricesCache
+{
+public:
+    /// Returns the shape matrices of a congruent element already in the
+    /// cache, or the shape matrices computed by \c compute(), which are then
+    /// added to the cache.
+    ///
+    /// \tparam ShapeMatrices the shape matrices type, which must be the same
+    ///         for all elements of a type and integration order.
+    /// \param compute a callable returning the std::vector<ShapeMatrices> of
+    ///        the element at the integration points.
+    template <typename ShapeMatrices, typename Compute>
+    std::shared_ptr<std::vector<ShapeMatrices> const> get(
+        MeshLib::Element const& e, unsigned const integration_order,
+        Compute const& compute)
+    {
+        using ShapeMatricesVector = std::vector<ShapeMatrices>;
+
+        Key key = makeKey(typeid(ShapeMatricesVector), e, integration_order);
+        if (auto const sm = find(key))
+            return std::static_pointer_cast<ShapeMatricesVector const>(sm);
+
+        std::shared_ptr<ShapeMatricesVector const> const sm =
+            std::make_shared<ShapeMatricesVector const>(compute());
+        // Another thread might have inserted the same shape meanwhile; the
+        // first inserted shape matrices are returned.
+        return std::static_pointer_cast<ShapeMatricesVector const>(
+            insert(std::move(key), sm));
+    }
+
+    /// Number of distinct shape matrix sets stored.
+    std::size_t size() const;
+
+private:
+    struct Key
+    {
+        std::type_index shape_matrices_type;
+        std::type_index element_type;
+        unsigned integration_order;
+        /// Truncated bit patterns of the node coordinates relative to the
+        /// first node.
+        std::vector<std::uint64_t> offsets;
+
+        bool operator==(Key const& other) const
+        {
+            return shape_matrices_type == other.shape_matrices_type &&
+                   element_type == other.element_type &&
+                   integration_order == other.integration_order &&
+                   offsets == other.offsets;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    static Key makeKey(std::type_index const shape_matrices_type,
+                       MeshLib::Element const& e,
+                       unsigned const integration_order);
+
+    std::shared_ptr<void const> find(Key const& key) const;
+
+    /// Inserts the shape matrices unless the key is already present, and
+    /// returns the stored shape matrices.
+    std::shared_ptr<void const> insert(Key&& key,
+                                       std::shared_ptr<void const> const& sm);
+
+private:
+    mutable std::mutex _mutex;
+    std::unordered_map<Key, std::shared_ptr<void const>, KeyHash>
+        _shape_matrices;
+};
+
+}   // namespace NumLib
+
+#endif  // NUMLIB_SHAPEMATRICESCACHE_H_
@@ -15,6 +15,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+#include "logog/include/logog.hpp"
 
 namespace NumLib
 {
@@ -30,6 +34,53 @@ IterationNumberBasedAdaptiveTimeStepping::IterationNumberBasedAdaptiveTimeSteppi
     assert(iter_times_vector.size() == multiplier_vector.size());
 }
 
+namespace
+{
+template <typename T>
+std::vector<T> parseList(std::string const& str)
+{
+    std::istringstream is(str);
+    std::vector<T> values;
+    T value;
+    while (is >> value)
+        values.push_back(value);
+    if (!is.eof())
+    {
+        ERR("Could not parse the list '%s'.", str.c_str());
+        std::abort();
+    }
+    return values;
+}
+}   // namespace
+
+IterationNumberBasedAdaptiveTimeStepping*
+IterationNumberBasedAdaptiveTimeStepping::newInstance(
+    BaseLib::ConfigTree const& config)
+{
+    config.checkConfParam("type", "IterationNumberBasedAdaptiveTimeStepping");
+
+    auto const t_initial  = config.getConfParam<double>("t_initial");
+    auto const t_end      = config.getConfParam<double>("t_end");
+    auto const min_dt     = config.getConfParam<double>("min_dt");
+    auto const max_dt     = config.getConfParam<double>("max_dt");
+    auto const initial_dt = config.getConfParam<double>("initial_dt");
+
+    auto const number_iterations = parseList<std::size_t>(
+        config.getConfParam<std::string>("number_iterations"));
+    auto const multiplier = parseList<double>(
+        config.getConfParam<std::string>("multiplier"));
+
+    if (number_iterations.size() != multiplier.size())
+    {
+        ERR("The numbers of iteration numbers and multipliers differ.");
+        std::abort();
+    }
+
+    return new IterationNumberBasedAdaptiveTimeStepping(
+        t_initial, t_end, min_dt, max_dt, initial_dt, number_iterations,
+        multiplier);
+}
+
 bool IterationNumberBasedAdaptiveTimeStepping::next()
 {
     // check current time step
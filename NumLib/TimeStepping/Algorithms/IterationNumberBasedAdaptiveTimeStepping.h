@@ -14,6 +14,7 @@
 
 #include <vector>
 
+#include "BaseLib/ConfigTree.h"
 #include "ITimeStepAlgorithm.h"
 
 namespace NumLib
@@ -85,6 +86,27 @@ public:
 
     virtual ~IterationNumberBasedAdaptiveTimeStepping() {}
 
+    /**
+     * @brief Create timestepper from the given configuration
+     *
+     * The iteration numbers and the multipliers are given as whitespace
+     * separated lists:
+     * \code
+     *     <time_stepping>
+     *         <type>IterationNumberBasedAdaptiveTimeStepping</type>
+     *         <t_initial>0</t_initial>
+     *         <t_end>100</t_end>
+     *         <min_dt>0.1</min_dt>
+     *         <max_dt>10</max_dt>
+     *         <initial_dt>1</initial_dt>
+     *         <number_iterations>1 4 8</number_iterations>
+     *         <multiplier>2 1 0.5</multiplier>
+     *     </time_stepping>
+     * \endcode
+     */
+    static IterationNumberBasedAdaptiveTimeStepping* newInstance(
+        BaseLib::ConfigTree const& config);
+
     /// return the beginning of time steps
     virtual double begin() const {return _t_initial;}
 
@@ -0,0 +1,432 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef PROCESS_LIB_GROUNDWATERFLOW_BATCHEDFEM_H_
+#define PROCESS_LIB_GROUNDWATERFLOW_BATCHEDFEM_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include <logog/include/logog.hpp>
+
+#include "Parameter.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "MeshLib/Elements/Elements.h"
+#include "NumLib/Fem/FiniteElement/TemplateIsoparametric.h"
+#include "NumLib/Fem/Integration/GaussIntegrationPolicy.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex20.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex8.h"
+#include "NumLib/Fem/ShapeFunction/ShapeLine2.h"
+#include "NumLib/Fem/ShapeFunction/ShapeLine3.h"
+#include "NumLib/Fem/ShapeFunction/ShapePrism15.h"
+#include "NumLib/Fem/ShapeFunction/ShapePrism6.h"
+#include "NumLib/Fem/ShapeFunction/ShapePyra13.h"
+#include "NumLib/Fem/ShapeFunction/ShapePyra5.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad8.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad9.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTet10.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTet4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri3.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri6.h"
+#include "NumLib/Fem/ShapeFunctionTable.h"
+#include "NumLib/Fem/ShapeMatrixPolicy.h"
+
+namespace ProcessLib
+{
+
+namespace GroundwaterFlow
+{
+
+/// Assembles the local matrices of many elements of the same type at once.
+///
+/// The element data is stored in structure-of-arrays layout: the elements are
+/// grouped into batches of \c BatchSize elements, and each value, e.g. a shape
+/// function derivative at an integration point, is stored contiguously for
+/// all elements of a batch. The innermost loops of the assembly run over the
+/// elements of a batch with a compile-time trip count, which the compiler
+/// vectorizes. The last batch is padded with zero weights.
+///
+/// The local matrices are the same as computed by LocalAssemblerData.
+template <typename ShapeFunction_,
+         typename IntegrationMethod_,
+         unsigned GlobalDim,
+         unsigned BatchSize = 8>
+class BatchedLocalAssemblerData
+{
+public:
+    using ShapeFunction = ShapeFunction_;
+    using ShapeMatricesType = ShapeMatrixPolicyType<ShapeFunction, GlobalDim>;
+    using ShapeMatrices = typename ShapeMatricesType::ShapeMatrices;
+
+    static unsigned const NPOINTS = ShapeFunction::NPOINTS;
+
+    /// Read-only view of the local matrix of one element in the batched
+    /// storage, which can be added to the global matrix directly.
+    class LocalMatrix
+    {
+    public:
+        explicit LocalMatrix(double const* data) : _data(data) {}
+
+        double operator()(std::size_t const i, std::size_t const j) const
+        {
+            return _data[(i * NPOINTS + j) * BatchSize];
+        }
+
+        std::size_t rows() const { return NPOINTS; }
+        std::size_t cols() const { return NPOINTS; }
+
+    private:
+        double const* _data;
+    };
+
+    /// Computes the shape function derivatives of the given elements, which
+    /// all have to be of the mesh element type of the ShapeFunction.
+    /// The hydraulic conductivity is evaluated on each assembly.
+    BatchedLocalAssemblerData(
+        std::vector<MeshLib::Element const*> const& elements,
+        Parameter<double, MeshLib::Element const&> const&
+            hydraulic_conductivity,
+        unsigned const integration_order)
+        : _elements(elements),
+          _hydraulic_conductivity(hydraulic_conductivity),
+          _n_batches((elements.size() + BatchSize - 1) / BatchSize)
+    {
+        using FemType = NumLib::TemplateIsoparametric<
+            ShapeFunction, ShapeMatricesType>;
+
+        IntegrationMethod_ integration_method(integration_order);
+        _n_integration_points = integration_method.getNPoints();
+
+        _dNdx.assign(
+            _n_batches * _n_integration_points * GlobalDim * NPOINTS * BatchSize,
+            0.0);
+        _weights.assign(_n_batches * _n_integration_points * BatchSize, 0.0);
+        _local_matrices.assign(_n_batches * NPOINTS * NPOINTS * BatchSize, 0.0);
+
+        auto const& shape_function_values = NumLib::ShapeFunctionTable<
+            ShapeFunction, IntegrationMethod_>::get(integration_order);
+
+        std::vector<ShapeMatrices> shape_matrices(
+            _n_integration_points,
+            ShapeMatrices(ShapeFunction::DIM, GlobalDim, NPOINTS));
+        for (std::size_t i = 0; i < _elements.size(); ++i)
+        {
+            FemType fe(*static_cast<const typename ShapeFunction::MeshElement*>(
+                _elements[i]));
+            std::size_t const batch = i / BatchSize;
+            std::size_t const lane = i % BatchSize;
+
+            // The Jacobian is computed once for affine elements.
+            for (auto& sm : shape_matrices)
+                sm.setZero();
+            fe.computeShapeFunctions(shape_function_values, shape_matrices);
+
+            for (unsigned ip = 0; ip < _n_integration_points; ++ip)
+            {
+                auto const& wp = integration_method.getWeightedPoint(ip);
+                auto const& sm = shape_matrices[ip];
+
+                std::size_t const batch_ip = batch * _n_integration_points + ip;
+                _weights[batch_ip * BatchSize + lane] =
+                    sm.detJ * wp.getWeight();
+                for (unsigned d = 0; d < GlobalDim; ++d)
+                    for (unsigned a = 0; a < NPOINTS; ++a)
+                        _dNdx[((batch_ip * GlobalDim + d) * NPOINTS + a) *
+                                  BatchSize + lane] = sm.dNdx(d, a);
+            }
+        }
+    }
+
+    /// Number of elements.
+    std::size_t size() const { return _elements.size(); }
+
+    /// Computes the local matrices of all elements; the batches are processed
+    /// in parallel if OpenMP is enabled.
+    void assemble()
+    {
+        OPENMP_LOOP_TYPE const n = _n_batches;
+        #pragma omp parallel for
+        for (OPENMP_LOOP_TYPE batch = 0; batch < n; batch++)
+            assembleBatch(batch);
+    }
+
+    /// Returns the local matrix of the i-th element as computed by the last
+    /// call of assemble().
+    LocalMatrix getLocalMatrix(std::size_t const i) const
+    {
+        assert(i < size());
+        return LocalMatrix(_local_matrices.data() +
+                           (i / BatchSize) * NPOINTS * NPOINTS * BatchSize +
+                           i % BatchSize);
+    }
+
+    /// Adds the local matrix of the i-th element to the global matrix.
+    template <typename GlobalMatrix>
+    void addToGlobal(
+        std::size_t const i, GlobalMatrix& A,
+        AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices)
+        const
+    {
+        A.add(indices, getLocalMatrix(i));
+    }
+
+private:
+    void assembleBatch(std::size_t const batch)
+    {
+        double* const K = &_local_matrices[batch * NPOINTS * NPOINTS * BatchSize];
+        std::fill_n(K, NPOINTS * NPOINTS * BatchSize, 0.0);
+
+        // Padding lanes get a zero conductivity.
+        std::size_t const first = batch * BatchSize;
+        std::size_t const n_lanes =
+            std::min<std::size_t>(BatchSize, size() - first);
+        double k[BatchSize] = {};
+        _hydraulic_conductivity.evaluate(&_elements[first], n_lanes, k);
+
+        for (unsigned ip = 0; ip < _n_integration_points; ++ip)
+        {
+            std::size_t const batch_ip = batch * _n_integration_points + ip;
+            double const* const dNdx =
+                &_dNdx[batch_ip * GlobalDim * NPOINTS * BatchSize];
+            double const* const weights = &_weights[batch_ip * BatchSize];
+
+            double w[BatchSize];
+            for (unsigned lane = 0; lane < BatchSize; ++lane)
+                w[lane] = k[lane] * weights[lane];
+
+            // Upper triangle of dNdx^T k dNdx detJ w.
+            for (unsigned a = 0; a < NPOINTS; ++a)
+                for (unsigned b = a; b < NPOINTS; ++b)
+                {
+                    double* const K_ab = K + (a * NPOINTS + b) * BatchSize;
+                    for (unsigned d = 0; d < GlobalDim; ++d)
+                    {
+                        double const* const dN_a =
+                            dNdx + (d * NPOINTS + a) * BatchSize;
+                        double const* const dN_b =
+                            dNdx + (d * NPOINTS + b) * BatchSize;
+                        for (unsigned lane = 0; lane < BatchSize; ++lane)
+                            K_ab[lane] += dN_a[lane] * dN_b[lane] * w[lane];
+                    }
+                }
+        }
+
+        // The local matrices are symmetric.
+        for (unsigned a = 1; a < NPOINTS; ++a)
+            for (unsigned b = 0; b < a; ++b)
+                std::copy_n(K + (b * NPOINTS + a) * BatchSize, BatchSize,
+                            K + (a * NPOINTS + b) * BatchSize);
+    }
+
+private:
+    std::vector<MeshLib::Element const*> const _elements;
+    Parameter<double, MeshLib::Element const&> const& _hydraulic_conductivity;
+
+    std::size_t const _n_batches;
+    unsigned _n_integration_points = 0;
+
+    /// Shape function derivatives dNdx(d, a) indexed by
+    /// [batch][integration point][d][a][lane].
+    std::vector<double> _dNdx;
+
+    /// Products of the Jacobian determinant and the integration weight indexed
+    /// by [batch][integration point][lane].
+    std::vector<double> _weights;
+
+    /// Local matrices indexed by [batch][row][column][lane].
+    std::vector<double> _local_matrices;
+};
+
+/// The batched local assemblers of all elements of a mesh, one
+/// BatchedLocalAssemblerData for each element type. The elements are
+/// addressed by their index in the mesh, which is also the index in the
+/// LocalToGlobalIndexMap.
+template <typename GlobalMatrix>
+class BatchedLocalAssemblers
+{
+public:
+    /// Groups the elements by their type and computes the shape function
+    /// derivatives of each group.
+    template <unsigned GlobalDim>
+    void initialize(
+        std::vector<MeshLib::Element*> const& elements,
+        Parameter<double, MeshLib::Element const&> const&
+            hydraulic_conductivity,
+        unsigned const integration_order)
+    {
+        // Within a group the elements are kept in mesh order.
+        std::vector<std::type_index> types;
+        std::vector<std::vector<MeshLib::Element const*>> groups;
+        _positions.resize(elements.size());
+        for (std::size_t id = 0; id < elements.size(); ++id)
+        {
+            std::type_index const type(typeid(*elements[id]));
+            std::size_t const group =
+                std::find(types.cbegin(), types.cend(), type) - types.cbegin();
+            if (group == types.size())
+            {
+                types.push_back(type);
+                groups.emplace_back();
+            }
+            _positions[id] = Position{group, groups[group].size()};
+            groups[group].push_back(elements[id]);
+        }
+
+        auto const builder = createBuilder<GlobalDim>();
+        _groups.clear();
+        for (std::size_t group = 0; group < types.size(); ++group)
+        {
+            auto const it = builder.find(types[group]);
+            if (it == builder.end())
+            {
+                ERR("No batched local assembler for the element type %s.",
+                    types[group].name());
+                std::abort();
+            }
+            _groups.emplace_back(it->second(
+                groups[group], hydraulic_conductivity, integration_order));
+        }
+    }
+
+    /// Computes the local matrices of all elements.
+    void assemble()
+    {
+        for (auto& group : _groups)
+            group->assemble();
+    }
+
+    /// Adds the local matrix of the element with the given index, as computed
+    /// by the last call of assemble(), to the global matrix.
+    void addToGlobal(
+        std::size_t const id, GlobalMatrix& A,
+        AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices)
+        const
+    {
+        assert(id < _positions.size());
+        auto const& position = _positions[id];
+        _groups[position.group]->addToGlobal(position.index, A, indices);
+    }
+
+private:
+    /// Type-independent interface of the BatchedLocalAssemblerData.
+    class Group
+    {
+    public:
+        virtual ~Group() = default;
+
+        virtual void assemble() = 0;
+
+        virtual void addToGlobal(
+            std::size_t const i, GlobalMatrix& A,
+            AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const&
+                indices) const = 0;
+    };
+
+    template <typename ShapeFunction_, unsigned GlobalDim>
+    class GroupImpl final : public Group
+    {
+        using IntegrationMethod = typename NumLib::GaussIntegrationPolicy<
+            typename ShapeFunction_::MeshElement>::IntegrationMethod;
+
+    public:
+        GroupImpl(std::vector<MeshLib::Element const*> const& elements,
+                  Parameter<double, MeshLib::Element const&> const&
+                      hydraulic_conductivity,
+                  unsigned const integration_order)
+            : _data(elements, hydraulic_conductivity, integration_order)
+        {
+        }
+
+        void assemble() override { _data.assemble(); }
+
+        void addToGlobal(
+            std::size_t const i, GlobalMatrix& A,
+            AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const&
+                indices) const override
+        {
+            _data.addToGlobal(i, A, indices);
+        }
+
+    private:
+        BatchedLocalAssemblerData<ShapeFunction_, IntegrationMethod, GlobalDim>
+            _data;
+    };
+
+    using GroupCreator = std::function<std::unique_ptr<Group>(
+        std::vector<MeshLib::Element const*> const&,
+        Parameter<double, MeshLib::Element const&> const&, unsigned)>;
+    using Builder = std::unordered_map<std::type_index, GroupCreator>;
+
+    template <typename MeshElement, typename ShapeFunction_,
+              unsigned GlobalDim>
+    static void addElementType(Builder& builder)
+    {
+        builder[std::type_index(typeid(MeshElement))] =
+            [](std::vector<MeshLib::Element const*> const& elements,
+               Parameter<double, MeshLib::Element const&> const&
+                   hydraulic_conductivity,
+               unsigned const integration_order)
+        {
+            return std::unique_ptr<Group>(
+                new GroupImpl<ShapeFunction_, GlobalDim>(
+                    elements, hydraulic_conductivity, integration_order));
+        };
+    }
+
+    /// Mapping of element types to batched local assembler constructors.
+    template <unsigned GlobalDim>
+    static Builder createBuilder()
+    {
+        Builder builder;
+        addElementType<MeshLib::Hex20, NumLib::ShapeHex20, GlobalDim>(builder);
+        addElementType<MeshLib::Hex, NumLib::ShapeHex8, GlobalDim>(builder);
+        addElementType<MeshLib::Line, NumLib::ShapeLine2, GlobalDim>(builder);
+        addElementType<MeshLib::Line3, NumLib::ShapeLine3, GlobalDim>(builder);
+        addElementType<MeshLib::Prism15, NumLib::ShapePrism15, GlobalDim>(
+            builder);
+        addElementType<MeshLib::Prism, NumLib::ShapePrism6, GlobalDim>(builder);
+        addElementType<MeshLib::Pyramid13, NumLib::ShapePyra13, GlobalDim>(
+            builder);
+        addElementType<MeshLib::Pyramid, NumLib::ShapePyra5, GlobalDim>(
+            builder);
+        addElementType<MeshLib::Quad, NumLib::ShapeQuad4, GlobalDim>(builder);
+        addElementType<MeshLib::Quad8, NumLib::ShapeQuad8, GlobalDim>(builder);
+        addElementType<MeshLib::Quad9, NumLib::ShapeQuad9, GlobalDim>(builder);
+        addElementType<MeshLib::Tet10, NumLib::ShapeTet10, GlobalDim>(builder);
+        addElementType<MeshLib::Tet, NumLib::ShapeTet4, GlobalDim>(builder);
+        addElementType<MeshLib::Tri, NumLib::ShapeTri3, GlobalDim>(builder);
+        addElementType<MeshLib::Tri6, NumLib::ShapeTri6, GlobalDim>(builder);
+        return builder;
+    }
+
+    /// Position of an element in the batched local assemblers.
+    struct Position
+    {
+        std::size_t group;
+        std::size_t index;
+    };
+
+    std::vector<std::unique_ptr<Group>> _groups;
+
+    /// Positions of the elements indexed by the element's index in the mesh.
+    std::vector<Position> _positions;
+};
+
+}   // namespace GroundwaterFlow
+}   // namespace ProcessLib
+
+#endif  // PROCESS_LIB_GROUNDWATERFLOW_BATCHEDFEM_H_
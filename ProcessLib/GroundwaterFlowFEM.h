@@ -10,11 +10,17 @@
 #ifndef PROCESS_LIB_GROUNDWATERFLOW_FEM_H_
 #define PROCESS_LIB_GROUNDWATERFLOW_FEM_H_
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include "Parameter.h"
+#include "AssemblerLib/GlobalMatrixTriplets.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MatrixFreeOperator.h"
 #include "NumLib/Fem/FiniteElement/TemplateIsoparametric.h"
+#include "NumLib/Fem/ShapeFunctionTable.h"
+#include "NumLib/Fem/ShapeMatricesCache.h"
 #include "NumLib/Fem/ShapeMatrixPolicy.h"
 
 namespace ProcessLib
@@ -25,6 +31,7 @@ namespace GroundwaterFlow
 
 template <typename GlobalMatrix, typename GlobalVector>
 class LocalAssemblerDataInterface
+    : public AssemblerLib::MatrixFreeLocalAssembler
 {
 public:
     virtual ~LocalAssemblerDataInterface() = default;
@@ -32,13 +39,28 @@ public:
     virtual void init(MeshLib::Element const& e,
             std::size_t const local_matrix_size,
             Parameter<double, MeshLib::Element const&> const& hydraulic_conductivity,
-            unsigned const integration_order) = 0;
+            unsigned const integration_order,
+            NumLib::ShapeMatricesCache* const shape_matrices_cache,
+            Parameter<double, MeshLib::Element const&> const* const storage) = 0;
 
     virtual void assemble(std::vector<double> const& local_x,
                           std::vector<double> const& local_x_prev_ts) = 0;
 
     virtual void addToGlobal(GlobalMatrix& A, GlobalVector& rhs,
             AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const&) const = 0;
+
+    /// Adds the storage matrix, the conductivity matrix, and the vector
+    /// separately; used for transient problems, see
+    /// AssemblerLib::MassStiffnessMatrixAssembler.
+    virtual void addToGlobal(GlobalMatrix& M, GlobalMatrix& K,
+            GlobalVector& rhs,
+            AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const&) const = 0;
+
+    /// Appends the matrix and the vector of the mesh item \c id to the
+    /// triplets; see AssemblerLib::TripletMatrixAssembler.
+    virtual void addToGlobal(AssemblerLib::GlobalMatrixTriplets& triplets,
+            std::size_t const id,
+            AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const&) const = 0;
 };
 
 template <typename ShapeFunction_,
@@ -57,74 +79,263 @@ public:
 
     /// The hydraulic_conductivity factor is directly integrated into the local
     /// element matrix.
+    /// If a shape_matrices_cache is given, the shape matrices are shared with
+    /// congruent elements. For linear simplices, whose shape function
+    /// gradients are constant, only one set of shape matrices is stored.
+    /// If a storage parameter is given, assemble() additionally computes the
+    /// storage matrix \f$ \int S N^T N \f$ of the transient problem.
     void init(MeshLib::Element const& e,
               std::size_t const local_matrix_size,
               Parameter<double, MeshLib::Element const&> const&
                   hydraulic_conductivity,
-              unsigned const integration_order) override
+              unsigned const integration_order,
+              NumLib::ShapeMatricesCache* const shape_matrices_cache,
+              Parameter<double, MeshLib::Element const&> const* const storage)
+        override
     {
-        using FemType = NumLib::TemplateIsoparametric<
-            ShapeFunction, ShapeMatricesType>;
+        _integration_order = integration_order;
 
-        FemType fe(*static_cast<const typename ShapeFunction::MeshElement*>(&e));
+        auto const computeShapeMatrices = [&e, integration_order]()
+        {
+            using FemType = NumLib::TemplateIsoparametric<
+                ShapeFunction, ShapeMatricesType>;
 
+            FemType fe(*static_cast<const typename ShapeFunction::MeshElement*>(&e));
 
-        _integration_order = integration_order;
-        IntegrationMethod_ integration_method(_integration_order);
-        std::size_t const n_integration_points = integration_method.getNPoints();
+            // Shape functions at the integration points are evaluated once
+            // for all elements.
+            auto const& shape_function_values = NumLib::ShapeFunctionTable<
+                ShapeFunction, IntegrationMethod_>::get(integration_order);
+            std::size_t const n_integration_points =
+                shape_function_values.size();
 
-        _shape_matrices.reserve(n_integration_points);
-        for (std::size_t ip(0); ip < n_integration_points; ip++) {
-            _shape_matrices.emplace_back(ShapeFunction::DIM, GlobalDim,
-                                         ShapeFunction::NPOINTS);
-            fe.computeShapeFunctions(
-                    integration_method.getWeightedPoint(ip).getCoords(),
-                    _shape_matrices[ip]);
-        }
+            if (constant_gradients && n_integration_points > 0)
+            {
+                std::vector<ShapeMatrices> shape_matrices(
+                    1, ShapeMatrices(ShapeFunction::DIM, GlobalDim,
+                                     ShapeFunction::NPOINTS));
+                fe.computeShapeFunctions(shape_function_values[0],
+                                         shape_matrices[0]);
+                return shape_matrices;
+            }
 
-        _hydraulic_conductivity = [&hydraulic_conductivity, &e]()
-        {
-            return hydraulic_conductivity(e);
+            std::vector<ShapeMatrices> shape_matrices(
+                n_integration_points,
+                ShapeMatrices(ShapeFunction::DIM, GlobalDim,
+                              ShapeFunction::NPOINTS));
+            fe.computeShapeFunctions(shape_function_values, shape_matrices);
+            return shape_matrices;
         };
 
-        _localA.reset(new NodalMatrixType(local_matrix_size, local_matrix_size));
-        _localRhs.reset(new NodalVectorType(local_matrix_size));
+        if (shape_matrices_cache)
+            _shape_matrices = shape_matrices_cache->get<ShapeMatrices>(
+                e, integration_order, computeShapeMatrices);
+        else
+            _shape_matrices = std::make_shared<std::vector<ShapeMatrices> const>(
+                computeShapeMatrices());
+
+        _element = &e;
+        _hydraulic_conductivity = &hydraulic_conductivity;
+        _storage = storage;
+        _local_matrix_size = local_matrix_size;
     }
 
+    /// The local matrix and vector are computed into scratch space shared by
+    /// all local assemblers of this type on the calling thread; they are valid
+    /// until the next call of assemble() on the same thread.
     void assemble(std::vector<double> const& /*local_x*/,
                   std::vector<double> const& /*local_x_prev_ts*/) override
     {
-        _localA->setZero();
-        _localRhs->setZero();
-
-        IntegrationMethod_ integration_method(_integration_order);
-        unsigned const n_integration_points = integration_method.getNPoints();
+        auto& local = getLocalData();
+        local.A.setZero(_local_matrix_size, _local_matrix_size);
+        local.rhs.setZero(_local_matrix_size);
 
-        for (std::size_t ip(0); ip < n_integration_points; ip++) {
-            auto const& sm = _shape_matrices[ip];
-            auto const& wp = integration_method.getWeightedPoint(ip);
-            _localA->noalias() += sm.dNdx.transpose() *
-                                  _hydraulic_conductivity() * sm.dNdx *
-                                  sm.detJ * wp.getWeight();
+        // Only the upper triangle of the symmetric matrix is computed; it is
+        // all a global matrix with symmetric storage reads.
+        auto const& factors = computeIntegrationFactors();
+        for (std::size_t i(0); i < factors.size(); i++) {
+            auto const& sm = (*_shape_matrices)[i];
+            local.A.template selfadjointView<Eigen::Upper>().rankUpdate(
+                sm.dNdx.transpose(), factors[i]);
         }
+        for (unsigned a = 1; a < _local_matrix_size; ++a)
+            for (unsigned b = 0; b < a; ++b)
+                local.A(a, b) = local.A(b, a);
+
+        if (_storage)
+            assembleStorageMatrix(local.M);
     }
 
+    /// Adds the local matrix and vector of the last assemble() call on the
+    /// calling thread.
     void addToGlobal(
         GlobalMatrix& A, GlobalVector& rhs,
         AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices)
         const override
     {
-        A.add(indices, *_localA);
-        rhs.add(indices.rows, *_localRhs);
+        auto const& local = getLocalData();
+        A.add(indices, local.A);
+        rhs.add(indices.rows, local.rhs);
+    }
+
+    /// Adds the storage matrix, which is zero without a storage parameter,
+    /// the conductivity matrix and the vector of the last assemble() call on
+    /// the calling thread.
+    void addToGlobal(
+        GlobalMatrix& M, GlobalMatrix& K, GlobalVector& rhs,
+        AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices)
+        const override
+    {
+        auto const& local = getLocalData();
+        if (_storage)
+            M.add(indices, local.M);
+        K.add(indices, local.A);
+        rhs.add(indices.rows, local.rhs);
+    }
+
+    /// Appends the matrix and the vector of the last assemble() call on the
+    /// calling thread to the triplets.
+    void addToGlobal(
+        AssemblerLib::GlobalMatrixTriplets& triplets, std::size_t const id,
+        AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices)
+        const override
+    {
+        auto const& local = getLocalData();
+        triplets.add(id, indices.rows, local.A, local.rhs);
+    }
+
+    /// Applies the local matrix of assemble() without computing it.
+    void applyLocalMatrix(std::vector<double> const& local_x,
+                          std::vector<double>& local_y) const override
+    {
+        std::fill(local_y.begin(), local_y.end(), 0.0);
+
+        // y += dNdx^T (k detJ w dNdx x) at each integration point.
+        auto const& factors = computeIntegrationFactors();
+        for (std::size_t i(0); i < factors.size(); i++) {
+            auto const& sm = (*_shape_matrices)[i];
+            for (unsigned d = 0; d < GlobalDim; ++d)
+            {
+                double grad = 0.0;
+                for (unsigned a = 0; a < ShapeFunction::NPOINTS; ++a)
+                    grad += sm.dNdx(d, a) * local_x[a];
+                grad *= factors[i];
+                for (unsigned a = 0; a < ShapeFunction::NPOINTS; ++a)
+                    local_y[a] += sm.dNdx(d, a) * grad;
+            }
+        }
+    }
+
+    void getLocalMatrixDiagonal(
+        std::vector<double>& local_diagonal) const override
+    {
+        std::fill(local_diagonal.begin(), local_diagonal.end(), 0.0);
+
+        auto const& factors = computeIntegrationFactors();
+        for (std::size_t i(0); i < factors.size(); i++) {
+            auto const& sm = (*_shape_matrices)[i];
+            for (unsigned d = 0; d < GlobalDim; ++d)
+                for (unsigned a = 0; a < ShapeFunction::NPOINTS; ++a)
+                    local_diagonal[a] +=
+                        factors[i] * sm.dNdx(d, a) * sm.dNdx(d, a);
+        }
+    }
+
+    /// Shape matrices at the integration points, possibly shared with other
+    /// local assemblers. For constant shape function gradients there is a
+    /// single entry valid for all integration points except for N.
+    std::vector<ShapeMatrices> const& getShapeMatrices() const
+    {
+        return *_shape_matrices;
     }
 
 private:
-    std::vector<ShapeMatrices> _shape_matrices;
-    std::function<double(void)> _hydraulic_conductivity;
+    struct LocalData
+    {
+        NodalMatrixType A;
+        /// Storage matrix.
+        NodalMatrixType M;
+        NodalVectorType rhs;
+        /// Hydraulic conductivity at the integration points.
+        std::vector<double> hydraulic_conductivity;
+        /// Storage at the integration points.
+        std::vector<double> storage;
+        /// See computeIntegrationFactors().
+        std::vector<double> integration_factors;
+    };
+
+    /// Per-thread local matrix and vector, allocated on first use.
+    static LocalData& getLocalData()
+    {
+        static thread_local LocalData local_data;
+        return local_data;
+    }
+
+    /// Computes k detJ w for each of the stored shape matrices. With constant
+    /// gradients the factors of all integration points are summed up for the
+    /// single shape matrices set. The result is valid until the next call on
+    /// the same thread.
+    std::vector<double> const& computeIntegrationFactors() const
+    {
+        IntegrationMethod_ integration_method(_integration_order);
+        unsigned const n_integration_points = integration_method.getNPoints();
 
-    std::unique_ptr<NodalMatrixType> _localA;
-    std::unique_ptr<NodalVectorType> _localRhs;
+        auto& local = getLocalData();
+        auto& k = local.hydraulic_conductivity;
+        k.resize(n_integration_points);
+        _hydraulic_conductivity->evaluate(*_element, n_integration_points,
+                                          k.data());
+
+        auto& factors = local.integration_factors;
+        factors.assign(_shape_matrices->size(), 0.0);
+        for (std::size_t ip(0); ip < n_integration_points; ip++) {
+            std::size_t const i = constant_gradients ? 0 : ip;
+            auto const& wp = integration_method.getWeightedPoint(ip);
+            factors[i] += k[ip] * (*_shape_matrices)[i].detJ * wp.getWeight();
+        }
+        return factors;
+    }
+
+    /// Computes the storage matrix into \c M. The shape functions are taken
+    /// from the table since for constant gradients not all integration
+    /// points' shape matrices are stored; detJ is the same for all of them
+    /// then.
+    void assembleStorageMatrix(NodalMatrixType& M) const
+    {
+        IntegrationMethod_ integration_method(_integration_order);
+        unsigned const n_integration_points = integration_method.getNPoints();
+        auto const& shape_function_values = NumLib::ShapeFunctionTable<
+            ShapeFunction, IntegrationMethod_>::get(_integration_order);
+
+        auto& s = getLocalData().storage;
+        s.resize(n_integration_points);
+        _storage->evaluate(*_element, n_integration_points, s.data());
+
+        M.setZero(_local_matrix_size, _local_matrix_size);
+        for (std::size_t ip(0); ip < n_integration_points; ip++) {
+            auto const& N = shape_function_values[ip].N;
+            auto const& sm = (*_shape_matrices)[constant_gradients ? 0 : ip];
+            double const factor =
+                s[ip] * sm.detJ *
+                integration_method.getWeightedPoint(ip).getWeight();
+            for (unsigned a = 0; a < ShapeFunction::NPOINTS; ++a)
+                for (unsigned b = 0; b < ShapeFunction::NPOINTS; ++b)
+                    M(a, b) += factor * N[a] * N[b];
+        }
+    }
+
+    static constexpr bool constant_gradients =
+        NumLib::ShapeFunctionGradientsAreConstant<ShapeFunction>::value;
+
+private:
+    std::shared_ptr<std::vector<ShapeMatrices> const> _shape_matrices;
+    MeshLib::Element const* _element = nullptr;
+    Parameter<double, MeshLib::Element const&> const* _hydraulic_conductivity =
+        nullptr;
+    /// Storage if the problem is transient, nullptr otherwise.
+    Parameter<double, MeshLib::Element const&> const* _storage = nullptr;
 
+    unsigned _local_matrix_size = 0;
     unsigned _integration_order = 2;
 };
 
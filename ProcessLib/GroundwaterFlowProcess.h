@@ -16,7 +16,9 @@
 
 #include "AssemblerLib/LocalAssemblerBuilder.h"
 #include "AssemblerLib/LocalDataInitializer.h"
+#include "NumLib/Fem/ShapeMatricesCache.h"
 
+#include "GroundwaterFlowBatchedFEM.h"
 #include "GroundwaterFlowFEM.h"
 #include "Process.h"
 
@@ -39,22 +41,55 @@ public:
         ProcessVariable& variable,
         Parameter<double, MeshLib::Element const&> const&
             hydraulic_conductivity,
-        boost::optional<BaseLib::ConfigTree>&& linear_solver_options)
+        boost::optional<BaseLib::ConfigTree>&& linear_solver_options,
+        bool const time_invariant_system,
+        bool const share_shape_matrices,
+        boost::optional<MatrixFreeSolverOptions> const& matrix_free_options,
+        Parameter<double, MeshLib::Element const&> const* const storage,
+        double const theta,
+        bool const symmetric_matrix,
+        bool const triplet_assembly,
+        bool const batched_assembly)
         : Process<GlobalSetup>(mesh),
-          _hydraulic_conductivity(hydraulic_conductivity)
+          _hydraulic_conductivity(hydraulic_conductivity),
+          _storage(storage),
+          _share_shape_matrices(share_shape_matrices),
+          _batched_assembly(batched_assembly)
     {
+        if (_batched_assembly &&
+            (matrix_free_options || _storage || triplet_assembly))
+        {
+            ERR("The batched assembly supports neither the matrix-free nor "
+                "the transient mode nor the triplet assembly.");
+            std::abort();
+        }
+
         this->_process_variables.emplace_back(variable);
         if (linear_solver_options)
             Process<GlobalSetup>::setLinearSolverOptions(
                 std::move(*linear_solver_options));
+        Process<GlobalSetup>::setTimeInvariantSystem(time_invariant_system);
+        if (matrix_free_options)
+            Process<GlobalSetup>::setMatrixFree(*matrix_free_options);
+        if (_storage)
+            Process<GlobalSetup>::setTransient(theta);
+        Process<GlobalSetup>::setSymmetricMatrix(symmetric_matrix);
+        Process<GlobalSetup>::setTripletAssembly(triplet_assembly);
     }
 
     template <unsigned GlobalDim>
     void createLocalAssemblers()
     {
+        if (_batched_assembly)
+        {
+            DBUG("Create batched local assemblers.");
+            _batched_local_assemblers.template initialize<GlobalDim>(
+                this->_mesh.getElements(), _hydraulic_conductivity,
+                this->_integration_order);
+            return;
+        }
+
         DBUG("Create local assemblers.");
-        // Populate the vector of local assemblers.
-        _local_assemblers.resize(this->_mesh.getNElements());
         // Shape matrices initializer
         using LocalDataInitializer = AssemblerLib::LocalDataInitializer<
             GroundwaterFlow::LocalAssemblerDataInterface,
@@ -65,6 +100,12 @@ public:
 
         LocalDataInitializer initializer;
 
+        // Populate the vector of local assemblers; the local assemblers of
+        // the same element type are stored contiguously in element order.
+        _local_assembler_arena.clear();
+        initializer.allocate(this->_mesh.getElements(), _local_assemblers,
+                             _local_assembler_arena);
+
         using LocalAssemblerBuilder =
             AssemblerLib::LocalAssemblerBuilder<
                 MeshLib::Element,
@@ -73,13 +114,26 @@ public:
         LocalAssemblerBuilder local_asm_builder(
             initializer, *this->_local_to_global_index_map);
 
+        // The cache is only needed during the construction; the shape
+        // matrices are owned by the local assemblers.
+        std::unique_ptr<NumLib::ShapeMatricesCache> shape_matrices_cache;
+        if (_share_shape_matrices)
+            shape_matrices_cache.reset(new NumLib::ShapeMatricesCache);
+
         DBUG("Calling local assembler builder for all mesh elements.");
         this->_global_setup.execute(
                 local_asm_builder,
                 this->_mesh.getElements(),
                 _local_assemblers,
                 _hydraulic_conductivity,
-                this->_integration_order);
+                this->_integration_order,
+                shape_matrices_cache.get(),
+                _storage);
+
+        if (shape_matrices_cache)
+            DBUG("Shared %u distinct shape matrix sets among %u elements.",
+                 static_cast<unsigned>(shape_matrices_cache->size()),
+                 static_cast<unsigned>(this->_mesh.getNElements()));
     }
 
     std::string getLinearSolverName() const override
@@ -106,24 +160,91 @@ public:
         *this->_rhs = 0;   // This resets the whole vector.
 
         // Call global assembler for each local assembly item.
-        this->_global_setup.execute(*this->_global_assembler,
-                                    _local_assemblers);
+        if (_batched_assembly)
+            assembleBatched();
+        else if (this->_triplet_assembler)
+        {
+            this->_triplet_assembler->clear();
+            this->_global_setup.executeColored(this->_element_coloring,
+                                               *this->_triplet_assembler,
+                                               _local_assemblers);
+            this->_triplet_assembler->setGlobal();
+        }
+        else
+        {
+            this->_global_setup.executeColored(this->_element_coloring,
+                                               *this->_global_assembler,
+                                               _local_assemblers);
+        }
 
         return true;
     }
 
-    ~GroundwaterFlowProcess()
+    void assembleMassAndStiffness() override
+    {
+        DBUG("Assemble storage and conductivity matrices of "
+             "GroundwaterFlowProcess.");
+
+        this->_global_setup.executeColored(this->_element_coloring,
+                                           *this->_mass_stiffness_assembler,
+                                           _local_assemblers);
+    }
+
+    std::vector<AssemblerLib::MatrixFreeLocalAssembler const*>
+    getMatrixFreeLocalAssemblers() const override
+    {
+        return {_local_assemblers.cbegin(), _local_assemblers.cend()};
+    }
+
+private:
+    /// Computes the local matrices of all elements at once and adds them to
+    /// the global matrix. The right-hand-side is zero apart from the
+    /// boundary conditions.
+    void assembleBatched()
     {
-        for (auto p : _local_assemblers)
-            delete p;
+        _batched_local_assemblers.assemble();
+
+        auto& A = *this->_A;
+        auto const& dof_table = *this->_local_to_global_index_map;
+        auto const* const scatter_map =
+            this->_scatter_map.empty() ? nullptr : &this->_scatter_map;
+        auto const add_local_matrix =
+            [&](std::size_t const id, MeshLib::Element const* /*element*/)
+        {
+            auto const indices = dof_table(id).rows;
+            _batched_local_assemblers.addToGlobal(
+                id, A,
+                AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices(
+                    indices, indices,
+                    scatter_map ? scatter_map->getPositions(id) : nullptr));
+        };
+        this->_global_setup.executeColored(this->_element_coloring,
+                                           add_local_matrix,
+                                           this->_mesh.getElements());
     }
 
 private:
     Parameter<double, MeshLib::Element const&> const& _hydraulic_conductivity;
 
+    /// Specific storage; nullptr for the steady-state equation.
+    Parameter<double, MeshLib::Element const&> const* const _storage;
+
+    /// Share the shape matrices among geometrically congruent elements.
+    bool const _share_shape_matrices;
+
+    /// Assemble the local matrices of the elements of the same type in
+    /// batches instead of element by element.
+    bool const _batched_assembly;
+
+    /// Storage of the batched local assemblers.
+    GroundwaterFlow::BatchedLocalAssemblers<typename GlobalSetup::MatrixType>
+        _batched_local_assemblers;
+
     using LocalAssembler = GroundwaterFlow::LocalAssemblerDataInterface<
         typename GlobalSetup::MatrixType, typename GlobalSetup::VectorType>;
 
+    /// Storage of the local assemblers.
+    AssemblerLib::LocalAssemblerArena<LocalAssembler> _local_assembler_arena;
     std::vector<LocalAssembler*> _local_assemblers;
 };
 
@@ -156,10 +277,76 @@ createGroundwaterFlowProcess(
     // Linear solver options
     auto linear_solver_options = config.getConfSubtreeOptional("linear_solver");
 
+    // The steady-state equation depends neither on time nor on the solution
+    // as long as the hydraulic conductivity does not; then the system matrix
+    // can be assembled only once. Off by default, i.e. the system is
+    // assembled in each time step.
+    auto const time_invariant_system =
+        config.getConfParam<bool>("time_invariant_system", false);
+    DBUG("Time-invariant system: %s.", time_invariant_system ? "yes" : "no");
+
+    // On structured meshes many elements are equal up to translation and can
+    // share their shape matrices.
+    auto const share_shape_matrices =
+        config.getConfParam<bool>("share_shape_matrices", false);
+    DBUG("Share shape matrices: %s.", share_shape_matrices ? "yes" : "no");
+
+    // Without assembling the global matrix the system is solved by an
+    // iterative solver applying the element matrices.
+    boost::optional<MatrixFreeSolverOptions> matrix_free_options;
+    if (auto const matrix_free_config =
+            config.getConfSubtreeOptional("matrix_free"))
+        matrix_free_options =
+            createMatrixFreeSolverOptions(*matrix_free_config);
+    DBUG("Matrix-free: %s.", matrix_free_options ? "yes" : "no");
+
+    // With a storage parameter the transient equation is solved by the
+    // theta-method; theta = 1 is the implicit Euler method.
+    Parameter<double, MeshLib::Element const&> const* storage = nullptr;
+    if (auto const storage_name =
+            config.getConfParamOptional<std::string>("storage"))
+    {
+        storage = &findParameter<double, MeshLib::Element const&>(
+            *storage_name, parameters);
+        DBUG("Use \'%s\' as storage parameter.", storage->name.c_str());
+    }
+    auto const theta = config.getConfParam<double>("theta", 1.0);
+    if (theta < 0.0 || theta > 1.0)
+    {
+        ERR("The time discretization parameter theta = %g is not in [0, 1].",
+            theta);
+        std::abort();
+    }
+
+    // The system matrix is symmetric; with symmetric storage only its upper
+    // triangle is stored and assembled.
+    auto const symmetric_matrix =
+        config.getConfParam<bool>("symmetric_matrix", false);
+    DBUG("Symmetric matrix storage: %s.", symmetric_matrix ? "yes" : "no");
+
+    // The element matrices are collected as triplets per thread and summed
+    // after the element loop, independently of the number of threads.
+    auto const triplet_assembly =
+        config.getConfParam<bool>("triplet_assembly", false);
+    DBUG("Triplet assembly: %s.", triplet_assembly ? "yes" : "no");
+
+    // The local matrices of the elements of the same type are computed in
+    // batches, which the compiler vectorizes over the elements.
+    auto const batched_assembly =
+        config.getConfParam<bool>("batched_assembly", false);
+    DBUG("Batched assembly: %s.", batched_assembly ? "yes" : "no");
+
     return std::unique_ptr<GroundwaterFlowProcess<GlobalSetup>>{
         new GroundwaterFlowProcess<GlobalSetup>{mesh, process_variable,
                                                 hydraulic_conductivity,
-                                                std::move(linear_solver_options)}};
+                                                std::move(linear_solver_options),
+                                                time_invariant_system,
+                                                share_shape_matrices,
+                                                matrix_free_options,
+                                                storage, theta,
+                                                symmetric_matrix,
+                                                triplet_assembly,
+                                                batched_assembly}};
 }
 }   // namespace ProcessLib
 
@@ -35,6 +35,8 @@ std::unique_ptr<InitialCondition> createUniformInitialCondition(
 std::unique_ptr<InitialCondition> createMeshPropertyInitialCondition(
     BaseLib::ConfigTree const& config, MeshLib::Mesh const& mesh)
 {
+	config.checkConfParam("type", "MeshProperty");
+
 	auto field_name = config.getConfParam<std::string>("field_name");
 	DBUG("Using field_name %s", field_name.c_str());
 
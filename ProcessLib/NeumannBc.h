@@ -16,6 +16,7 @@
 #include "NumLib/Fem/FiniteElement/TemplateIsoparametric.h"
 #include "NumLib/Fem/ShapeMatrixPolicy.h"
 
+#include "AssemblerLib/ComputeElementColoring.h"
 #include "AssemblerLib/VectorMatrixAssembler.h"
 #include "AssemblerLib/LocalToGlobalIndexMap.h"
 #include "AssemblerLib/LocalDataInitializer.h"
@@ -78,6 +79,8 @@ public:
         _local_to_global_index_map.reset(
             local_to_global_index_map.deriveBoundaryConstrainedMap(
                 _all_mesh_subsets, _elements));
+
+        _element_coloring = AssemblerLib::computeElementColoring(_elements);
     }
 
     ~NeumannBc()
@@ -89,9 +92,6 @@ public:
 
         for (auto e : _elements)
             delete e;
-
-        for (auto p : _local_assemblers)
-            delete p;
     }
 
     template <typename GlobalSetup>
@@ -126,14 +126,15 @@ public:
             GlobalDim>;
 
         LocalDataInitializer initializer;
+        _local_assembler_arena.clear();
+        initializer.allocate(_elements, _local_assemblers,
+                             _local_assembler_arena);
 
         using LocalAssemblerBuilder =
             AssemblerLib::LocalAssemblerBuilder<
                 MeshLib::Element,
                 LocalDataInitializer>;
 
-        // Populate the vector of local assemblers.
-        _local_assemblers.resize(_elements.size());
         LocalAssemblerBuilder local_asm_builder(
             initializer, *_local_to_global_index_map);
 
@@ -165,7 +166,8 @@ public:
               )
     {
         _global_assembler->setX(x_curr, x_prev_ts);
-        global_setup.execute(*_global_assembler, _local_assemblers);
+        global_setup.executeColored(_element_coloring, *_global_assembler,
+                                    _local_assemblers);
     }
 
 
@@ -178,6 +180,10 @@ private:
     /// defined.
     std::vector<MeshLib::Element*> _elements;
 
+    /// Conflict-free color classes of the #_elements used for parallel
+    /// integration.
+    AssemblerLib::ElementColoring _element_coloring;
+
     MeshLib::MeshSubset const* _mesh_subset_all_nodes = nullptr;
     std::vector<MeshLib::MeshSubsets*> _all_mesh_subsets;
 
@@ -199,6 +205,9 @@ private:
     using LocalAssembler = LocalNeumannBcAsmDataInterface<
         typename GlobalSetup_::MatrixType, typename GlobalSetup_::VectorType>;
 
+    /// Storage of the local assemblers.
+    AssemblerLib::LocalAssemblerArena<LocalAssembler> _local_assembler_arena;
+
     /// Local assemblers for each element of #_elements.
     std::vector<LocalAssembler*> _local_assemblers;
 
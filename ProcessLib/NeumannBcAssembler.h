@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "NumLib/Fem/FiniteElement/TemplateIsoparametric.h"
+#include "NumLib/Fem/ShapeFunctionTable.h"
 #include "NumLib/Fem/ShapeMatrixPolicy.h"
 
 namespace ProcessLib
@@ -67,30 +68,26 @@ public:
 
 
         _integration_order = integration_order;
-        IntegrationMethod_ integration_method(_integration_order);
-        std::size_t const n_integration_points = integration_method.getNPoints();
+        auto const& shape_function_values = NumLib::ShapeFunctionTable<
+            ShapeFunction, IntegrationMethod_>::get(_integration_order);
+        std::size_t const n_integration_points = shape_function_values.size();
 
-        _shape_matrices.reserve(n_integration_points);
-        for (std::size_t ip(0); ip < n_integration_points; ip++) {
-            _shape_matrices.emplace_back(ShapeFunction::DIM, GlobalDim,
-                                         ShapeFunction::NPOINTS);
-            fe.computeShapeFunctions(
-                    integration_method.getWeightedPoint(ip).getCoords(),
-                    _shape_matrices[ip]);
-        }
+        _shape_matrices.assign(
+            n_integration_points,
+            ShapeMatrices(ShapeFunction::DIM, GlobalDim,
+                          ShapeFunction::NPOINTS));
+        fe.computeShapeFunctions(shape_function_values, _shape_matrices);
 
         _neumann_bc_value = value_lookup(e);
-
-        _localA.reset(new NodalMatrixType(local_matrix_size, local_matrix_size));
-        _localRhs.reset(new NodalVectorType(local_matrix_size));
+        _local_matrix_size = local_matrix_size;
     }
 
     void
     assemble(std::vector<double> const& /*local_x*/,
              std::vector<double> const& /*local_x_prev_ts*/) override
     {
-        _localA->setZero();
-        _localRhs->setZero();
+        auto& local = getLocalData();
+        local.rhs.setZero(_local_matrix_size);
 
         IntegrationMethod_ integration_method(_integration_order);
         std::size_t const n_integration_points = integration_method.getNPoints();
@@ -98,26 +95,41 @@ public:
         for (std::size_t ip(0); ip < n_integration_points; ip++) {
             auto const& sm = _shape_matrices[ip];
             auto const& wp = integration_method.getWeightedPoint(ip);
-            _localRhs->noalias() += sm.N * _neumann_bc_value
+            local.rhs.noalias() += sm.N * _neumann_bc_value
                         * sm.detJ * wp.getWeight();
         }
     }
 
+    /// Only the right-hand-side is changed; the Neumann condition does not
+    /// contribute to the matrix, which therefore need not be assembled, e.g.
+    /// in the matrix-free mode of the process.
     void addToGlobal(
-        GlobalMatrix& A, GlobalVector& rhs,
+        GlobalMatrix& /*A*/, GlobalVector& rhs,
         AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices)
         const override
     {
-        A.add(indices, *_localA);
-        rhs.add(indices.rows, *_localRhs);
+        rhs.add(indices.rows, getLocalData().rhs);
+    }
+
+private:
+    struct LocalData
+    {
+        NodalVectorType rhs;
+    };
+
+    /// Per-thread local vector shared by all local assemblers of this type;
+    /// valid until the next assemble() call on the same thread.
+    static LocalData& getLocalData()
+    {
+        static thread_local LocalData local_data;
+        return local_data;
     }
 
 private:
     std::vector<ShapeMatrices> _shape_matrices;
     double _neumann_bc_value;
 
-    std::unique_ptr<NodalMatrixType> _localA;
-    std::unique_ptr<NodalVectorType> _localRhs;
+    unsigned _local_matrix_size = 0;
 
     unsigned _integration_order = 2;
 };
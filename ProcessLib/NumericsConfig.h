@@ -108,11 +108,22 @@ using GlobalVectorMatrixBuilderType =
 //
 // Global executor
 //
+// The parallel executor relies on concurrent insertion into distinct rows of
+// the global matrix, which is safe for the Eigen sparse matrix only.
+#if defined(_OPENMP) && (defined(OGS_USE_EIGENLIS) || \
+    (defined(OGS_USE_EIGEN) && !defined(USE_LIS) && !defined(USE_PETSC)))
+#include "AssemblerLib/ParallelExecutor.h"
+namespace detail
+{
+using GlobalExecutorType = AssemblerLib::ParallelExecutor;
+}
+#else
 #include "AssemblerLib/SerialExecutor.h"
 namespace detail
 {
 using GlobalExecutorType = AssemblerLib::SerialExecutor;
 }
+#endif
 
 ///
 /// Global setup collects the previous configuration in single place.
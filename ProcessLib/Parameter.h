@@ -10,6 +10,7 @@
 #ifndef PROCESS_LIB_PARAMETER_H_
 #define PROCESS_LIB_PARAMETER_H_
 
+#include <algorithm>
 #include <memory>
 
 #include <logog/include/logog.hpp>
@@ -48,6 +49,40 @@ struct Parameter : public ParameterBase
 	virtual ReturnType operator()(Args&&... args) const = 0;
 };
 
+/// A parameter defined on mesh elements.
+///
+/// In addition to the evaluation for a single element, the parameter can be
+/// evaluated for many elements or integration points at once into a
+/// contiguous array, which assembly kernels read without calling back into the
+/// parameter. Derived parameters should override the bulk evaluations if they
+/// can do better than calling operator() for each item.
+template <typename ReturnType>
+struct Parameter<ReturnType, MeshLib::Element const&> : public ParameterBase
+{
+	virtual ~Parameter() = default;
+
+	virtual ReturnType operator()(MeshLib::Element const& e) const = 0;
+
+	/// Writes the values of the \c n given elements to \c values.
+	virtual void evaluate(MeshLib::Element const* const* elements,
+	                      std::size_t const n,
+	                      ReturnType* values) const
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			values[i] = (*this)(*elements[i]);
+	}
+
+	/// Writes the values at the \c n_integration_points integration points of
+	/// the element \c e to \c values. The parameters are constant on an
+	/// element, therefore the element value is repeated.
+	virtual void evaluate(MeshLib::Element const& e,
+	                      std::size_t const n_integration_points,
+	                      ReturnType* values) const
+	{
+		std::fill_n(values, n_integration_points, (*this)(e));
+	}
+};
+
 /// Single, constant value parameter.
 template <typename ReturnType>
 struct ConstParameter final
@@ -62,6 +97,20 @@ struct ConstParameter final
 		return _value;
 	}
 
+	void evaluate(MeshLib::Element const* const* /*elements*/,
+	              std::size_t const n,
+	              ReturnType* values) const override
+	{
+		std::fill_n(values, n, _value);
+	}
+
+	void evaluate(MeshLib::Element const& /*e*/,
+	              std::size_t const n_integration_points,
+	              ReturnType* values) const override
+	{
+		std::fill_n(values, n_integration_points, _value);
+	}
+
 private:
 	ReturnType _value;
 };
@@ -83,6 +132,21 @@ struct MeshPropertyParameter final
 		return _property[e.getID()];
 	}
 
+	void evaluate(MeshLib::Element const* const* elements,
+	              std::size_t const n,
+	              ReturnType* values) const override
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			values[i] = _property[elements[i]->getID()];
+	}
+
+	void evaluate(MeshLib::Element const& e,
+	              std::size_t const n_integration_points,
+	              ReturnType* values) const override
+	{
+		std::fill_n(values, n_integration_points, _property[e.getID()]);
+	}
+
 private:
 	MeshLib::PropertyVector<ReturnType> const& _property;
 };
@@ -45,4 +45,32 @@ ProcessVariable& findProcessVariable(
 	return const_cast<ProcessVariable&>(*variable);
 }
 
+MatrixFreeSolverOptions createMatrixFreeSolverOptions(
+    BaseLib::ConfigTree const& config)
+{
+	MatrixFreeSolverOptions options;
+
+	auto const solver = config.getConfParam<std::string>("solver", "CG");
+	if (solver == "CG")
+		options.solver = MatrixFreeSolverOptions::Solver::CG;
+	else if (solver == "PipelinedCG")
+		options.solver = MatrixFreeSolverOptions::Solver::PipelinedCG;
+	else if (solver == "BiCGStab")
+		options.solver = MatrixFreeSolverOptions::Solver::BiCGStab;
+	else
+	{
+		ERR("Unknown matrix-free solver '%s'; expected CG, PipelinedCG, or "
+		    "BiCGStab.",
+		    solver.c_str());
+		std::abort();
+	}
+
+	options.tolerance =
+	    config.getConfParam<double>("tolerance", options.tolerance);
+	options.max_iterations =
+	    config.getConfParam<unsigned>("max_iterations", options.max_iterations);
+
+	return options;
+}
+
 }  // namespace ProcessLib
@@ -11,17 +11,27 @@
 #define PROCESS_LIB_PROCESS_H_
 
 #include <memory>
+#include <numeric>
 #include <string>
 
 #include <logog/include/logog.hpp>
 
+#include "AssemblerLib/ComputeElementColoring.h"
 #include "AssemblerLib/ComputeSparsityPattern.h"
+#include "AssemblerLib/GlobalMatrixScatterMap.h"
 #include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MassStiffnessMatrixAssembler.h"
+#include "AssemblerLib/MatrixFreeOperator.h"
+#include "AssemblerLib/TripletMatrixAssembler.h"
 #include "AssemblerLib/VectorMatrixAssembler.h"
 #include "BaseLib/ConfigTree.h"
 #include "FileIO/VtkIO/VtuInterface.h"
 #include "MathLib/LinAlg/ApplyKnownSolution.h"
+#include "MathLib/LinAlg/LinAlgEnums.h"
+#include "MathLib/LinAlg/LinearCombination.h"
 #include "MathLib/LinAlg/SetMatrixSparsity.h"
+#include "MathLib/LinAlg/SymmetricMatrixStorage.h"
+#include "MathLib/LinAlg/Solvers/LinearOperatorSolvers.h"
 #include "MeshGeoToolsLib/MeshNodeSearcher.h"
 #include "MeshLib/MeshSubset.h"
 #include "MeshLib/MeshSubsets.h"
@@ -45,6 +55,34 @@ class Mesh;
 
 namespace ProcessLib
 {
+/// Settings of the iterative solver used in the matrix-free mode, see
+/// Process::setMatrixFree().
+struct MatrixFreeSolverOptions
+{
+	enum class Solver
+	{
+		CG,
+		PipelinedCG,
+		BiCGStab
+	};
+
+	Solver solver = Solver::CG;
+	double tolerance = 1e-10;
+	unsigned max_iterations = 10000;
+};
+
+/// Parses the matrix-free solver settings
+/// \code
+///     <matrix_free>
+///         <solver>CG</solver>      <!-- or PipelinedCG, BiCGStab -->
+///         <tolerance>1e-10</tolerance>
+///         <max_iterations>10000</max_iterations>
+///     </matrix_free>
+/// \endcode
+/// where all entries are optional.
+MatrixFreeSolverOptions createMatrixFreeSolverOptions(
+    BaseLib::ConfigTree const& config);
+
 template <typename GlobalSetup>
 class Process
 {
@@ -82,9 +120,40 @@ public:
 		    new AssemblerLib::LocalToGlobalIndexMap(
 		        _all_mesh_subsets, AssemblerLib::ComponentOrder::BY_COMPONENT));
 
-#ifndef USE_PETSC
-		DBUG("Compute sparsity pattern");
-		computeSparsityPattern();
+#ifdef USE_PETSC
+		if (_matrix_free_options)
+		{
+			ERR("The matrix-free mode is not available with PETSc.");
+			std::abort();
+		}
+		if (_is_transient)
+		{
+			ERR("The transient mode is not available with PETSc.");
+			std::abort();
+		}
+		if (_is_triplet_assembly)
+		{
+			ERR("The triplet assembly is not available with PETSc.");
+			std::abort();
+		}
+#else
+		if (_matrix_free_options && _is_transient)
+		{
+			ERR("The matrix-free mode does not support transient problems.");
+			std::abort();
+		}
+		if (_is_triplet_assembly && (_matrix_free_options || _is_transient))
+		{
+			ERR("The triplet assembly supports neither the matrix-free nor "
+			    "the transient mode.");
+			std::abort();
+		}
+
+		if (!_matrix_free_options && !_is_triplet_assembly)
+		{
+			DBUG("Compute sparsity pattern");
+			computeSparsityPattern();
+		}
 #endif
 
 		// create global vectors and linear solver
@@ -94,6 +163,54 @@ public:
 		_global_assembler.reset(
 		    new GlobalAssembler(*_A, *_rhs, *_local_to_global_index_map));
 
+#ifndef USE_PETSC
+		// For supporting matrix types the structure is allocated and frozen
+		// once; the time steps only reset the values.
+		if (_is_triplet_assembly)
+		{
+			_triplet_assembler.reset(new TripletAssembler(
+			    *_A, *_rhs, *_local_to_global_index_map));
+		}
+		else if (!_matrix_free_options)
+		{
+			DBUG("Compute global matrix structure and scatter map.");
+			MathLib::setMatrixSparsity(*_A, _sparsity_pattern);
+			_scatter_map = AssemblerLib::createScatterMap(
+			    *_A, *_local_to_global_index_map);
+			_global_assembler->setScatterMap(&_scatter_map);
+		}
+
+		if (_is_transient)
+		{
+			DBUG("Create storage and conductivity matrices.");
+			_M = createMatrixWithSystemStructure();
+			_K = createMatrixWithSystemStructure();
+			_B = createMatrixWithSystemStructure();
+			_product.reset(_global_setup.createVector(_x->size()));
+
+			// The matrices have the structure of _A, hence its scatter map.
+			_mass_stiffness_assembler.reset(new MassStiffnessAssembler(
+			    *_M, *_K, *_rhs, *_local_to_global_index_map));
+			_mass_stiffness_assembler->setScatterMap(&_scatter_map);
+		}
+#endif
+
+		if (_is_triplet_assembly)
+		{
+			// The triplet buffers are per thread; all elements are
+			// assembled concurrently as a single color class.
+			_element_coloring.assign(1, std::vector<std::size_t>(
+			                                _mesh.getNElements()));
+			std::iota(_element_coloring[0].begin(),
+			          _element_coloring[0].end(), 0);
+		}
+		else
+		{
+			DBUG("Compute element coloring.");
+			_element_coloring =
+			    AssemblerLib::computeElementColoring(_mesh.getElements());
+		}
+
 		createLocalAssemblers();
 
 		for (ProcessVariable& pv : _process_variables)
@@ -109,23 +226,53 @@ public:
 
 		for (auto& bc : _neumann_bcs)
 			bc->initialize(_global_setup, *_A, *_rhs, _mesh.getDimension());
+
+		// All Dirichlet boundary conditions are eliminated in one pass; for
+		// supporting matrix types the positions of the eliminated entries
+		// are computed once.
+		for (auto const& bc : _dirichlet_bcs)
+		{
+			_known_solutions.global_ids.insert(
+			    _known_solutions.global_ids.end(), bc.global_ids.cbegin(),
+			    bc.global_ids.cend());
+			_known_solutions.values.insert(_known_solutions.values.end(),
+			                               bc.values.cbegin(),
+			                               bc.values.cend());
+		}
+
+#ifndef USE_PETSC
+		if (_matrix_free_options)
+		{
+			DBUG("Create matrix-free operator.");
+			_matrix_free_operator.reset(new AssemblerLib::MatrixFreeOperator(
+			    *_local_to_global_index_map, _element_coloring,
+			    getMatrixFreeLocalAssemblers(), _known_solutions.global_ids));
+			return;
+		}
+#endif
+		_known_solution_elimination = MathLib::createKnownSolutionElimination(
+		    *_A, _known_solutions.global_ids);
 	}
 
 	bool solve(const double delta_t)
 	{
-		_A->setZero();
-		MathLib::setMatrixSparsity(*_A, _sparsity_pattern);
-
-		bool const result = assemble(delta_t);
-
-		// Call global assembler for each Neumann boundary local assembler.
-		for (auto const& bc : _neumann_bcs)
-			bc->integrate(_global_setup);
+#ifndef USE_PETSC
+		if (_matrix_free_operator)
+			return solveMatrixFree();
+		if (_is_transient)
+			return solveTransient(delta_t);
+#endif
 
-		for (auto const& bc : _dirichlet_bcs)
-			MathLib::applyKnownSolution(*_A, *_rhs, *_x, bc.global_ids,
-			                            bc.values);
+		if (_is_matrix_assembled)
+		{
+			assembleRhs();
+			// The unchanged matrix' factorization or preconditioner is reused.
+			_linear_solver->solve(*_rhs, *_x,
+			                      MathLib::LinearSolverBehaviour::REUSE);
+			return true;
+		}
 
+		bool const result = assembleSystem(delta_t);
 		_linear_solver->solve(*_rhs, *_x);
 		return result;
 	}
@@ -141,7 +288,271 @@ protected:
 		    new BaseLib::ConfigTree(std::move(config)));
 	}
 
+	/// Declares the global matrix and the right-hand-side assembled by
+	/// assemble() as independent of time and solution. The matrix is then
+	/// assembled once and the known solutions are eliminated once; in the
+	/// following time steps only the right-hand-side is rebuilt.
+	/// \note Neumann boundary conditions must not contribute to the matrix.
+	void setTimeInvariantSystem(bool const time_invariant)
+	{
+		_is_time_invariant_system = time_invariant;
+	}
+
+	/// Declares the global matrix symmetric; must be called before
+	/// initialize(). If the matrix type and the linear solver support it, the
+	/// upper triangle only is stored and assembled, see
+	/// MathLib::setSymmetricStorage() and MathLib::SupportsSymmetricStorage.
+	/// \note The local matrices must be symmetric.
+	void setSymmetricMatrix(bool const symmetric)
+	{
+		_is_symmetric_matrix = symmetric;
+	}
+
+	/// Switches to the triplet assembly; must be called before initialize().
+	/// The local matrices are collected as triplets in buffers per thread
+	/// and summed into the global matrix after the element loop, see
+	/// AssemblerLib::TripletMatrixAssembler. Neither the sparsity pattern
+	/// nor an element coloring are needed, and the global matrix gets a new
+	/// structure in each assembly. The summation order does not depend on
+	/// the number of threads.
+	/// \note The process' assemble() must use the #_triplet_assembler if it
+	/// is set.
+	void setTripletAssembly(bool const triplet_assembly)
+	{
+		_is_triplet_assembly = triplet_assembly;
+	}
+
+	/// Switches to the matrix-free mode; must be called before initialize().
+	/// Neither the global matrix nor its sparsity pattern are computed. The
+	/// system is solved by the given iterative solver applying the local
+	/// matrices from getMatrixFreeLocalAssemblers() element by element,
+	/// preconditioned by the inverse matrix diagonal.
+	/// \note The right-hand-side consists of the Neumann boundary conditions
+	/// only; assemble() is not called.
+	void setMatrixFree(MatrixFreeSolverOptions const& options)
+	{
+		_matrix_free_options.reset(new MatrixFreeSolverOptions(options));
+	}
+
+	/// Switches to the transient mode; must be called before initialize().
+	/// The equation \f$ M \dot x + K x = f \f$ is discretized in time by
+	/// the \f$ \theta \f$-method,
+	/// \f[ (M/\Delta t + \theta K) x^{n+1}
+	///     = (M/\Delta t - (1 - \theta) K) x^n + f. \f]
+	/// The storage matrix \f$ M \f$, the conductivity matrix \f$ K \f$,
+	/// and \f$ f \f$ are assembled once by assembleMassAndStiffness(). The
+	/// system matrix is a linear combination of both, which is recomputed
+	/// over their common sparsity pattern whenever the time step size
+	/// changes; otherwise the matrix and its factorization or preconditioner
+	/// are reused and only the right-hand-side is updated.
+	/// \note The global matrix type must support MathLib::linearCombination().
+	void setTransient(double const theta)
+	{
+		_is_transient = true;
+		_theta = theta;
+	}
+
+	/// Assembles the storage and conductivity matrices and the
+	/// right-hand-side by the #_mass_stiffness_assembler; used in the
+	/// transient mode.
+	virtual void assembleMassAndStiffness()
+	{
+		ERR("The process does not support the transient mode.");
+		std::abort();
+	}
+
+	/// The local assemblers in the order of the mesh elements, used in the
+	/// matrix-free mode.
+	virtual std::vector<AssemblerLib::MatrixFreeLocalAssembler const*>
+	getMatrixFreeLocalAssemblers() const
+	{
+		ERR("The process does not support the matrix-free mode.");
+		std::abort();
+	}
+
 private:
+	/// Assembles the global matrix and the right-hand-side, and applies the
+	/// boundary conditions. For time-invariant systems the matrix is kept
+	/// for the following time steps if the elimination of the known
+	/// solutions can be recorded for the global matrix type.
+	bool assembleSystem(const double delta_t)
+	{
+		_A->setZero();
+		// A matrix with frozen structure, i.e. if there is a scatter map, keeps
+		// its sparsity; the triplet assembly replaces the structure.
+		if (_scatter_map.empty() && !_triplet_assembler)
+			MathLib::setMatrixSparsity(*_A, _sparsity_pattern);
+
+		bool const result = assemble(delta_t);
+
+		if (_is_time_invariant_system)
+			_assembled_rhs.reset(new typename GlobalSetup::VectorType(*_rhs));
+
+		// Call global assembler for each Neumann boundary local assembler.
+		for (auto const& bc : _neumann_bcs)
+			bc->integrate(_global_setup);
+
+		MathLib::applyKnownSolution(*_A, *_rhs, *_x,
+		                            _known_solutions.global_ids,
+		                            _known_solutions.values,
+		                            _known_solution_elimination);
+
+		if (!_is_time_invariant_system)
+			return result;
+
+		_is_matrix_assembled = !_known_solution_elimination.empty();
+		if (!_is_matrix_assembled)
+		{
+			INFO(
+			    "The global matrix type does not support recording of the "
+			    "known solutions' elimination; the system is assembled in "
+			    "each time step.");
+			_is_time_invariant_system = false;
+			_assembled_rhs.reset();
+		}
+		return result;
+	}
+
+#ifndef USE_PETSC
+	/// Solves the system with the #_matrix_free_operator for the Neumann
+	/// boundary conditions' right-hand-side and the known solutions.
+	bool solveMatrixFree()
+	{
+		*_rhs = 0;
+		for (auto const& bc : _neumann_bcs)
+			bc->integrate(_global_setup);
+
+		std::vector<double> b;
+		std::vector<double> x;
+		_rhs->copyValues(b);
+		_x->copyValues(x);
+		_matrix_free_operator->applyKnownSolution(b.data(), x.data(),
+		                                          _known_solutions.values);
+
+		double eps = _matrix_free_options->tolerance;
+		unsigned n_steps = _matrix_free_options->max_iterations;
+		char const* solver_name = "";
+		unsigned status = 1;
+		switch (_matrix_free_options->solver)
+		{
+			case MatrixFreeSolverOptions::Solver::CG:
+				solver_name = "CG";
+				status = MathLib::CG(*_matrix_free_operator, b.data(),
+				                     x.data(), eps, n_steps);
+				break;
+			case MatrixFreeSolverOptions::Solver::PipelinedCG:
+				solver_name = "pipelined CG";
+				status = MathLib::PipelinedCG(*_matrix_free_operator,
+				                              b.data(), x.data(), eps, n_steps);
+				break;
+			case MatrixFreeSolverOptions::Solver::BiCGStab:
+				solver_name = "BiCGStab";
+				status = MathLib::BiCGStab(*_matrix_free_operator, b.data(),
+				                           x.data(), eps, n_steps);
+				break;
+		}
+
+		for (std::size_t i = 0; i < x.size(); ++i)
+			_x->set(i, x[i]);
+
+		INFO("Matrix-free %s: %u iterations, relative residual %g.",
+		     solver_name, n_steps, eps);
+		if (status != 0)
+		{
+			ERR("The matrix-free solver did not converge.");
+			return false;
+		}
+		return true;
+	}
+#endif
+
+#ifndef USE_PETSC
+	/// Solves one time step in the transient mode, see setTransient().
+	bool solveTransient(const double delta_t)
+	{
+		if (!_assembled_rhs)
+		{
+			_M->setZero();
+			_K->setZero();
+			*_rhs = 0;
+			assembleMassAndStiffness();
+			_assembled_rhs.reset(new typename GlobalSetup::VectorType(*_rhs));
+		}
+
+		// A new time step size changes the system matrix; both matrices are
+		// combined without an element loop.
+		bool const is_new_matrix = delta_t != _system_delta_t;
+		if (is_new_matrix)
+		{
+			if (!MathLib::linearCombination(*_A, 1.0 / delta_t, *_M, _theta,
+			                                *_K) ||
+			    !MathLib::linearCombination(*_B, 1.0 / delta_t, *_M,
+			                                _theta - 1.0, *_K))
+			{
+				ERR("The global matrix type does not support the linear "
+				    "combination of matrices required by the transient "
+				    "mode.");
+				std::abort();
+			}
+			_system_delta_t = delta_t;
+		}
+
+		// The solution is still the one of the previous time step.
+		*_rhs = *_assembled_rhs;
+		_B->multiply(*_x, *_product);
+		*_rhs += *_product;
+
+		for (auto const& bc : _neumann_bcs)
+			bc->integrate(_global_setup);
+
+		if (is_new_matrix || _known_solution_elimination.empty())
+		{
+			MathLib::applyKnownSolution(*_A, *_rhs, *_x,
+			                            _known_solutions.global_ids,
+			                            _known_solutions.values,
+			                            _known_solution_elimination);
+			_linear_solver->solve(*_rhs, *_x);
+			return true;
+		}
+
+		MathLib::applyKnownSolution(_known_solution_elimination, *_rhs,
+		                            _known_solutions.global_ids,
+		                            _known_solutions.values);
+		_linear_solver->solve(*_rhs, *_x,
+		                      MathLib::LinearSolverBehaviour::REUSE);
+		return true;
+	}
+
+	/// Creates a global matrix with the same structure as #_A, i.e. with the
+	/// same sparsity pattern and, if supported, frozen such that the
+	/// #_scatter_map of #_A applies.
+	std::unique_ptr<typename GlobalSetup::MatrixType>
+	createMatrixWithSystemStructure()
+	{
+		std::unique_ptr<typename GlobalSetup::MatrixType> M(
+		    _global_setup.createMatrix(_local_to_global_index_map->dofSize()));
+		setMatrixSymmetry(*M);
+		MathLib::setMatrixSparsity(*M, _sparsity_pattern);
+		AssemblerLib::freezeMatrixStructure(*M, *_local_to_global_index_map);
+		return M;
+	}
+#endif
+
+	/// Rebuilds the right-hand-side from the stored assembled one, the
+	/// Neumann boundary conditions, and the recorded elimination of the
+	/// known solutions; the global matrix is left as is.
+	void assembleRhs()
+	{
+		*_rhs = *_assembled_rhs;
+
+		for (auto const& bc : _neumann_bcs)
+			bc->integrate(_global_setup);
+
+		MathLib::applyKnownSolution(_known_solution_elimination, *_rhs,
+		                            _known_solutions.global_ids,
+		                            _known_solutions.values);
+	}
+
 	/// Creates mesh subsets, i.e. components, for given mesh.
 	void initializeMeshSubsets()
 	{
@@ -242,17 +653,41 @@ private:
 		_x.reset(_global_setup.createVector(num_unknowns));
 		_rhs.reset(_global_setup.createVector(num_unknowns));
 #endif
+		setMatrixSymmetry(*_A);
 		_linear_solver.reset(new typename GlobalSetup::LinearSolver(
 		    *_A, solver_name, _linear_solver_options.get()));
 		checkAndInvalidate(_linear_solver_options);
 	}
 
+	/// Declares a new global matrix symmetric if requested by
+	/// setSymmetricMatrix() and supported by the matrix type and the linear
+	/// solver.
+	void setMatrixSymmetry(typename GlobalSetup::MatrixType& A) const
+	{
+		if (!_is_symmetric_matrix)
+			return;
+		if (!MathLib::SupportsSymmetricStorage<
+		        typename GlobalSetup::LinearSolver>::value)
+		{
+			INFO(
+			    "The linear solver does not support symmetric matrix storage; "
+			    "the full matrix is stored.");
+		}
+		else if (!MathLib::setSymmetricStorage(A))
+		{
+			INFO(
+			    "The global matrix type does not support symmetric storage; "
+			    "the full matrix is stored.");
+		}
+	}
+
 	/// Computes and stores global matrix' sparsity pattern from given
 	/// DOF-table.
 	void computeSparsityPattern()
 	{
-		_sparsity_pattern = std::move(AssemblerLib::computeSparsityPattern(
-		    *_local_to_global_index_map, _mesh));
+		_sparsity_pattern =
+		    AssemblerLib::computeCompressedSparsityPattern(
+		        *_local_to_global_index_map);
 	}
 
 	void output(std::string const& file_name)
@@ -306,6 +741,19 @@ protected:
 
 	std::unique_ptr<GlobalAssembler> _global_assembler;
 
+	using MassStiffnessAssembler = AssemblerLib::MassStiffnessMatrixAssembler<
+	    typename GlobalSetup::MatrixType, typename GlobalSetup::VectorType>;
+
+	/// Assembler of the #_M and #_K matrices in the transient mode.
+	std::unique_ptr<MassStiffnessAssembler> _mass_stiffness_assembler;
+
+	using TripletAssembler = AssemblerLib::TripletMatrixAssembler<
+	    typename GlobalSetup::MatrixType, typename GlobalSetup::VectorType>;
+
+	/// Assembler replacing the #_global_assembler in the triplet assembly,
+	/// see setTripletAssembly().
+	std::unique_ptr<TripletAssembler> _triplet_assembler;
+
 	std::unique_ptr<AssemblerLib::LocalToGlobalIndexMap>
 	    _local_to_global_index_map;
 
@@ -316,11 +764,68 @@ protected:
 	std::unique_ptr<typename GlobalSetup::VectorType> _rhs;
 	std::unique_ptr<typename GlobalSetup::VectorType> _x;
 
-	AssemblerLib::SparsityPattern _sparsity_pattern;
+	AssemblerLib::CompressedSparsityPattern _sparsity_pattern;
+
+	/// Positions of the local matrix entries in the global matrix, if
+	/// supported by the global matrix type.
+	AssemblerLib::GlobalMatrixScatterMap _scatter_map;
+
+	/// Conflict-free element color classes used for parallel assembly.
+	AssemblerLib::ElementColoring _element_coloring;
 
 	std::vector<DirichletBc<GlobalIndexType>> _dirichlet_bcs;
 	std::vector<std::unique_ptr<NeumannBc<GlobalSetup>>> _neumann_bcs;
 
+	/// See setTimeInvariantSystem().
+	bool _is_time_invariant_system = false;
+
+	/// True if the global matrix with eliminated known solutions is reused
+	/// in the following time steps.
+	bool _is_matrix_assembled = false;
+
+	/// See setSymmetricMatrix().
+	bool _is_symmetric_matrix = false;
+
+	/// See setTripletAssembly().
+	bool _is_triplet_assembly = false;
+
+	/// See setTransient().
+	bool _is_transient = false;
+	double _theta = 1.0;
+
+	/// Storage and conductivity matrices in the transient mode.
+	std::unique_ptr<typename GlobalSetup::MatrixType> _M;
+	std::unique_ptr<typename GlobalSetup::MatrixType> _K;
+
+	/// Matrix \f$ M/\Delta t - (1 - \theta) K \f$ of the right-hand-side in
+	/// the transient mode.
+	std::unique_ptr<typename GlobalSetup::MatrixType> _B;
+	std::unique_ptr<typename GlobalSetup::VectorType> _product;
+
+	/// Time step size of the current system matrix in the transient mode;
+	/// zero if it is not yet formed.
+	double _system_delta_t = 0;
+
+	/// Right-hand-side as assembled by assemble(), i.e. without boundary
+	/// conditions, stored for time-invariant systems and in the transient
+	/// mode.
+	std::unique_ptr<typename GlobalSetup::VectorType> _assembled_rhs;
+
+	/// Global ids and values of all #_dirichlet_bcs.
+	DirichletBc<GlobalIndexType> _known_solutions;
+
+	/// Precomputed and recorded elimination of the #_known_solutions, if
+	/// supported by the global matrix type.
+	MathLib::KnownSolutionElimination<GlobalIndexType>
+	    _known_solution_elimination;
+
+	/// Solver settings if the matrix-free mode is enabled, see
+	/// setMatrixFree().
+	std::unique_ptr<MatrixFreeSolverOptions> _matrix_free_options;
+
+	/// Global matrix given by the local assemblers in the matrix-free mode.
+	std::unique_ptr<AssemblerLib::MatrixFreeOperator> _matrix_free_operator;
+
 	/// Variables used by this process.
 	std::vector<std::reference_wrapper<ProcessVariable>> _process_variables;
 };
@@ -341,27 +846,13 @@ ProcessVariable& findProcessVariable(
     BaseLib::ConfigTree const& process_config, std::string const& tag,
     std::vector<ProcessVariable> const& variables);
 
-/// Find a parameter of specific type for a name given in the process
-/// configuration under the tag.
-/// In the process config a parameter is referenced by a name. For example it
-/// will be looking for a parameter named "K" in the list of parameters
-/// when the tag is "hydraulic_conductivity":
-/// \code
-///     <process>
-///         ...
-///         <hydraulic_conductivity>K</hydraulic_conductivity>
-///     </process>
-/// \endcode
-/// and return a reference to that parameter. Additionally it checks for the
-/// type of the found parameter.
+/// Find a parameter of specific type by its name in the list of parameters.
+/// Additionally it checks for the type of the found parameter.
 template <typename... ParameterArgs>
 Parameter<ParameterArgs...>& findParameter(
-    BaseLib::ConfigTree const& process_config, std::string const& tag,
+    std::string const& name,
     std::vector<std::unique_ptr<ParameterBase>> const& parameters)
 {
-	// Find parameter name in process config.
-	auto const name = process_config.getConfParam<std::string>(tag);
-
 	// Find corresponding parameter by name.
 	auto const parameter_it =
 	    std::find_if(parameters.cbegin(), parameters.cend(),
@@ -372,10 +863,8 @@ Parameter<ParameterArgs...>& findParameter(
 
 	if (parameter_it == parameters.end())
 	{
-		ERR(
-		    "Could not find parameter '%s' in the provided parameters list for "
-		    "config tag <%s>.",
-		    name.c_str(), tag.c_str());
+		ERR("Could not find parameter '%s' in the provided parameters list.",
+		    name.c_str());
 		std::abort();
 	}
 	DBUG("Found parameter \'%s\'.", (*parameter_it)->name.c_str());
@@ -391,6 +880,30 @@ Parameter<ParameterArgs...>& findParameter(
 	return *parameter;
 }
 
+/// Find a parameter of specific type for a name given in the process
+/// configuration under the tag.
+/// In the process config a parameter is referenced by a name. For example it
+/// will be looking for a parameter named "K" in the list of parameters
+/// when the tag is "hydraulic_conductivity":
+/// \code
+///     <process>
+///         ...
+///         <hydraulic_conductivity>K</hydraulic_conductivity>
+///     </process>
+/// \endcode
+/// and return a reference to that parameter. Additionally it checks for the
+/// type of the found parameter.
+template <typename... ParameterArgs>
+Parameter<ParameterArgs...>& findParameter(
+    BaseLib::ConfigTree const& process_config, std::string const& tag,
+    std::vector<std::unique_ptr<ParameterBase>> const& parameters)
+{
+	// Find parameter name in process config.
+	auto const name = process_config.getConfParam<std::string>(tag);
+
+	return findParameter<ParameterArgs...>(name, parameters);
+}
+
 }  // namespace ProcessLib
 
 #endif  // PROCESS_LIB_PROCESS_H_
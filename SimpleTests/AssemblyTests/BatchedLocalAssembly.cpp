@@ -0,0 +1,218 @@
+/**
+ * \brief  Throughput test of the element-wise and the batched local assembly
+ *         of the groundwater flow process for different element types.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <logog/include/logog.hpp>
+#include <tclap/CmdLine.h>
+
+#include "BaseLib/LogogSimpleFormatter.h"
+#include "BaseLib/RunTime.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+
+#include "MeshLib/Elements/Tet.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/Node.h"
+
+#include "NumLib/Fem/Integration/GaussIntegrationPolicy.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex8.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTet4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri3.h"
+
+#include "ProcessLib/GroundwaterFlowBatchedFEM.h"
+#include "ProcessLib/GroundwaterFlowFEM.h"
+#include "ProcessLib/Parameter.h"
+
+using GlobalMatrix = MathLib::EigenMatrix;
+using GlobalVector = MathLib::EigenVector;
+
+/// Splits each hexahedron into six positively oriented tetrahedra.
+std::vector<MeshLib::Element*> splitIntoTets(MeshLib::Mesh const& hex_mesh)
+{
+	std::array<std::array<unsigned, 4>, 6> const tets{{
+		{{0, 1, 2, 6}}, {{0, 2, 3, 6}}, {{0, 3, 7, 6}},
+		{{0, 7, 4, 6}}, {{0, 4, 5, 6}}, {{0, 5, 1, 6}}}};
+
+	std::vector<MeshLib::Element*> elements;
+	elements.reserve(6 * hex_mesh.getNElements());
+	for (auto const* hex : hex_mesh.getElements())
+	{
+		for (auto const& tet : tets)
+		{
+			std::array<MeshLib::Node*, 4> nodes;
+			for (unsigned i = 0; i < 4; ++i)
+				nodes[i] = const_cast<MeshLib::Node*>(hex->getNode(tet[i]));
+
+			double const* const p0 = nodes[0]->getCoords();
+			std::array<std::array<double, 3>, 3> e;
+			for (unsigned i = 0; i < 3; ++i)
+				for (unsigned d = 0; d < 3; ++d)
+					e[i][d] = nodes[i + 1]->getCoords()[d] - p0[d];
+			double const volume =
+				e[0][0] * (e[1][1] * e[2][2] - e[1][2] * e[2][1]) -
+				e[0][1] * (e[1][0] * e[2][2] - e[1][2] * e[2][0]) +
+				e[0][2] * (e[1][0] * e[2][1] - e[1][1] * e[2][0]);
+			if (volume < 0)
+				std::swap(nodes[1], nodes[2]);
+
+			elements.push_back(new MeshLib::Tet(nodes));
+		}
+	}
+	return elements;
+}
+
+template <typename Assemble>
+double measure(unsigned const repetitions, Assemble const& assemble)
+{
+	BaseLib::RunTime timer;
+	timer.start();
+	for (unsigned r = 0; r < repetitions; ++r)
+		assemble();
+	return timer.elapsed() / repetitions;
+}
+
+/// Reports the element throughput of the element-wise and of the batched
+/// local assembly with batches of four and eight elements.
+template <typename ShapeFunction, unsigned GlobalDim>
+void run(std::string const& name,
+	std::vector<MeshLib::Element*> const& mesh_elements,
+	unsigned const repetitions)
+{
+	using IntegrationMethod = typename NumLib::GaussIntegrationPolicy<
+		typename ShapeFunction::MeshElement>::IntegrationMethod;
+	using LocalAssembler = ProcessLib::GroundwaterFlow::LocalAssemblerData<
+		ShapeFunction, IntegrationMethod, GlobalMatrix, GlobalVector,
+		GlobalDim>;
+
+	ProcessLib::ConstParameter<double> const hydraulic_conductivity(1.0);
+	unsigned const integration_order = 2;
+	std::size_t const n_elements = mesh_elements.size();
+
+	std::vector<std::unique_ptr<LocalAssembler>> local_assemblers;
+	local_assemblers.reserve(n_elements);
+	for (auto const* e : mesh_elements)
+	{
+		local_assemblers.emplace_back(new LocalAssembler);
+		local_assemblers.back()->init(*e, ShapeFunction::NPOINTS,
+			hydraulic_conductivity, integration_order, nullptr, nullptr);
+	}
+
+	std::vector<double> const local_x;
+	double const elementwise_time = measure(repetitions, [&]() {
+			OPENMP_LOOP_TYPE const n = n_elements;
+			#pragma omp parallel for
+			for (OPENMP_LOOP_TYPE i = 0; i < n; i++)
+				local_assemblers[i]->assemble(local_x, local_x);
+		});
+	INFO("%s element-wise: %g M elements/s.", name.c_str(),
+		n_elements / elementwise_time * 1e-6);
+
+	std::vector<MeshLib::Element const*> const elements(
+		mesh_elements.cbegin(), mesh_elements.cend());
+
+	ProcessLib::GroundwaterFlow::BatchedLocalAssemblerData<
+		ShapeFunction, IntegrationMethod, GlobalDim, 4>
+		batched_4(elements, hydraulic_conductivity, integration_order);
+	double const batched_4_time = measure(repetitions, [&]() {
+			batched_4.assemble();
+		});
+	INFO("%s batches of 4: %g M elements/s, speedup %g.", name.c_str(),
+		n_elements / batched_4_time * 1e-6, elementwise_time / batched_4_time);
+
+	ProcessLib::GroundwaterFlow::BatchedLocalAssemblerData<
+		ShapeFunction, IntegrationMethod, GlobalDim, 8>
+		batched_8(elements, hydraulic_conductivity, integration_order);
+	double const batched_8_time = measure(repetitions, [&]() {
+			batched_8.assemble();
+		});
+	INFO("%s batches of 8: %g M elements/s, speedup %g.", name.c_str(),
+		n_elements / batched_8_time * 1e-6, elementwise_time / batched_8_time);
+}
+
+int main(int argc, char *argv[])
+{
+	LOGOG_INITIALIZE();
+	BaseLib::LogogSimpleFormatter *custom_format (new BaseLib::LogogSimpleFormatter);
+	logog::Cout *logogCout(new logog::Cout);
+	logogCout->SetFormatter(*custom_format);
+
+	TCLAP::CmdLine cmd("Local assembly throughput test per element type.", ' ', "0.1");
+
+	TCLAP::ValueArg<unsigned> n_cells_arg("n", "number-of-cells",
+		"number of cells in each direction of the 3d meshes; the 2d meshes "
+		"have about the same number of elements", false, 50, "number");
+	cmd.add(n_cells_arg);
+
+	TCLAP::ValueArg<unsigned> n_repetitions_arg("r", "repetitions",
+		"number of assemblies per variant", false, 3, "number");
+	cmd.add(n_repetitions_arg);
+
+	TCLAP::ValueArg<unsigned> n_threads_arg("p", "number-threads",
+		"number of threads to use; defaults to OMP_NUM_THREADS", false, 0, "number");
+	cmd.add(n_threads_arg);
+
+	cmd.parse(argc, argv);
+
+	unsigned const n_cells = n_cells_arg.getValue();
+	unsigned const repetitions = n_repetitions_arg.getValue();
+#ifdef _OPENMP
+	if (n_threads_arg.getValue() > 0)
+		omp_set_num_threads(n_threads_arg.getValue());
+	INFO("Using %d threads.", omp_get_max_threads());
+#else
+	INFO("Compiled without OpenMP support, running serially.");
+#endif
+
+	std::size_t const n_cells_2d = std::sqrt(static_cast<double>(n_cells)) * n_cells;
+
+	{
+		std::unique_ptr<MeshLib::Mesh> mesh(
+			MeshLib::MeshGenerator::generateRegularTriMesh(1.0, n_cells_2d / 2));
+		run<NumLib::ShapeTri3, 2>("Tri3", mesh->getElements(), repetitions);
+	}
+	{
+		std::unique_ptr<MeshLib::Mesh> mesh(
+			MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, n_cells_2d));
+		run<NumLib::ShapeQuad4, 2>("Quad4", mesh->getElements(), repetitions);
+	}
+	{
+		std::unique_ptr<MeshLib::Mesh> mesh(
+			MeshLib::MeshGenerator::generateRegularHexMesh(1.0, n_cells / 2));
+		std::vector<MeshLib::Element*> const tets = splitIntoTets(*mesh);
+		run<NumLib::ShapeTet4, 3>("Tet4", tets, repetitions);
+		for (auto e : tets)
+			delete e;
+	}
+	{
+		std::unique_ptr<MeshLib::Mesh> mesh(
+			MeshLib::MeshGenerator::generateRegularHexMesh(1.0, n_cells));
+		run<NumLib::ShapeHex8, 3>("Hex8", mesh->getElements(), repetitions);
+	}
+
+	delete custom_format;
+	delete logogCout;
+	LOGOG_SHUTDOWN();
+
+	return 0;
+}
@@ -0,0 +1,262 @@
+/**
+ * \brief  Scaling test of the global assembly using the serial and the
+ *         parallel (colored) executor, and the global matrix scatter map.
+ *         Also counts the heap allocations of the assembly loop.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <logog/include/logog.hpp>
+#include <tclap/CmdLine.h>
+
+#include "BaseLib/LogogSimpleFormatter.h"
+#include "BaseLib/RunTime.h"
+
+#include "AssemblerLib/ComputeElementColoring.h"
+#include "AssemblerLib/ComputeSparsityPattern.h"
+#include "AssemblerLib/GlobalMatrixScatterMap.h"
+#include "AssemblerLib/LocalAssemblerBuilder.h"
+#include "AssemblerLib/LocalDataInitializer.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MatrixFreeOperator.h"
+#include "AssemblerLib/ParallelExecutor.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#include "MathLib/LinAlg/SetMatrixSparsity.h"
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/MeshSubset.h"
+#include "MeshLib/MeshSubsets.h"
+
+#include "NumLib/Fem/ShapeMatricesCache.h"
+
+#include "ProcessLib/GroundwaterFlowFEM.h"
+#include "ProcessLib/Parameter.h"
+
+using GlobalMatrix = MathLib::EigenMatrix;
+using GlobalVector = MathLib::EigenVector;
+
+using LocalAssembler = ProcessLib::GroundwaterFlow::LocalAssemblerDataInterface<
+	GlobalMatrix, GlobalVector>;
+
+namespace
+{
+/// Number of heap allocations done through the global operator new.
+std::atomic<std::size_t> allocation_count(0);
+}
+
+void* operator new(std::size_t size)
+{
+	++allocation_count;
+	if (void* p = std::malloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+template <typename Assemble>
+double measure(unsigned const repetitions, Assemble const& assemble)
+{
+	BaseLib::RunTime timer;
+	timer.start();
+	for (unsigned r = 0; r < repetitions; ++r)
+		assemble();
+	return timer.elapsed() / repetitions;
+}
+
+int main(int argc, char *argv[])
+{
+	LOGOG_INITIALIZE();
+	BaseLib::LogogSimpleFormatter *custom_format (new BaseLib::LogogSimpleFormatter);
+	logog::Cout *logogCout(new logog::Cout);
+	logogCout->SetFormatter(*custom_format);
+
+	TCLAP::CmdLine cmd("Global assembly scaling test on a regular hex mesh.", ' ', "0.1");
+
+	TCLAP::ValueArg<unsigned> n_cells_arg("n", "number-of-cells",
+		"number of cells in each direction; 216 gives 10M elements",
+		false, 50, "number");
+	cmd.add(n_cells_arg);
+
+	TCLAP::ValueArg<unsigned> n_repetitions_arg("r", "repetitions",
+		"number of assemblies per executor", false, 3, "number");
+	cmd.add(n_repetitions_arg);
+
+	TCLAP::ValueArg<unsigned> n_threads_arg("p", "number-threads",
+		"number of threads to use; defaults to OMP_NUM_THREADS", false, 0, "number");
+	cmd.add(n_threads_arg);
+
+	TCLAP::SwitchArg share_shape_matrices_arg("s", "share-shape-matrices",
+		"share the shape matrices among congruent elements");
+	cmd.add(share_shape_matrices_arg);
+
+	cmd.parse(argc, argv);
+
+	unsigned const n_cells = n_cells_arg.getValue();
+	unsigned const repetitions = n_repetitions_arg.getValue();
+#ifdef _OPENMP
+	if (n_threads_arg.getValue() > 0)
+		omp_set_num_threads(n_threads_arg.getValue());
+	INFO("Using %d threads.", omp_get_max_threads());
+#else
+	INFO("Compiled without OpenMP support, running serially.");
+#endif
+
+	BaseLib::RunTime timer;
+	timer.start();
+	std::unique_ptr<MeshLib::Mesh> mesh(
+		MeshLib::MeshGenerator::generateRegularHexMesh(
+			n_cells, n_cells, n_cells, 1.0 / n_cells));
+	INFO("Generated mesh with %u elements in %g s.",
+		static_cast<unsigned>(mesh->getNElements()), timer.elapsed());
+
+	MeshLib::MeshSubset const mesh_subset_all_nodes(*mesh, &mesh->getNodes());
+	std::vector<MeshLib::MeshSubsets*> all_mesh_subsets{
+		new MeshLib::MeshSubsets(&mesh_subset_all_nodes)};
+
+	timer.start();
+	AssemblerLib::LocalToGlobalIndexMap const dof_table(
+		all_mesh_subsets, AssemblerLib::ComponentOrder::BY_COMPONENT);
+	AssemblerLib::CompressedSparsityPattern const sparsity_pattern =
+		AssemblerLib::computeCompressedSparsityPattern(dof_table);
+	INFO("Constructed dof table and sparsity pattern with %u non-zeros in %g s.",
+		static_cast<unsigned>(sparsity_pattern.col_idx.size()), timer.elapsed());
+
+	timer.start();
+	AssemblerLib::ElementColoring const coloring =
+		AssemblerLib::computeElementColoring(mesh->getElements());
+	INFO("Computed %u element colors in %g s.",
+		static_cast<unsigned>(coloring.size()), timer.elapsed());
+
+	GlobalMatrix A(dof_table.dofSize());
+	GlobalVector rhs(dof_table.dofSize());
+
+	using LocalDataInitializer = AssemblerLib::LocalDataInitializer<
+		ProcessLib::GroundwaterFlow::LocalAssemblerDataInterface,
+		ProcessLib::GroundwaterFlow::LocalAssemblerData,
+		GlobalMatrix, GlobalVector, 3>;
+	LocalDataInitializer initializer;
+	AssemblerLib::LocalAssemblerBuilder<MeshLib::Element, LocalDataInitializer>
+		local_asm_builder(initializer, dof_table);
+
+	ProcessLib::ConstParameter<double> const hydraulic_conductivity(1.0);
+	unsigned const integration_order = 2;
+
+	std::unique_ptr<NumLib::ShapeMatricesCache> shape_matrices_cache;
+	if (share_shape_matrices_arg.getValue())
+		shape_matrices_cache.reset(new NumLib::ShapeMatricesCache);
+
+	timer.start();
+	std::size_t const allocations_before_init = allocation_count;
+	LocalDataInitializer::Arena local_assembler_arena;
+	std::vector<LocalAssembler*> local_assemblers;
+	initializer.allocate(mesh->getElements(), local_assemblers,
+		local_assembler_arena);
+	AssemblerLib::ParallelExecutor::execute(local_asm_builder,
+		mesh->getElements(), local_assemblers, hydraulic_conductivity,
+		integration_order, shape_matrices_cache.get(),
+		static_cast<ProcessLib::Parameter<double, MeshLib::Element const&>
+			const*>(nullptr));
+	INFO("Created local assemblers in %g s with %g heap allocations per element.",
+		timer.elapsed(),
+		static_cast<double>(allocation_count - allocations_before_init) /
+			mesh->getNElements());
+	if (shape_matrices_cache)
+		INFO("Shared %u distinct shape matrix sets among all elements.",
+			static_cast<unsigned>(shape_matrices_cache->size()));
+
+	AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector>
+		global_assembler(A, rhs, dof_table);
+
+	auto const reset = [&]() {
+		A.setZero();
+		MathLib::setMatrixSparsity(A, sparsity_pattern);
+		rhs = 0;
+	};
+
+	double const serial_time = measure(repetitions, [&]() {
+			reset();
+			AssemblerLib::SerialExecutor::execute(global_assembler,
+				local_assemblers);
+		});
+	INFO("Serial assembly: %g s per assembly.", serial_time);
+
+	double const parallel_time = measure(repetitions, [&]() {
+			reset();
+			AssemblerLib::ParallelExecutor::executeColored(coloring,
+				global_assembler, local_assemblers);
+		});
+	INFO("Parallel assembly: %g s per assembly, speedup %g.",
+		parallel_time, serial_time / parallel_time);
+
+	// The matrix structure is fixed from here on.
+	timer.start();
+	AssemblerLib::GlobalMatrixScatterMap const scatter_map =
+		AssemblerLib::createScatterMap(A, dof_table);
+	global_assembler.setScatterMap(&scatter_map);
+	INFO("Computed scatter map in %g s.", timer.elapsed());
+
+	double const scatter_time = measure(repetitions, [&]() {
+			A.setZero();
+			rhs = 0;
+			AssemblerLib::ParallelExecutor::executeColored(coloring,
+				global_assembler, local_assemblers);
+		});
+	INFO("Parallel assembly using scatter map: %g s per assembly, speedup %g.",
+		scatter_time, serial_time / scatter_time);
+
+	// The local solution vectors are allocated in the construction of the
+	// global assembler; the first call with a solution set warms up any other
+	// buffers before the allocations of the steady state are counted.
+	GlobalVector const x(dof_table.dofSize());
+	global_assembler.setX(&x, &x);
+	AssemblerLib::SerialExecutor::execute(global_assembler, local_assemblers);
+	std::size_t const allocations_before = allocation_count;
+	AssemblerLib::SerialExecutor::execute(global_assembler, local_assemblers);
+	std::size_t const allocations = allocation_count - allocations_before;
+	INFO("Heap allocations in the assembly loop: %g per element.",
+		static_cast<double>(allocations) / mesh->getNElements());
+
+	// Product of the matrix applied element by element without assembly.
+	AssemblerLib::MatrixFreeOperator const matrix_free_operator(dof_table,
+		coloring, {local_assemblers.cbegin(), local_assemblers.cend()}, {});
+	std::vector<double> const v(dof_table.dofSize(), 1.0);
+	std::vector<double> w(dof_table.dofSize());
+	double const matrix_free_time = measure(repetitions, [&]() {
+			matrix_free_operator.amux(1.0, v.data(), w.data());
+		});
+	INFO("Matrix-free operator application: %g s per product.",
+		matrix_free_time);
+
+	for (auto p : all_mesh_subsets)
+		delete p;
+
+	delete custom_format;
+	delete logogCout;
+	LOGOG_SHUTDOWN();
+
+	return 0;
+}
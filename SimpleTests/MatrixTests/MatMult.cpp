@@ -12,11 +12,15 @@
  *
  */
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <cmath>
 #include <limits>
 #include <cstdlib>
+#include <string>
+#include <vector>
 
 #ifdef UNIX
 #include <sys/unistd.h>
@@ -34,9 +38,9 @@
 #include "BaseLib/CPUTime.h"
 #include "BaseLib/RunTime.h"
 
-#include "MathLib/LinAlg/Sparse/CRSMatrix.h"
-#include "MathLib/LinAlg/Sparse/CRSMatrixOpenMP.h"
-#include "MathLib/LinAlg/Sparse/CRSMatrixPThreads.h"
+#include "MathLib/LinAlg/Sparse/amuxCRS.h"
+#include "MathLib/LinAlg/Sparse/sparse.h"
+#include "MathLib/LinAlg/Sparse/SELLMatrix.h"
 
 /**
  * new formatter for logog
@@ -50,6 +54,38 @@ class FormatterCustom : public logog::FormatterGCC
     }
 };
 
+/**
+ * Performs the given number of matrix vector multiplications and reports the
+ * run time, the floating point performance, and the deviation of the result
+ * from the reference result.
+ */
+void benchmark(std::string const& name,
+	std::function<void(double const*, double*)> const& amux,
+	unsigned n, unsigned nnz, unsigned n_mults,
+	std::vector<double> const& x, std::vector<double> const& y_ref)
+{
+	std::vector<double> y(n);
+	BaseLib::RunTime run_timer;
+	BaseLib::CPUTime cpu_timer;
+	run_timer.start();
+	cpu_timer.start();
+	for (std::size_t k(0); k<n_mults; k++) {
+		amux (x.data(), y.data());
+	}
+	double const run_time (run_timer.elapsed());
+	double const cpu_time (cpu_timer.elapsed());
+
+	double max_deviation (0.0);
+	if (!y_ref.empty()) {
+		for (unsigned k(0); k<n; ++k)
+			max_deviation = std::max(max_deviation, std::abs(y[k] - y_ref[k]));
+	}
+
+	INFO("\t[MVM] %-22s took %e sec cpu time, %e sec run time, %6.2f GFLOP/s, max. deviation %e",
+		name.c_str(), cpu_time, run_time,
+		2.0 * nnz * n_mults / run_time * 1e-9, max_deviation);
+}
+
 int main(int argc, char *argv[])
 {
 	LOGOG_INITIALIZE();
@@ -71,6 +107,9 @@ int main(int argc, char *argv[])
 	TCLAP::ValueArg<unsigned> n_mults_arg("n", "number-of-multiplications", "number of multiplications to perform", true, 10, "number");
 	cmd.add( n_mults_arg );
 
+	TCLAP::ValueArg<unsigned> sigma_arg("s", "sigma", "number of rows sorted by length for the SELL-C-sigma format", false, 128, "number");
+	cmd.add( sigma_arg );
+
 	TCLAP::ValueArg<std::string> output_arg("o", "output", "output file", false, "", "string");
 	cmd.add( output_arg );
 
@@ -114,7 +153,7 @@ int main(int argc, char *argv[])
 	char *hostname(new char[max_host_name_len]);
 	if (gethostname(hostname, max_host_name_len) == 0)
 		INFO("hostname: %s", hostname);
-	delete [] host_name_len;
+	delete [] hostname;
 #endif
 
 	// *** reading matrix in crs format from file
@@ -155,32 +194,55 @@ int main(int argc, char *argv[])
 	}
 #endif
 
-#ifdef _OPENMP
-	omp_set_num_threads(n_threads);
-	MathLib::CRSMatrixOpenMP<double, unsigned> mat (n, iA, jA, A);
-#else
-	MathLib::CRSMatrix<double, unsigned> mat (n, iA, jA, A);
-#endif
+	std::vector<double> const x(n, 1.0);
 
-	double *x(new double[n]);
-	double *y(new double[n]);
+	// The plain compressed row storage result is the reference.
+	std::vector<double> y_ref(n);
+	MathLib::amuxCRS(1.0, n, iA, jA, A, x.data(), y_ref.data());
 
-	for (unsigned k(0); k<n; ++k)
-		x[k] = 1.0;
+	INFO("*** %d matrix vector multiplications (MVM) per format (%d threads) ...", n_mults, n_threads);
+	benchmark("CRS",
+		[&](double const* x, double* y)
+		{
+			MathLib::amuxCRS(1.0, n, iA, jA, A, x, y);
+		},
+		n, nnz, n_mults, x, y_ref);
+#ifdef _OPENMP
+	benchmark("CRS OpenMP",
+		[&](double const* x, double* y)
+		{
+			MathLib::amuxCRSParallelOpenMP(1.0, n, iA, jA, A, x, y);
+		},
+		n, nnz, n_mults, x, y_ref);
+#endif
 
-	INFO("*** %d matrix vector multiplications (MVM) with Toms amuxCRS (%d threads) ...", n_mults, n_threads);
-	BaseLib::RunTime run_timer;
-	BaseLib::CPUTime cpu_timer;
-	run_timer.start();
-	cpu_timer.start();
-	for (std::size_t k(0); k<n_mults; k++) {
-		mat.amux (1.0, x, y);
+	MathLib::SELLMatrix sell(n, iA, jA, A, sigma_arg.getValue());
+	INFO("\tSELL-%d-%d stores %d entries, %.1f%% padding", MathLib::SELLMatrix::chunk_size,
+		sigma_arg.getValue(), sell.getNStoredEntries(),
+		100.0 * (sell.getNStoredEntries() - nnz) / nnz);
+
+	using Kernel = MathLib::SELLMatrix::Kernel;
+	std::vector<std::pair<Kernel, std::string>> const kernels = {
+		{Kernel::Scalar, "SELL scalar"},
+		{Kernel::AVX2, "SELL AVX2"},
+		{Kernel::AVX512, "SELL AVX-512"}};
+	for (auto const& kernel : kernels) {
+		if (!MathLib::SELLMatrix::isSupported(kernel.first)) {
+			INFO("\t[MVM] %-22s not supported", kernel.second.c_str());
+			continue;
+		}
+		sell.setKernel(kernel.first);
+		benchmark(kernel.second,
+			[&sell](double const* x, double* y)
+			{
+				sell.amux(1.0, x, y);
+			},
+			n, nnz, n_mults, x, y_ref);
 	}
 
-	INFO("\t[MVM] - took %e sec cpu time, %e sec run time", cpu_timer.elapsed(), run_timer.elapsed());
-
-	delete [] x;
-	delete [] y;
+	delete [] iA;
+	delete [] jA;
+	delete [] A;
 
 	delete custom_format;
 	delete logogCout;
@@ -28,6 +28,7 @@ int main(int argc, char *argv[])
 	// *** reading matrix in crs format from file
 	std::string fname(argv[1]);
 	MathLib::CRSMatrixDiagPrecond *mat (new MathLib::CRSMatrixDiagPrecond(fname));
+	mat->calcPrecond();
 
 	unsigned n (mat->getNRows());
 	bool verbose (true);
@@ -82,6 +83,30 @@ int main(int argc, char *argv[])
 		std::cout << cpu_timer.elapsed() << std::endl;
 	}
 
+	// *** the pipelined variant with fused vector operations
+	for (std::size_t k(0); k<n; k++) {
+		x[k] = 0.0;
+	}
+	if (verbose)
+		std::cout << "solving system with pipelined PCG method (diagonal preconditioner) ... " << std::flush;
+
+	eps = 1.0e-6;
+	steps = 4000;
+	run_timer.start();
+	cpu_timer.start();
+
+	#ifdef _OPENMP
+	omp_set_num_threads(num_omp_threads);
+	#endif
+	MathLib::PipelinedCG(mat, b, x, eps, steps);
+
+	if (verbose) {
+		std::cout << " in " << steps << " iterations" << std::endl;
+		std::cout << "\t(residuum is " << eps << ") took " << cpu_timer.elapsed() << " sec time and " << run_timer.elapsed() << " sec" << std::endl;
+	} else {
+		std::cout << cpu_timer.elapsed() << std::endl;
+	}
+
 	delete mat;
 	delete [] x;
 	delete [] b;
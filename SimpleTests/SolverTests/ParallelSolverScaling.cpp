@@ -0,0 +1,126 @@
+/**
+ * \file
+ * \brief  Strong scaling test of the OpenMP parallel BiCGStab and GMRes.
+ *
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "BaseLib/RunTime.h"
+
+#include "MathLib/LinAlg/Solvers/BiCGStab.h"
+#include "MathLib/LinAlg/Solvers/GMRes.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixDiagPrecond.h"
+#include "MathLib/vector_io.h"
+
+#ifdef _OPENMP
+// Solves the system with the given solver for 1, 2, 4, ... and max_threads
+// threads and prints the run time, the speedup, and the parallel efficiency
+// with respect to one thread.
+template <typename Solver>
+void measureScaling(std::string const& name, unsigned n, double const* b,
+		unsigned max_threads, Solver solve)
+{
+	double *x(new double[n]);
+	double time_one_thread (0.0);
+
+	std::cout << name << std::endl;
+	std::cout << "threads  steps   residuum      time [s]  speedup  efficiency" << std::endl;
+	for (unsigned threads(1); threads <= max_threads; threads *= 2) {
+		for (unsigned k(0); k<n; k++) {
+			x[k] = 0.0;
+		}
+		omp_set_num_threads(threads);
+
+		double eps (1.0e-6);
+		unsigned steps (4000);
+		BaseLib::RunTime run_timer;
+		run_timer.start();
+		solve(b, x, eps, steps);
+		double const time (run_timer.elapsed());
+		if (threads == 1)
+			time_one_thread = time;
+
+		std::cout << std::setw(7) << threads << std::setw(7) << steps
+			<< std::setw(13) << eps << std::setw(12) << time
+			<< std::setw(9) << time_one_thread / time
+			<< std::setw(12) << time_one_thread / (time * threads) << std::endl;
+
+		// the last step is done with max_threads threads
+		if (threads < max_threads && 2 * threads > max_threads)
+			threads = max_threads / 2;
+	}
+	delete [] x;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+	if (argc != 4) {
+		std::cout << "Usage: " << argv[0] << " matrix rhs max-number-of-threads" << std::endl;
+		return -1;
+	}
+
+	unsigned const max_threads (atoi (argv[3]));
+
+	// *** reading matrix in crs format from file
+	std::string fname(argv[1]);
+	MathLib::CRSMatrixDiagPrecond *mat (new MathLib::CRSMatrixDiagPrecond(fname));
+	mat->calcPrecond();
+
+	unsigned n (mat->getNRows());
+	std::cout << "Parameters read: n=" << n << ", nnz=" << mat->getNNZ() << std::endl;
+
+	double *b(new double[n]);
+
+	// *** read rhs
+	fname = argv[2];
+	std::ifstream in(fname.c_str());
+	if (in) {
+		read (in, n, b);
+		in.close();
+	} else {
+		std::cout << "problem reading rhs - initializing b with 1.0" << std::endl;
+		for (std::size_t k(0); k<n; k++) {
+			b[k] = 1.0;
+		}
+	}
+
+#ifdef _OPENMP
+	measureScaling("BiCGStab (diagonal preconditioner)", n, b, max_threads,
+		[mat](double const* b, double* x, double& eps, unsigned& steps) {
+			MathLib::BiCGStabParallel(*mat, b, x, eps, steps);
+		});
+	measureScaling("GMRes(30) (diagonal preconditioner)", n, b, max_threads,
+		[mat](double const* b, double* x, double& eps, unsigned& steps) {
+			MathLib::GMResParallel(*mat, b, x, eps, 30, steps);
+		});
+	measureScaling("GMRes with restart length tuned up to 30 (diagonal preconditioner)",
+		n, b, max_threads,
+		[mat](double const* b, double* x, double& eps, unsigned& steps) {
+			MathLib::GMResParallel(*mat, b, x, eps, 30, steps, true);
+		});
+#else
+	(void) max_threads;
+	std::cout << "OpenMP is not switched on" << std::endl;
+#endif
+
+	delete mat;
+	delete [] b;
+
+	return 0;
+}
@@ -109,3 +109,29 @@ TEST_F(AssemblerLibLocalToGlobalIndexMapTest, SubsetByComponent)
         delete p;
     delete selected_subset;
 }
+
+TEST_F(AssemblerLibLocalToGlobalIndexMapTest, ElementIndicesOrderedByComponent)
+{
+    dof_map = new AssemblerLib::LocalToGlobalIndexMap(components,
+        AssemblerLib::ComponentOrder::BY_LOCATION);
+
+    ASSERT_EQ(mesh->getNElements(), dof_map->size());
+    for (std::size_t e = 0; e < dof_map->size(); ++e)
+    {
+        // The indices of all components are the concatenation of the
+        // indices of each component.
+        std::vector<GlobalIndexType> expected;
+        for (unsigned c = 0; c < dof_map->getNumComponents(); ++c)
+        {
+            auto const rows = (*dof_map)(e, c).rows;
+            ASSERT_EQ(mesh->getElement(e)->getNNodes(), rows.size());
+            expected.insert(expected.end(), rows.begin(), rows.end());
+        }
+
+        auto const indices = (*dof_map)(e);
+        ASSERT_EQ(expected.size(), dof_map->getNumElementDOF(e));
+        ASSERT_TRUE(indices.rows ==
+                    MathLib::IndexSpan<GlobalIndexType>(expected));
+        ASSERT_TRUE(indices.columns == indices.rows);
+    }
+}
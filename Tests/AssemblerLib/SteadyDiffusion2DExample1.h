@@ -16,6 +16,8 @@
 #include <cmath>
 #include <vector>
 
+#include "AssemblerLib/GlobalMatrixTriplets.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
 #include "MathLib/LinAlg/Dense/DenseMatrix.h"
 #include "MathLib/LinAlg/Dense/DenseVector.h"
 
@@ -57,6 +59,13 @@ template<typename IndexType>struct SteadyDiffusion2DExample1
 			rhs.add(indices.rows, *_localRhs);
 		}
 
+		void addToGlobal(AssemblerLib::GlobalMatrixTriplets& triplets,
+				std::size_t const id,
+				AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const& indices) const
+		{
+			triplets.add(id, indices.rows, *_localA, *_localRhs);
+		}
+
 
 		LocalMatrixType const& getLocalMatrix() const
 		{
@@ -0,0 +1,195 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <array>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifdef OGS_USE_EIGEN
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+
+#include "MeshLib/Elements/Tet.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/Properties.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "NumLib/Fem/Integration/GaussIntegrationPolicy.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex8.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTet4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri3.h"
+
+#include "ProcessLib/GroundwaterFlowBatchedFEM.h"
+#include "ProcessLib/GroundwaterFlowFEM.h"
+
+namespace
+{
+/// Splits each hexahedron into six positively oriented tetrahedra sharing
+/// the diagonal from the hexahedron's first to its seventh node.
+std::vector<std::unique_ptr<MeshLib::Element>> splitIntoTets(
+    MeshLib::Mesh const& hex_mesh)
+{
+    std::array<std::array<unsigned, 4>, 6> const tets{{
+        {{0, 1, 2, 6}}, {{0, 2, 3, 6}}, {{0, 3, 7, 6}},
+        {{0, 7, 4, 6}}, {{0, 4, 5, 6}}, {{0, 5, 1, 6}}}};
+
+    std::vector<std::unique_ptr<MeshLib::Element>> elements;
+    for (auto const* hex : hex_mesh.getElements())
+    {
+        for (auto const& tet : tets)
+        {
+            std::array<MeshLib::Node*, 4> nodes;
+            for (unsigned i = 0; i < 4; ++i)
+                nodes[i] = const_cast<MeshLib::Node*>(hex->getNode(tet[i]));
+
+            double const* const p0 = nodes[0]->getCoords();
+            std::array<std::array<double, 3>, 3> e;
+            for (unsigned i = 0; i < 3; ++i)
+                for (unsigned d = 0; d < 3; ++d)
+                    e[i][d] = nodes[i + 1]->getCoords()[d] - p0[d];
+            double const volume =
+                e[0][0] * (e[1][1] * e[2][2] - e[1][2] * e[2][1]) -
+                e[0][1] * (e[1][0] * e[2][2] - e[1][2] * e[2][0]) +
+                e[0][2] * (e[1][0] * e[2][1] - e[1][1] * e[2][0]);
+            if (volume < 0)
+                std::swap(nodes[1], nodes[2]);
+
+            elements.emplace_back(new MeshLib::Tet(nodes));
+        }
+    }
+    return elements;
+}
+
+/// Compares the batched local matrices of all given elements with the local
+/// matrices of the element-wise assembly.
+template <typename ShapeFunction, unsigned GlobalDim, unsigned BatchSize>
+void checkBatchedLocalMatrices(
+    std::vector<MeshLib::Element const*> const& elements,
+    ProcessLib::Parameter<double, MeshLib::Element const&> const&
+        hydraulic_conductivity)
+{
+    using GlobalMatrix = MathLib::EigenMatrix;
+    using GlobalVector = MathLib::EigenVector;
+    using IntegrationMethod = typename NumLib::GaussIntegrationPolicy<
+        typename ShapeFunction::MeshElement>::IntegrationMethod;
+    using LocalAssembler = ProcessLib::GroundwaterFlow::LocalAssemblerData<
+        ShapeFunction, IntegrationMethod, GlobalMatrix, GlobalVector,
+        GlobalDim>;
+    using BatchedLocalAssembler =
+        ProcessLib::GroundwaterFlow::BatchedLocalAssemblerData<
+            ShapeFunction, IntegrationMethod, GlobalDim, BatchSize>;
+
+    unsigned const integration_order = 2;
+    std::size_t const n = ShapeFunction::NPOINTS;
+
+    // The last batch is only partially filled.
+    ASSERT_NE(0u, elements.size() % BatchSize);
+
+    BatchedLocalAssembler batched(elements, hydraulic_conductivity,
+                                  integration_order);
+    ASSERT_EQ(elements.size(), batched.size());
+    batched.assemble();
+
+    std::vector<GlobalIndexType> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    AssemblerLib::LocalToGlobalIndexMap::RowColumnIndices const r_c_indices(
+        indices, indices);
+    std::vector<double> const local_x;
+
+    for (std::size_t i = 0; i < elements.size(); ++i)
+    {
+        LocalAssembler local_assembler;
+        local_assembler.init(*elements[i], n, hydraulic_conductivity,
+                             integration_order, nullptr, nullptr);
+        local_assembler.assemble(local_x, local_x);
+
+        GlobalMatrix A(n);
+        GlobalVector rhs(n);
+        local_assembler.addToGlobal(A, rhs, r_c_indices);
+
+        auto const K = batched.getLocalMatrix(i);
+        for (std::size_t a = 0; a < n; ++a)
+            for (std::size_t b = 0; b < n; ++b)
+                ASSERT_NEAR(A.get(a, b), K(a, b), 1e-14);
+    }
+}
+
+template <typename ShapeFunction, unsigned GlobalDim, unsigned BatchSize>
+void checkBatchedLocalMatrices(
+    MeshLib::Mesh const& mesh,
+    ProcessLib::Parameter<double, MeshLib::Element const&> const&
+        hydraulic_conductivity)
+{
+    checkBatchedLocalMatrices<ShapeFunction, GlobalDim, BatchSize>(
+        std::vector<MeshLib::Element const*>(mesh.getElements().cbegin(),
+                                             mesh.getElements().cend()),
+        hydraulic_conductivity);
+}
+}  // namespace
+
+TEST(AssemblerLibBatchedLocalAssembly, Tri3)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularTriMesh(1.0, 3));
+    checkBatchedLocalMatrices<NumLib::ShapeTri3, 2, 4>(
+        *mesh, ProcessLib::ConstParameter<double>(1.5));
+}
+
+TEST(AssemblerLibBatchedLocalAssembly, Quad4)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularQuadMesh(2.0, 3));
+    checkBatchedLocalMatrices<NumLib::ShapeQuad4, 2, 8>(
+        *mesh, ProcessLib::ConstParameter<double>(1.5));
+}
+
+TEST(AssemblerLibBatchedLocalAssembly, Tet4)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 3));
+    auto const tets = splitIntoTets(*mesh);
+
+    std::vector<MeshLib::Element const*> elements;
+    for (auto const& tet : tets)
+        elements.push_back(tet.get());
+    checkBatchedLocalMatrices<NumLib::ShapeTet4, 3, 8>(
+        elements, ProcessLib::ConstParameter<double>(1.5));
+}
+
+TEST(AssemblerLibBatchedLocalAssembly, Hex8)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 3));
+    checkBatchedLocalMatrices<NumLib::ShapeHex8, 3, 8>(
+        *mesh, ProcessLib::ConstParameter<double>(1.5));
+}
+
+TEST(AssemblerLibBatchedLocalAssembly, Hex8HeterogeneousConductivity)
+{
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 3));
+    auto conductivity =
+        mesh->getProperties().createNewPropertyVector<double>(
+            "conductivity", MeshLib::MeshItemType::Cell);
+    ASSERT_TRUE(bool(conductivity));
+    for (std::size_t i = 0; i < mesh->getNElements(); ++i)
+        conductivity->push_back(1.0 + 0.25 * i);
+
+    checkBatchedLocalMatrices<NumLib::ShapeHex8, 3, 8>(
+        *mesh, ProcessLib::MeshPropertyParameter<double>(*conductivity));
+}
+
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,110 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AssemblerLib/ComputeSparsityPattern.h"
+#include "AssemblerLib/LocalAssemblerBuilder.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#include "MathLib/LinAlg/SetMatrixSparsity.h"
+
+#include "MeshLib/MeshSubsets.h"
+
+#include "SteadyDiffusion2DExample1.h"
+
+#ifdef OGS_USE_EIGEN
+TEST(AssemblerLibComputeSparsityPattern, CompressedPatternOfSteadyDiffusion)
+{
+    using Example = SteadyDiffusion2DExample1<GlobalIndexType>;
+    Example ex1;
+
+    using GlobalMatrix = MathLib::EigenMatrix;
+    using GlobalVector = MathLib::EigenVector;
+    using LocalAssembler =
+        Example::LocalAssemblerData<GlobalMatrix, GlobalVector>;
+
+    MeshLib::MeshSubset const mesh_items_all_nodes(*ex1.msh,
+                                                   &ex1.msh->getNodes());
+    std::vector<MeshLib::MeshSubsets*> vec_comp_dis;
+    vec_comp_dis.push_back(new MeshLib::MeshSubsets(&mesh_items_all_nodes));
+    AssemblerLib::LocalToGlobalIndexMap const dof_table(
+        vec_comp_dis, AssemblerLib::ComponentOrder::BY_COMPONENT);
+
+    auto const sparsity_pattern =
+        AssemblerLib::computeCompressedSparsityPattern(dof_table);
+    ASSERT_EQ(dof_table.dofSize(), sparsity_pattern.size());
+
+    // The row sizes agree with the pattern computed from the node adjacency,
+    // and the columns are sorted and unique.
+    auto const row_sizes =
+        AssemblerLib::computeSparsityPattern(dof_table, *ex1.msh);
+    for (std::size_t row = 0; row < sparsity_pattern.size(); ++row)
+    {
+        ASSERT_EQ(row_sizes[row], sparsity_pattern.getRowSize(row));
+        auto const begin = sparsity_pattern.col_idx.cbegin() +
+                           sparsity_pattern.row_ptr[row];
+        auto const end = sparsity_pattern.col_idx.cbegin() +
+                         sparsity_pattern.row_ptr[row + 1];
+        ASSERT_TRUE(std::adjacent_find(begin, end,
+            [](GlobalIndexType a, GlobalIndexType b) { return a >= b; })
+            == end);
+        ASSERT_TRUE(std::binary_search(begin, end, row));
+    }
+
+    std::vector<LocalAssembler*> local_assemblers(ex1.msh->getNElements());
+    AssemblerLib::LocalAssemblerBuilder<
+        MeshLib::Element,
+        void(const MeshLib::Element&, LocalAssembler*&, std::size_t const,
+             Example const&)>
+        local_asm_builder(
+            Example::initializeLocalData<GlobalMatrix, GlobalVector>,
+            dof_table);
+    AssemblerLib::SerialExecutor::execute(
+        local_asm_builder, ex1.msh->getElements(), local_assemblers, ex1);
+
+    // Reference assembly into an empty matrix.
+    GlobalMatrix A_ref(dof_table.dofSize());
+    GlobalVector rhs_ref(dof_table.dofSize());
+    AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector>
+        assembler_ref(A_ref, rhs_ref, dof_table);
+    AssemblerLib::SerialExecutor::execute(assembler_ref, local_assemblers);
+
+    // The assembly into the created structure does not insert any entries.
+    GlobalMatrix A(dof_table.dofSize());
+    GlobalVector rhs(dof_table.dofSize());
+    MathLib::setMatrixSparsity(A, sparsity_pattern);
+    ASSERT_TRUE(A.getRawMatrix().isCompressed());
+    ASSERT_EQ(sparsity_pattern.col_idx.size(),
+              static_cast<std::size_t>(A.getRawMatrix().nonZeros()));
+
+    AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector> assembler(
+        A, rhs, dof_table);
+    AssemblerLib::SerialExecutor::execute(assembler, local_assemblers);
+
+    ASSERT_TRUE(A.getRawMatrix().isCompressed());
+    ASSERT_EQ(sparsity_pattern.col_idx.size(),
+              static_cast<std::size_t>(A.getRawMatrix().nonZeros()));
+    for (std::size_t i = 0; i < A.getNRows(); ++i)
+        for (std::size_t j = 0; j < A.getNCols(); ++j)
+            ASSERT_EQ(A_ref.get(i, j), A.get(i, j));
+
+    for (auto p : local_assemblers)
+        delete p;
+    for (auto p : vec_comp_dis)
+        delete p;
+}
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,93 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AssemblerLib/ComputeElementColoring.h"
+#include "AssemblerLib/ParallelExecutor.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+class AssemblerLibElementColoringTest : public ::testing::Test
+{
+public:
+    AssemblerLibElementColoringTest()
+        : mesh(MeshLib::MeshGenerator::generateRegularHexMesh(1.0, mesh_size)),
+          coloring(AssemblerLib::computeElementColoring(mesh->getElements()))
+    {}
+
+    /// Returns a function adding one to each node entry of the element; the
+    /// entries equal the number of elements connected to the node when
+    /// executed for all elements.
+    static std::function<void(std::size_t, MeshLib::Element const*)>
+    addElementToNodes(std::vector<double>& node_values)
+    {
+        return [&node_values](std::size_t const /*id*/,
+                              MeshLib::Element const* e)
+        {
+            for (unsigned i = 0; i < e->getNNodes(); ++i)
+                node_values[e->getNodeIndex(i)] += 1.0;
+        };
+    }
+
+protected:
+    static std::size_t const mesh_size = 8;
+    std::unique_ptr<MeshLib::Mesh> mesh;
+    AssemblerLib::ElementColoring const coloring;
+};
+
+TEST_F(AssemblerLibElementColoringTest, EachElementColoredOnce)
+{
+    std::vector<unsigned> n_colors(mesh->getNElements(), 0);
+    for (auto const& color : coloring)
+        for (auto const i : color)
+            n_colors[i]++;
+
+    for (auto const n : n_colors)
+        ASSERT_EQ(1u, n);
+
+    // The greedy coloring of a structured hex mesh needs eight colors.
+    ASSERT_EQ(8u, coloring.size());
+}
+
+TEST_F(AssemblerLibElementColoringTest, ColorsAreConflictFree)
+{
+    for (auto const& color : coloring)
+    {
+        std::vector<bool> node_used(mesh->getNNodes(), false);
+        for (auto const i : color)
+        {
+            auto const& e = *mesh->getElement(i);
+            for (unsigned k = 0; k < e.getNNodes(); ++k)
+            {
+                ASSERT_FALSE(node_used[e.getNodeIndex(k)]);
+                node_used[e.getNodeIndex(k)] = true;
+            }
+        }
+    }
+}
+
+TEST_F(AssemblerLibElementColoringTest, ParallelExecutorMatchesSerial)
+{
+    std::vector<double> serial(mesh->getNNodes(), 0);
+    AssemblerLib::SerialExecutor::execute(addElementToNodes(serial),
+                                          mesh->getElements());
+
+    std::vector<double> parallel(mesh->getNNodes(), 0);
+    AssemblerLib::ParallelExecutor::executeColored(
+        coloring, addElementToNodes(parallel), mesh->getElements());
+
+    ASSERT_EQ(serial, parallel);
+}
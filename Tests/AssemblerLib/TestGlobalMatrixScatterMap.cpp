@@ -0,0 +1,131 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AssemblerLib/ComputeSparsityPattern.h"
+#include "AssemblerLib/GlobalMatrixScatterMap.h"
+#include "AssemblerLib/LocalAssemblerBuilder.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#include "MathLib/LinAlg/SetMatrixSparsity.h"
+
+#include "MeshLib/MeshSubsets.h"
+
+#include "SteadyDiffusion2DExample1.h"
+
+#ifdef OGS_USE_EIGEN
+namespace
+{
+/// Compares the assembly through the scatter map with the searching add into
+/// a full matrix. A symmetric matrix is additionally assembled by the
+/// searching add.
+void checkScatterMapAssembly(bool const symmetric)
+{
+    using Example = SteadyDiffusion2DExample1<GlobalIndexType>;
+    Example ex1;
+
+    using GlobalMatrix = MathLib::EigenMatrix;
+    using GlobalVector = MathLib::EigenVector;
+    using LocalAssembler =
+        Example::LocalAssemblerData<GlobalMatrix, GlobalVector>;
+
+    MeshLib::MeshSubset const mesh_items_all_nodes(*ex1.msh,
+                                                   &ex1.msh->getNodes());
+    std::vector<MeshLib::MeshSubsets*> vec_comp_dis;
+    vec_comp_dis.push_back(new MeshLib::MeshSubsets(&mesh_items_all_nodes));
+    AssemblerLib::LocalToGlobalIndexMap const dof_table(
+        vec_comp_dis, AssemblerLib::ComponentOrder::BY_COMPONENT);
+
+    std::vector<LocalAssembler*> local_assemblers(ex1.msh->getNElements());
+    AssemblerLib::LocalAssemblerBuilder<
+        MeshLib::Element,
+        void(const MeshLib::Element&, LocalAssembler*&, std::size_t const,
+             Example const&)>
+        local_asm_builder(
+            Example::initializeLocalData<GlobalMatrix, GlobalVector>,
+            dof_table);
+    AssemblerLib::SerialExecutor::execute(
+        local_asm_builder, ex1.msh->getElements(), local_assemblers, ex1);
+
+    // Reference assembly using the searching add.
+    GlobalMatrix A_ref(dof_table.dofSize());
+    GlobalVector rhs_ref(dof_table.dofSize());
+    AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector>
+        assembler_ref(A_ref, rhs_ref, dof_table);
+    AssemblerLib::SerialExecutor::execute(assembler_ref, local_assemblers);
+
+    // Assembly through the scatter map; assembled twice to check that the
+    // matrix structure is kept.
+    GlobalMatrix A(dof_table.dofSize());
+    GlobalVector rhs(dof_table.dofSize());
+    if (symmetric)
+        A.setSymmetric();
+    MathLib::setMatrixSparsity(
+        A, AssemblerLib::computeSparsityPattern(dof_table, *ex1.msh));
+    AssemblerLib::GlobalMatrixScatterMap const scatter_map =
+        AssemblerLib::createScatterMap(A, dof_table);
+    ASSERT_FALSE(scatter_map.empty());
+
+    AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector> assembler(
+        A, rhs, dof_table);
+    assembler.setScatterMap(&scatter_map);
+    for (int i = 0; i < 2; ++i)
+    {
+        A.setZero();
+        AssemblerLib::SerialExecutor::execute(assembler, local_assemblers);
+    }
+
+    ASSERT_TRUE(A.getRawMatrix().isCompressed());
+    for (std::size_t i = 0; i < A.getNRows(); ++i)
+        for (std::size_t j = 0; j < A.getNCols(); ++j)
+            ASSERT_EQ(A_ref.get(i, j), A.get(i, j));
+
+    if (symmetric)
+    {
+        // The upper triangle only.
+        auto const n_full = A_ref.getRawMatrix().nonZeros();
+        auto const n = static_cast<decltype(n_full)>(A.getNRows());
+        ASSERT_EQ((n_full + n) / 2, A.getRawMatrix().nonZeros());
+
+        GlobalMatrix A_searching(dof_table.dofSize());
+        A_searching.setSymmetric();
+        AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector>
+            assembler_searching(A_searching, rhs, dof_table);
+        AssemblerLib::SerialExecutor::execute(assembler_searching,
+                                              local_assemblers);
+        for (std::size_t i = 0; i < A.getNRows(); ++i)
+            for (std::size_t j = 0; j < A.getNCols(); ++j)
+                ASSERT_EQ(A.get(i, j), A_searching.get(i, j));
+    }
+
+    for (auto p : local_assemblers)
+        delete p;
+    for (auto p : vec_comp_dis)
+        delete p;
+}
+}  // namespace
+
+TEST(AssemblerLibGlobalMatrixScatterMap, AssembleLikeSearchingAdd)
+{
+    checkScatterMapAssembly(false);
+}
+
+TEST(AssemblerLibGlobalMatrixScatterMap, SymmetricUpperTriangle)
+{
+    checkScatterMapAssembly(true);
+}
+#endif  // OGS_USE_EIGEN
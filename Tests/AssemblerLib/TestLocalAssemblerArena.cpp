@@ -0,0 +1,109 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AssemblerLib/LocalAssemblerArena.h"
+
+#ifdef OGS_USE_EIGEN
+#include "AssemblerLib/LocalDataInitializer.h"
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "ProcessLib/GroundwaterFlowFEM.h"
+#endif
+
+namespace
+{
+struct Interface
+{
+    virtual ~Interface() = default;
+    virtual int value() const = 0;
+};
+
+int n_alive = 0;
+
+template <int Value, std::size_t Padding>
+struct Object : public Interface
+{
+    Object() { ++n_alive; }
+    ~Object() { --n_alive; }
+    int value() const override { return Value; }
+
+    char padding[Padding];
+};
+}  // namespace
+
+TEST(AssemblerLibLocalAssemblerArena, ObjectsOfOneTypeAreContiguous)
+{
+    using A = Object<1, 3>;
+    using B = Object<2, 40>;
+
+    {
+        AssemblerLib::LocalAssemblerArena<Interface> arena;
+        arena.reserve<A>(3);
+        arena.reserve<B>(2);
+
+        std::vector<Interface*> objects;
+        objects.push_back(arena.emplace<A>());
+        objects.push_back(arena.emplace<B>());
+        objects.push_back(arena.emplace<A>());
+        objects.push_back(arena.emplace<A>());
+        objects.push_back(arena.emplace<B>());
+        ASSERT_EQ(5, n_alive);
+
+        std::vector<int> const expected_values{1, 2, 1, 1, 2};
+        for (std::size_t i = 0; i < objects.size(); ++i)
+            ASSERT_EQ(expected_values[i], objects[i]->value());
+
+        auto const* const a = static_cast<A*>(objects[0]);
+        ASSERT_EQ(a + 1, static_cast<A*>(objects[2]));
+        ASSERT_EQ(a + 2, static_cast<A*>(objects[3]));
+        ASSERT_EQ(static_cast<B*>(objects[1]) + 1, static_cast<B*>(objects[4]));
+
+        arena.clear();
+        ASSERT_EQ(0, n_alive);
+
+        arena.reserve<A>(1);
+        arena.emplace<A>();
+        ASSERT_EQ(1, n_alive);
+    }
+    ASSERT_EQ(0, n_alive);
+}
+
+#ifdef OGS_USE_EIGEN
+TEST(AssemblerLibLocalAssemblerArena, LocalDataInitializerKeepsElementOrder)
+{
+    using GlobalMatrix = MathLib::EigenMatrix;
+    using GlobalVector = MathLib::EigenVector;
+    using LocalDataInitializer = AssemblerLib::LocalDataInitializer<
+        ProcessLib::GroundwaterFlow::LocalAssemblerDataInterface,
+        ProcessLib::GroundwaterFlow::LocalAssemblerData,
+        GlobalMatrix, GlobalVector, 2>;
+
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 4));
+
+    LocalDataInitializer const initializer;
+    LocalDataInitializer::Arena arena;
+    std::vector<LocalDataInitializer::LocalAssemblerInterface*> data;
+    initializer.allocate(mesh->getElements(), data, arena);
+
+    ASSERT_EQ(mesh->getNElements(), data.size());
+    auto const* const first = reinterpret_cast<char const*>(data[0]);
+    std::ptrdiff_t const stride = reinterpret_cast<char const*>(data[1]) - first;
+    ASSERT_LT(0, stride);
+    for (std::size_t i = 0; i < data.size(); ++i)
+        ASSERT_EQ(first + i * stride, reinterpret_cast<char const*>(data[i]));
+}
+#endif  // OGS_USE_EIGEN
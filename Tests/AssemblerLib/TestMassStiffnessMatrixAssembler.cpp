@@ -0,0 +1,124 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifdef OGS_USE_EIGEN
+
+#include "AssemblerLib/LocalAssemblerBuilder.h"
+#include "AssemblerLib/LocalDataInitializer.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MassStiffnessMatrixAssembler.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshSubsets.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "ProcessLib/GroundwaterFlowFEM.h"
+
+namespace
+{
+using GlobalMatrix = MathLib::EigenMatrix;
+using GlobalVector = MathLib::EigenVector;
+
+/// Assembles the storage and conductivity matrices of the groundwater flow
+/// local assemblers and compares the latter with the steady-state assembly.
+template <unsigned GlobalDim>
+void checkMassStiffnessMatrices(MeshLib::Mesh const& mesh,
+                                double const expected_volume)
+{
+    using LocalDataInitializer = AssemblerLib::LocalDataInitializer<
+        ProcessLib::GroundwaterFlow::LocalAssemblerDataInterface,
+        ProcessLib::GroundwaterFlow::LocalAssemblerData,
+        GlobalMatrix, GlobalVector, GlobalDim>;
+    using LocalAssembler =
+        typename LocalDataInitializer::LocalAssemblerInterface;
+    using Storage = ProcessLib::Parameter<double, MeshLib::Element const&>;
+
+    MeshLib::MeshSubset const mesh_subset_all_nodes(mesh, &mesh.getNodes());
+    std::vector<MeshLib::MeshSubsets*> all_mesh_subsets{
+        new MeshLib::MeshSubsets(&mesh_subset_all_nodes)};
+    AssemblerLib::LocalToGlobalIndexMap const dof_table(
+        all_mesh_subsets, AssemblerLib::ComponentOrder::BY_COMPONENT);
+
+    ProcessLib::ConstParameter<double> const conductivity(2.5);
+    ProcessLib::ConstParameter<double> const storage(0.5);
+
+    // Once with and once without storage term.
+    LocalDataInitializer initializer;
+    std::vector<typename LocalDataInitializer::Arena> arenas(2);
+    std::vector<std::vector<LocalAssembler*>> local_assemblers(2);
+    AssemblerLib::LocalAssemblerBuilder<MeshLib::Element, LocalDataInitializer>
+        local_asm_builder(initializer, dof_table);
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        initializer.allocate(mesh.getElements(), local_assemblers[i],
+                             arenas[i]);
+        AssemblerLib::SerialExecutor::execute(
+            local_asm_builder, mesh.getElements(), local_assemblers[i],
+            conductivity, 2u,
+            static_cast<NumLib::ShapeMatricesCache*>(nullptr),
+            static_cast<Storage const*>(i == 0 ? &storage : nullptr));
+    }
+
+    std::size_t const n = dof_table.dofSize();
+    GlobalMatrix M(n);
+    GlobalMatrix K(n);
+    GlobalVector rhs(n);
+    AssemblerLib::MassStiffnessMatrixAssembler<GlobalMatrix, GlobalVector>
+        mass_stiffness_assembler(M, K, rhs, dof_table);
+    AssemblerLib::SerialExecutor::execute(mass_stiffness_assembler,
+                                          local_assemblers[0]);
+
+    GlobalMatrix A(n);
+    AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector> assembler(
+        A, rhs, dof_table);
+    AssemblerLib::SerialExecutor::execute(assembler, local_assemblers[1]);
+
+    // The storage matrix is symmetric and its entries sum up to the integral
+    // of the storage over the domain.
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            sum += M.get(i, j);
+            ASSERT_NEAR(M.get(j, i), M.get(i, j), 1e-15);
+            ASSERT_EQ(A.get(i, j), K.get(i, j));
+        }
+    ASSERT_NEAR(0.5 * expected_volume, sum, 1e-12);
+
+    for (auto p : all_mesh_subsets)
+        delete p;
+}
+}  // namespace
+
+TEST(AssemblerLibMassStiffnessMatrixAssembler, HexMesh)
+{
+    std::unique_ptr<MeshLib::Mesh> const mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(2.0, 3));
+    checkMassStiffnessMatrices<3>(*mesh, 8.0);
+}
+
+TEST(AssemblerLibMassStiffnessMatrixAssembler, TriMesh)
+{
+    // Linear triangles store a single set of shape matrices.
+    std::unique_ptr<MeshLib::Mesh> const mesh(
+        MeshLib::MeshGenerator::generateRegularTriMesh(1.0, 4));
+    checkMassStiffnessMatrices<2>(*mesh, 1.0);
+}
+
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,229 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifdef OGS_USE_EIGEN
+
+#include "AssemblerLib/ComputeElementColoring.h"
+#include "AssemblerLib/LocalAssemblerBuilder.h"
+#include "AssemblerLib/LocalDataInitializer.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/MatrixFreeOperator.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#include "MathLib/LinAlg/Solvers/LinearOperatorSolvers.h"
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshSubsets.h"
+#include "MeshLib/Node.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+
+#include "ProcessLib/GroundwaterFlowFEM.h"
+
+namespace
+{
+using GlobalMatrix = MathLib::EigenMatrix;
+using GlobalVector = MathLib::EigenVector;
+using LocalDataInitializer = AssemblerLib::LocalDataInitializer<
+    ProcessLib::GroundwaterFlow::LocalAssemblerDataInterface,
+    ProcessLib::GroundwaterFlow::LocalAssemblerData,
+    GlobalMatrix, GlobalVector, 3>;
+using LocalAssembler = LocalDataInitializer::LocalAssemblerInterface;
+using Storage = ProcessLib::Parameter<double, MeshLib::Element const&>;
+
+/// Groundwater flow local assemblers on a regular hex mesh.
+class AssemblerLibMatrixFreeOperator : public ::testing::Test
+{
+public:
+    AssemblerLibMatrixFreeOperator()
+        : _mesh(MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 4)),
+          _mesh_subset_all_nodes(*_mesh, &_mesh->getNodes()),
+          _conductivity(2.5)
+    {
+        _all_mesh_subsets.push_back(
+            new MeshLib::MeshSubsets(&_mesh_subset_all_nodes));
+        _dof_table.reset(new AssemblerLib::LocalToGlobalIndexMap(
+            _all_mesh_subsets, AssemblerLib::ComponentOrder::BY_COMPONENT));
+
+        _element_coloring =
+            AssemblerLib::computeElementColoring(_mesh->getElements());
+
+        LocalDataInitializer initializer;
+        initializer.allocate(_mesh->getElements(), _local_assemblers, _arena);
+        AssemblerLib::LocalAssemblerBuilder<MeshLib::Element,
+                                            LocalDataInitializer>
+            local_asm_builder(initializer, *_dof_table);
+        unsigned const integration_order = 2;
+        AssemblerLib::SerialExecutor::execute(
+            local_asm_builder, _mesh->getElements(), _local_assemblers,
+            _conductivity, integration_order,
+            static_cast<NumLib::ShapeMatricesCache*>(nullptr),
+            static_cast<Storage const*>(nullptr));
+    }
+
+    ~AssemblerLibMatrixFreeOperator()
+    {
+        for (auto p : _all_mesh_subsets)
+            delete p;
+    }
+
+    std::unique_ptr<AssemblerLib::MatrixFreeOperator> createOperator(
+        std::vector<GlobalIndexType> const& known_ids) const
+    {
+        return std::unique_ptr<AssemblerLib::MatrixFreeOperator>(
+            new AssemblerLib::MatrixFreeOperator(
+                *_dof_table, _element_coloring,
+                {_local_assemblers.cbegin(), _local_assemblers.cend()},
+                known_ids));
+    }
+
+    /// Explicitly assembled global matrix.
+    std::unique_ptr<GlobalMatrix> assembleMatrix() const
+    {
+        std::unique_ptr<GlobalMatrix> A(new GlobalMatrix(_dof_table->dofSize()));
+        GlobalVector rhs(_dof_table->dofSize());
+        AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector>
+            assembler(*A, rhs, *_dof_table);
+        AssemblerLib::SerialExecutor::execute(assembler, _local_assemblers);
+        return A;
+    }
+
+    /// Solves with head 1 at x = 0 and head 0 at x = 1, and compares with the
+    /// exact linear solution.
+    template <typename Solver>
+    void checkSolution(Solver solver) const
+    {
+        std::vector<GlobalIndexType> known_ids;
+        std::vector<double> known_values;
+        for (auto const* node : _mesh->getNodes())
+        {
+            double const x = (*node)[0];
+            if (x == 0.0 || x == 1.0)
+            {
+                known_ids.push_back(node->getID());
+                known_values.push_back(1.0 - x);
+            }
+        }
+
+        auto const op = createOperator(known_ids);
+        std::size_t const n = op->getNRows();
+        std::vector<double> b(n, 0.0);
+        std::vector<double> h(n, 0.0);
+        op->applyKnownSolution(b.data(), h.data(), known_values);
+
+        double eps = 1e-12;
+        unsigned n_steps = 1000;
+        ASSERT_EQ(0u, solver(*op, b.data(), h.data(), eps, n_steps));
+        ASSERT_LT(0u, n_steps);
+
+        for (auto const* node : _mesh->getNodes())
+            ASSERT_NEAR(1.0 - (*node)[0], h[node->getID()], 1e-9);
+    }
+
+protected:
+    std::unique_ptr<MeshLib::Mesh> _mesh;
+    MeshLib::MeshSubset const _mesh_subset_all_nodes;
+    std::vector<MeshLib::MeshSubsets*> _all_mesh_subsets;
+    std::unique_ptr<AssemblerLib::LocalToGlobalIndexMap> _dof_table;
+    AssemblerLib::ElementColoring _element_coloring;
+
+    ProcessLib::ConstParameter<double> const _conductivity;
+    LocalDataInitializer::Arena _arena;
+    std::vector<LocalAssembler*> _local_assemblers;
+};
+}  // namespace
+
+TEST_F(AssemblerLibMatrixFreeOperator, ProductEqualsAssembledMatrix)
+{
+    auto const A = assembleMatrix();
+    auto const op = createOperator({});
+    std::size_t const n = op->getNRows();
+    ASSERT_EQ(A->getNRows(), n);
+
+    std::vector<double> x(n);
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = std::sin(0.3 * i) + 1.0;
+
+    std::vector<double> y(n, -1.0);
+    op->amux(2.0, x.data(), y.data());
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        double y_ref = 0.0;
+        for (std::size_t j = 0; j < n; ++j)
+            y_ref += A->get(i, j) * x[j];
+        ASSERT_NEAR(2.0 * y_ref, y[i], 1e-12);
+    }
+
+    // The Jacobi preconditioner is the inverse of the matrix diagonal.
+    std::vector<double> ones(n, 1.0);
+    op->precondApply(ones.data());
+    for (std::size_t i = 0; i < n; ++i)
+        ASSERT_NEAR(1.0 / A->get(i, i), ones[i], 1e-12);
+}
+
+TEST_F(AssemblerLibMatrixFreeOperator, KnownSolutionsAreIdentityRows)
+{
+    auto const A = assembleMatrix();
+    std::vector<GlobalIndexType> const known_ids{0, 7, 42};
+    auto const op = createOperator(known_ids);
+    std::size_t const n = op->getNRows();
+
+    std::vector<double> x(n);
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = std::cos(0.7 * i);
+
+    std::vector<double> y(n);
+    op->amux(1.0, x.data(), y.data());
+
+    auto const is_known = [&known_ids](std::size_t const i)
+    {
+        return std::find(known_ids.cbegin(), known_ids.cend(), i) !=
+               known_ids.cend();
+    };
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (is_known(i))
+        {
+            ASSERT_EQ(x[i], y[i]);
+            continue;
+        }
+        double y_ref = 0.0;
+        for (std::size_t j = 0; j < n; ++j)
+            if (!is_known(j))
+                y_ref += A->get(i, j) * x[j];
+        ASSERT_NEAR(y_ref, y[i], 1e-12);
+    }
+}
+
+TEST_F(AssemblerLibMatrixFreeOperator, SolveCG)
+{
+    checkSolution(MathLib::CG<AssemblerLib::MatrixFreeOperator>);
+}
+
+TEST_F(AssemblerLibMatrixFreeOperator, SolvePipelinedCG)
+{
+    checkSolution(MathLib::PipelinedCG<AssemblerLib::MatrixFreeOperator>);
+}
+
+TEST_F(AssemblerLibMatrixFreeOperator, SolveBiCGStab)
+{
+    checkSolution(MathLib::BiCGStab<AssemblerLib::MatrixFreeOperator>);
+}
+
+#endif  // OGS_USE_EIGEN
@@ -11,6 +11,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <vector>
 
 #include "AssemblerLib/MeshComponentMap.h"
@@ -200,3 +201,54 @@ TEST_F(AssemblerLibMeshComponentMapTest, SubsetOfNodesByLocation)
     for (auto p : selected_components)
         delete p;
 }
+
+TEST_F(AssemblerLibMeshComponentMapTest, SubsetOfNodesMissingEntries)
+{
+    cmap = new MeshComponentMap(components,
+        AssemblerLib::ComponentOrder::BY_COMPONENT);
+
+    // Select some scattered nodes from the full mesh.
+    std::array<std::size_t, 3> const ids = {{ 1, 4, 8 }};
+    std::vector<MeshLib::Node*> some_nodes;
+    for (std::size_t id : ids)
+        some_nodes.push_back(const_cast<MeshLib::Node*>(mesh->getNode(id)));
+
+    MeshLib::MeshSubset some_nodes_mesh_subset(*mesh, &some_nodes);
+
+    std::vector<MeshLib::MeshSubsets*> selected_components;
+    selected_components.emplace_back(nullptr);  // empty component
+    selected_components.emplace_back(new MeshLib::MeshSubsets(&some_nodes_mesh_subset));
+
+    MeshComponentMap cmap_subset = cmap->getSubset(selected_components);
+
+    for (std::size_t id = 0; id < mesh->getNNodes(); ++id)
+    {
+        Location const l(mesh->getID(), MeshItemType::Node, id);
+        EXPECT_EQ(MeshComponentMap::nop,
+            cmap_subset.getGlobalIndex(l, comp0_id));
+
+        bool const selected =
+            std::find(ids.begin(), ids.end(), id) != ids.end();
+        if (selected)
+        {
+            EXPECT_EQ(cmap->getGlobalIndex(l, comp1_id),
+                cmap_subset.getGlobalIndex(l, comp1_id));
+            ASSERT_EQ(1u, cmap_subset.getComponentIDs(l).size());
+            EXPECT_EQ(1u, cmap_subset.getComponentIDs(l)[0]);  // comp1_id
+        }
+        else
+        {
+            EXPECT_EQ(MeshComponentMap::nop,
+                cmap_subset.getGlobalIndex(l, comp1_id));
+            EXPECT_TRUE(cmap_subset.getComponentIDs(l).empty());
+        }
+    }
+
+    // Locations of other item types are not found.
+    Location const cell(mesh->getID(), MeshItemType::Cell, 0);
+    EXPECT_EQ(MeshComponentMap::nop, cmap_subset.getGlobalIndex(cell, comp1_id));
+    EXPECT_TRUE(cmap_subset.getGlobalIndices(cell).empty());
+
+    for (auto p : selected_components)
+        delete p;
+}
@@ -0,0 +1,165 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "AssemblerLib/LocalAssemblerBuilder.h"
+#include "AssemblerLib/LocalToGlobalIndexMap.h"
+#include "AssemblerLib/ParallelExecutor.h"
+#include "AssemblerLib/SerialExecutor.h"
+#include "AssemblerLib/TripletMatrixAssembler.h"
+#include "AssemblerLib/VectorMatrixAssembler.h"
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+
+#include "MeshLib/MeshSubsets.h"
+
+#include "SteadyDiffusion2DExample1.h"
+
+#ifdef OGS_USE_EIGEN
+namespace
+{
+using Example = SteadyDiffusion2DExample1<GlobalIndexType>;
+using GlobalMatrix = MathLib::EigenMatrix;
+using GlobalVector = MathLib::EigenVector;
+using LocalAssembler = Example::LocalAssemblerData<GlobalMatrix, GlobalVector>;
+
+class AssemblerLibTripletMatrixAssembler : public ::testing::Test
+{
+public:
+    AssemblerLibTripletMatrixAssembler()
+        : mesh_items_all_nodes(*ex1.msh, &ex1.msh->getNodes())
+    {
+        vec_comp_dis.push_back(
+            new MeshLib::MeshSubsets(&mesh_items_all_nodes));
+        dof_table.reset(new AssemblerLib::LocalToGlobalIndexMap(
+            vec_comp_dis, AssemblerLib::ComponentOrder::BY_COMPONENT));
+
+        local_assemblers.resize(ex1.msh->getNElements());
+        AssemblerLib::LocalAssemblerBuilder<
+            MeshLib::Element,
+            void(const MeshLib::Element&, LocalAssembler*&, std::size_t const,
+                 Example const&)>
+            local_asm_builder(
+                Example::initializeLocalData<GlobalMatrix, GlobalVector>,
+                *dof_table);
+        AssemblerLib::SerialExecutor::execute(
+            local_asm_builder, ex1.msh->getElements(), local_assemblers, ex1);
+
+        // All elements in one color class.
+        all_elements.assign(1, std::vector<std::size_t>(
+                                   local_assemblers.size()));
+        std::iota(all_elements[0].begin(), all_elements[0].end(), 0);
+    }
+
+    ~AssemblerLibTripletMatrixAssembler()
+    {
+        for (auto p : local_assemblers)
+            delete p;
+        for (auto p : vec_comp_dis)
+            delete p;
+    }
+
+    /// Assembles by the triplet assembler; twice to check that the previous
+    /// triplets are removed.
+    void assembleTriplets(GlobalMatrix& A, GlobalVector& rhs) const
+    {
+        AssemblerLib::TripletMatrixAssembler<GlobalMatrix, GlobalVector>
+            assembler(A, rhs, *dof_table);
+        for (int i = 0; i < 2; ++i)
+        {
+            rhs = 0;
+            assembler.clear();
+            AssemblerLib::ParallelExecutor::executeColored(
+                all_elements, assembler, local_assemblers);
+            assembler.setGlobal();
+        }
+    }
+
+    Example ex1;
+    MeshLib::MeshSubset const mesh_items_all_nodes;
+    std::vector<MeshLib::MeshSubsets*> vec_comp_dis;
+    std::unique_ptr<AssemblerLib::LocalToGlobalIndexMap> dof_table;
+    std::vector<LocalAssembler*> local_assemblers;
+    AssemblerLib::ElementColoring all_elements;
+};
+}  // namespace
+
+TEST_F(AssemblerLibTripletMatrixAssembler, AssembleLikeSearchingAdd)
+{
+    GlobalMatrix A_ref(dof_table->dofSize());
+    GlobalVector rhs_ref(dof_table->dofSize());
+    AssemblerLib::VectorMatrixAssembler<GlobalMatrix, GlobalVector>
+        assembler_ref(A_ref, rhs_ref, *dof_table);
+    AssemblerLib::SerialExecutor::execute(assembler_ref, local_assemblers);
+
+    GlobalMatrix A(dof_table->dofSize());
+    GlobalVector rhs(dof_table->dofSize());
+    assembleTriplets(A, rhs);
+
+    // The sums are taken in the element order like the serial reference.
+    ASSERT_TRUE(A.getRawMatrix().isCompressed());
+    ASSERT_EQ(A_ref.getRawMatrix().nonZeros(), A.getRawMatrix().nonZeros());
+    for (std::size_t i = 0; i < A.getNRows(); ++i)
+    {
+        ASSERT_EQ(rhs_ref[i], rhs[i]);
+        for (std::size_t j = 0; j < A.getNCols(); ++j)
+            ASSERT_EQ(A_ref.get(i, j), A.get(i, j));
+    }
+
+    // Upper triangle only.
+    GlobalMatrix A_sym(dof_table->dofSize());
+    A_sym.setSymmetric();
+    assembleTriplets(A_sym, rhs);
+    auto const n = static_cast<GlobalIndexType>(A.getNRows());
+    ASSERT_EQ((A.getRawMatrix().nonZeros() + n) / 2,
+              A_sym.getRawMatrix().nonZeros());
+    for (std::size_t i = 0; i < A.getNRows(); ++i)
+        for (std::size_t j = 0; j < A.getNCols(); ++j)
+            ASSERT_EQ(A.get(i, j), A_sym.get(i, j));
+}
+
+#ifdef _OPENMP
+TEST_F(AssemblerLibTripletMatrixAssembler, IndependentOfNumberOfThreads)
+{
+    int const max_threads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    GlobalMatrix A_serial(dof_table->dofSize());
+    GlobalVector rhs_serial(dof_table->dofSize());
+    assembleTriplets(A_serial, rhs_serial);
+
+    omp_set_num_threads(std::max(4, max_threads));
+    GlobalMatrix A(dof_table->dofSize());
+    GlobalVector rhs(dof_table->dofSize());
+    assembleTriplets(A, rhs);
+    omp_set_num_threads(max_threads);
+
+    auto const& raw_serial = A_serial.getRawMatrix();
+    auto const& raw = A.getRawMatrix();
+    ASSERT_EQ(raw_serial.nonZeros(), raw.nonZeros());
+    for (GlobalIndexType k = 0; k < raw.nonZeros(); ++k)
+    {
+        ASSERT_EQ(raw_serial.innerIndexPtr()[k], raw.innerIndexPtr()[k]);
+        ASSERT_EQ(raw_serial.valuePtr()[k], raw.valuePtr()[k]);
+    }
+    for (std::size_t i = 0; i < rhs.size(); ++i)
+        ASSERT_EQ(rhs_serial[i], rhs[i]);
+}
+#endif  // _OPENMP
+#endif  // OGS_USE_EIGEN
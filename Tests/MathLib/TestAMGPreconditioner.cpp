@@ -0,0 +1,258 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "BaseLib/ConfigTree.h"
+#include "MathLib/LinAlg/Preconditioner/AMGPreconditioner.h"
+#include "MathLib/LinAlg/Solvers/LinearOperatorSolvers.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixAMGPrecond.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixDiagPrecond.h"
+
+#ifdef OGS_USE_EIGEN
+#include "MathLib/LinAlg/Eigen/EigenLinearSolver.h"
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#endif
+
+namespace
+{
+/// Calls \c add(i, j, value) for the entries of the seven-point Laplacian on
+/// an n x n x n grid; the boundary unknowns are coupled to fixed zero values.
+template <typename Add>
+void laplacian3d(unsigned const n, Add add)
+{
+    auto const id = [n](unsigned i, unsigned j, unsigned k)
+    {
+        return (k * n + j) * n + i;
+    };
+    for (unsigned k = 0; k < n; ++k)
+        for (unsigned j = 0; j < n; ++j)
+            for (unsigned i = 0; i < n; ++i)
+            {
+                unsigned const row = id(i, j, k);
+                if (k > 0) add(row, id(i, j, k - 1), -1.0);
+                if (j > 0) add(row, id(i, j - 1, k), -1.0);
+                if (i > 0) add(row, id(i - 1, j, k), -1.0);
+                add(row, row, 6.0);
+                if (i + 1 < n) add(row, id(i + 1, j, k), -1.0);
+                if (j + 1 < n) add(row, id(i, j + 1, k), -1.0);
+                if (k + 1 < n) add(row, id(i, j, k + 1), -1.0);
+            }
+}
+
+/// Creates the Laplacian in compressed row storage.
+template <typename CRSMatrixType>
+std::unique_ptr<CRSMatrixType> createLaplacian3d(unsigned const n)
+{
+    std::vector<unsigned> row_ptr(1, 0);
+    std::vector<unsigned> col_idx;
+    std::vector<double> data;
+    laplacian3d(n, [&](unsigned const row, unsigned const col, double v)
+                {
+                    if (row_ptr.size() == row + 1)
+                        row_ptr.push_back(row_ptr.back());
+                    col_idx.push_back(col);
+                    data.push_back(v);
+                    row_ptr.back()++;
+                });
+
+    // The matrix takes the ownership of the arrays.
+    unsigned* const iA = new unsigned[row_ptr.size()];
+    unsigned* const jA = new unsigned[col_idx.size()];
+    double* const A = new double[data.size()];
+    std::copy(row_ptr.begin(), row_ptr.end(), iA);
+    std::copy(col_idx.begin(), col_idx.end(), jA);
+    std::copy(data.begin(), data.end(), A);
+    return std::unique_ptr<CRSMatrixType>(
+        new CRSMatrixType(row_ptr.size() - 1, iA, jA, A));
+}
+
+/// Solves the Laplacian system for a constant right-hand-side and returns
+/// the number of CG iterations.
+template <typename CRSMatrixType>
+unsigned solveLaplacian3d(unsigned const n)
+{
+    auto const A = createLaplacian3d<CRSMatrixType>(n);
+    A->calcPrecond();
+
+    std::vector<double> const b(A->getNRows(), 1.0);
+    std::vector<double> x(A->getNRows(), 0.0);
+    double eps = 1e-8;
+    unsigned n_steps = 1000;
+    EXPECT_EQ(0u, MathLib::CG(*A, b.data(), x.data(), eps, n_steps));
+    EXPECT_GE(1e-8, eps);
+    return n_steps;
+}
+
+/// Applies the preconditioner as the iteration x += M^{-1} (b - A x) to the
+/// Laplacian in compressed row storage and returns the reduction of the
+/// residual norm. If \c neumann is set, the diagonal entries are the sums of
+/// the neighbours' couplings, i.e. the matrix is singular, and the
+/// right-hand-side is orthogonal to its null space.
+double iterateLaplacian3d(unsigned const n, MathLib::AMGOptions const& options,
+                          bool const neumann, std::size_t& n_levels)
+{
+    std::vector<std::size_t> row_ptr(1, 0);
+    std::vector<std::size_t> col_idx;
+    std::vector<double> data;
+    laplacian3d(n, [&](unsigned const row, unsigned const col, double v)
+                {
+                    if (row_ptr.size() == row + 1)
+                        row_ptr.push_back(row_ptr.back());
+                    col_idx.push_back(col);
+                    data.push_back(v);
+                    row_ptr.back()++;
+                });
+    std::size_t const n_rows = row_ptr.size() - 1;
+    if (neumann)
+    {
+        for (std::size_t i = 0; i < n_rows; ++i)
+        {
+            double off_diagonal_sum = 0.0;
+            for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                if (col_idx[k] != i)
+                    off_diagonal_sum += data[k];
+            for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                if (col_idx[k] == i)
+                    data[k] = -off_diagonal_sum;
+        }
+    }
+
+    MathLib::AMGPreconditioner amg(options);
+    amg.compute(n_rows, row_ptr.data(), col_idx.data(), data.data());
+    n_levels = amg.getNLevels();
+
+    std::vector<double> b(n_rows, 1.0);
+    if (neumann)
+        for (std::size_t i = 0; i < n_rows; i += 2)
+            b[i] = -1.0;
+    std::vector<double> x(n_rows, 0.0);
+    std::vector<double> r(n_rows);
+    std::vector<double> z(n_rows);
+    auto const residual = [&]()
+    {
+        double norm = 0.0;
+        for (std::size_t i = 0; i < n_rows; ++i)
+        {
+            r[i] = b[i];
+            for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                r[i] -= data[k] * x[col_idx[k]];
+            norm += r[i] * r[i];
+        }
+        return std::sqrt(norm);
+    };
+
+    double const initial_residual = residual();
+    for (unsigned iteration = 0; iteration < 5; ++iteration)
+    {
+        residual();
+        amg.apply(r.data(), z.data());
+        for (std::size_t i = 0; i < n_rows; ++i)
+            x[i] += z[i];
+    }
+    return residual() / initial_residual;
+}
+}  // namespace
+
+TEST(MathLibAMGPreconditioner, Hierarchy)
+{
+    auto const A = createLaplacian3d<MathLib::CRSMatrixAMGPrecond>(16);
+    A->calcPrecond();
+
+    auto const& amg = A->getPreconditioner();
+    ASSERT_LT(1u, amg.getNLevels());
+    ASSERT_EQ(A->getNRows(), amg.getNRows(0));
+    for (std::size_t l = 1; l < amg.getNLevels(); ++l)
+        ASSERT_GT(amg.getNRows(l - 1), amg.getNRows(l));
+    ASSERT_GE(MathLib::AMGOptions().max_coarse_size,
+              amg.getNRows(amg.getNLevels() - 1));
+}
+
+// With a single level the fine matrix exceeds the size for the direct
+// solution; the level is smoothed instead of factorized.
+TEST(MathLibAMGPreconditioner, SmoothedCoarsestLevel)
+{
+    MathLib::AMGOptions options;
+    options.max_levels = 1;
+    std::size_t n_levels = 0;
+    double const reduction = iterateLaplacian3d(8, options, false, n_levels);
+    ASSERT_EQ(1u, n_levels);
+    ASSERT_GT(0.5, reduction);
+}
+
+// The singular coarsest matrix of the Neumann problem is smoothed instead of
+// factorized.
+TEST(MathLibAMGPreconditioner, SingularCoarsestMatrix)
+{
+    MathLib::AMGOptions options;
+    options.max_coarse_size = 1000;
+    std::size_t n_levels = 0;
+    double const reduction = iterateLaplacian3d(4, options, true, n_levels);
+    ASSERT_EQ(1u, n_levels);
+    ASSERT_TRUE(std::isfinite(reduction));
+    ASSERT_GT(0.5, reduction);
+}
+
+TEST(MathLibAMGPreconditioner, MeshIndependentIterations)
+{
+    unsigned const n_coarse = solveLaplacian3d<MathLib::CRSMatrixAMGPrecond>(8);
+    unsigned const n_fine = solveLaplacian3d<MathLib::CRSMatrixAMGPrecond>(24);
+    unsigned const n_diag = solveLaplacian3d<MathLib::CRSMatrixDiagPrecond>(24);
+
+    // The Jacobi preconditioned iterations grow with the grid size, the AMG
+    // preconditioned ones hardly.
+    EXPECT_GE(n_coarse + 5, n_fine);
+    EXPECT_GT(n_diag, 2 * n_fine);
+}
+
+#ifdef OGS_USE_EIGEN
+TEST(MathLibAMGPreconditioner, EigenCG)
+{
+    boost::property_tree::ptree t_root;
+    boost::property_tree::ptree t_solver;
+    t_solver.put("solver_type", "CG");
+    t_solver.put("precon_type", "AMG");
+    t_solver.put("error_tolerance", 1e-10);
+    t_solver.put("max_iteration_step", 100);
+    t_root.put_child("eigen", t_solver);
+
+    unsigned const n = 12;
+    for (bool const symmetric : {false, true})
+    {
+        MathLib::EigenMatrix A(n * n * n);
+        if (symmetric)
+            A.setSymmetric();
+        laplacian3d(n, [&A](unsigned const row, unsigned const col, double v)
+                    {
+                        A.setValue(row, col, v);
+                    });
+
+        BaseLib::ConfigTree conf(t_root, "");
+        MathLib::EigenLinearSolver solver(A, "", &conf);
+
+        MathLib::EigenVector b(A.getNRows());
+        MathLib::EigenVector x(A.getNRows());
+        b.getRawVector().setOnes();
+        x.getRawVector().setZero();
+        solver.solve(b, x);
+
+        MathLib::EigenVector Ax(A.getNRows());
+        A.multiply(x, Ax);
+        ASSERT_GT(1e-8 * b.getRawVector().norm(),
+                  (b.getRawVector() - Ax.getRawVector()).norm());
+    }
+}
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,66 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#ifdef OGS_USE_EIGEN
+
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+
+class MathLibEigenMatrixFrozenStructure : public ::testing::Test
+{
+public:
+    MathLibEigenMatrixFrozenStructure() : A(n)
+    {
+        // Tridiagonal structure.
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (i > 0)
+                A.add(i, i - 1, -1.0);
+            A.add(i, i, 2.0);
+            if (i < n - 1)
+                A.add(i, i + 1, -1.0);
+        }
+        A.freezeStructure();
+    }
+
+protected:
+    static std::size_t const n = 5;
+    MathLib::EigenMatrix A;
+};
+
+TEST_F(MathLibEigenMatrixFrozenStructure, SetZeroKeepsStructure)
+{
+    auto const nnz = A.getRawMatrix().nonZeros();
+    A.setZero();
+    A.add(1, 2, 3.0);
+    A.setValue(2, 2, 4.0);
+
+    ASSERT_TRUE(A.isStructureFrozen());
+    ASSERT_TRUE(A.getRawMatrix().isCompressed());
+    ASSERT_EQ(nnz, A.getRawMatrix().nonZeros());
+    ASSERT_EQ(3.0, A.get(1, 2));
+    ASSERT_EQ(4.0, A.get(2, 2));
+    ASSERT_EQ(0.0, A.get(0, 0));
+}
+
+TEST_F(MathLibEigenMatrixFrozenStructure, AddingZeroOutsideIsAllowed)
+{
+    auto const nnz = A.getRawMatrix().nonZeros();
+    A.add(0, 4, 0.0);
+    ASSERT_EQ(nnz, A.getRawMatrix().nonZeros());
+}
+
+TEST_F(MathLibEigenMatrixFrozenStructure, InsertionOutsideAborts)
+{
+    EXPECT_DEATH(A.add(0, 4, 1.0), "");
+    EXPECT_DEATH(A.setValue(4, 0, 1.0), "");
+}
+
+#endif  // OGS_USE_EIGEN
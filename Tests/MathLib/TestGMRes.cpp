@@ -0,0 +1,143 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MathLib/LinAlg/Solvers/LinearOperatorSolvers.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixDiagPrecond.h"
+
+namespace
+{
+/// Five-point upwind finite difference matrix of a convection diffusion
+/// problem on an n x n grid; the matrix is not symmetric.
+std::unique_ptr<MathLib::CRSMatrixDiagPrecond> createMatrix(
+    unsigned const n, double const peclet)
+{
+    std::vector<unsigned> row_ptr(1, 0);
+    std::vector<unsigned> col_idx;
+    std::vector<double> data;
+    for (unsigned j = 0; j < n; ++j)
+        for (unsigned i = 0; i < n; ++i)
+        {
+            unsigned const row = j * n + i;
+            auto const add = [&](unsigned const col, double const value)
+            {
+                col_idx.push_back(col);
+                data.push_back(value);
+            };
+            // The flow goes in positive x and y direction.
+            if (j > 0) add(row - n, -1.0 - peclet);
+            if (i > 0) add(row - 1, -1.0 - peclet);
+            add(row, 4.0 + 2.0 * peclet);
+            if (i + 1 < n) add(row + 1, -1.0);
+            if (j + 1 < n) add(row + n, -1.0);
+            row_ptr.push_back(col_idx.size());
+        }
+
+    // The matrix takes the ownership of the arrays.
+    unsigned* const iA = new unsigned[row_ptr.size()];
+    unsigned* const jA = new unsigned[col_idx.size()];
+    double* const A = new double[data.size()];
+    std::copy(row_ptr.begin(), row_ptr.end(), iA);
+    std::copy(col_idx.begin(), col_idx.end(), jA);
+    std::copy(data.begin(), data.end(), A);
+    std::unique_ptr<MathLib::CRSMatrixDiagPrecond> mat(
+        new MathLib::CRSMatrixDiagPrecond(n * n, iA, jA, A));
+    mat->calcPrecond();
+    return mat;
+}
+
+double relativeResidual(MathLib::CRSMatrixDiagPrecond const& A,
+                        std::vector<double> const& b,
+                        std::vector<double> const& x)
+{
+    std::vector<double> r(b.size());
+    A.amux(1.0, x.data(), r.data());
+    double rr = 0.0, bb = 0.0;
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        rr += (b[i] - r[i]) * (b[i] - r[i]);
+        bb += b[i] * b[i];
+    }
+    return std::sqrt(rr / bb);
+}
+
+std::vector<double> createRightHandSide(std::size_t const n)
+{
+    std::vector<double> b(n);
+    for (std::size_t i = 0; i < n; ++i)
+        b[i] = std::cos(0.3 * i);
+    return b;
+}
+}  // namespace
+
+TEST(MathLibGMRes, NonsymmetricSystem)
+{
+    auto const A = createMatrix(30, 2.0);
+    auto const b = createRightHandSide(A->getNRows());
+
+    for (bool const tune_restart : {false, true})
+    {
+        std::vector<double> x(b.size(), 0.0);
+        double eps = 1e-10;
+        unsigned n_steps = 2000;
+        ASSERT_EQ(0u, MathLib::GMRes(*A, b.data(), x.data(), eps, 20,
+                                     n_steps, tune_restart));
+        ASSERT_GE(1e-10, eps);
+        ASSERT_LT(0u, n_steps);
+        ASSERT_GT(1e-9, relativeResidual(*A, b, x));
+    }
+}
+
+TEST(MathLibGMRes, FullGMResTerminates)
+{
+    // Without restarts the exact solution lies in the Krylov space of
+    // dimension n.
+    auto const A = createMatrix(6, 10.0);
+    std::size_t const n = A->getNRows();
+    auto const b = createRightHandSide(n);
+
+    std::vector<double> x(n, 1.0);
+    double eps = 1e-12;
+    unsigned n_steps = n;
+    ASSERT_EQ(0u, MathLib::GMRes(*A, b.data(), x.data(), eps, n, n_steps));
+    ASSERT_GE(n, n_steps);
+    ASSERT_GT(1e-11, relativeResidual(*A, b, x));
+}
+
+TEST(MathLibGMRes, ZeroRightHandSide)
+{
+    auto const A = createMatrix(5, 1.0);
+    std::vector<double> const b(A->getNRows(), 0.0);
+    std::vector<double> x(A->getNRows(), 1.0);
+    double eps = 1e-10;
+    unsigned n_steps = 100;
+    ASSERT_EQ(0u, MathLib::GMRes(*A, b.data(), x.data(), eps, 10, n_steps));
+    ASSERT_EQ(0u, n_steps);
+    for (double const v : x)
+        ASSERT_EQ(0.0, v);
+}
+
+TEST(MathLibBiCGStab, NonsymmetricSystem)
+{
+    auto const A = createMatrix(30, 2.0);
+    auto const b = createRightHandSide(A->getNRows());
+
+    std::vector<double> x(b.size(), 0.0);
+    double eps = 1e-10;
+    unsigned n_steps = 1000;
+    ASSERT_EQ(0u, MathLib::BiCGStab(*A, b.data(), x.data(), eps, n_steps));
+    ASSERT_GE(1e-10, eps);
+    ASSERT_GT(1e-8, relativeResidual(*A, b, x));
+}
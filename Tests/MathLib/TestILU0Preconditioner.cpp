@@ -0,0 +1,202 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include "BaseLib/ConfigTree.h"
+#include "MathLib/LinAlg/Preconditioner/ILU0Preconditioner.h"
+
+#ifdef OGS_USE_EIGEN
+#include "MathLib/LinAlg/Eigen/EigenLinearSolver.h"
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenOption.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+#endif
+
+namespace
+{
+/// Five-point Laplacian on an n x n grid in compressed row storage, with the
+/// diagonal scaled by the given factor.
+struct Laplacian2d
+{
+    Laplacian2d(unsigned const n, double const diagonal_factor)
+    {
+        row_ptr.push_back(0);
+        for (unsigned j = 0; j < n; ++j)
+            for (unsigned i = 0; i < n; ++i)
+            {
+                unsigned const row = j * n + i;
+                if (j > 0) add(row - n, -1.0);
+                if (i > 0) add(row - 1, -1.0);
+                add(row, 4.0 * diagonal_factor);
+                if (i + 1 < n) add(row + 1, -1.0);
+                if (j + 1 < n) add(row + n, -1.0);
+                row_ptr.push_back(col_idx.size());
+            }
+    }
+
+    void add(unsigned const col, double const v)
+    {
+        col_idx.push_back(col);
+        data.push_back(v);
+    }
+
+    std::size_t size() const { return row_ptr.size() - 1; }
+
+    std::vector<unsigned> row_ptr;
+    std::vector<unsigned> col_idx;
+    std::vector<double> data;
+};
+}  // namespace
+
+TEST(MathLibILU0Preconditioner, ExactForTridiagonal)
+{
+    // The LU factors of a tridiagonal matrix have no fill-in.
+    std::size_t const n = 20;
+    std::vector<unsigned> row_ptr(1, 0);
+    std::vector<unsigned> col_idx;
+    std::vector<double> data;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+        {
+            col_idx.push_back(i - 1);
+            data.push_back(-1.0);
+        }
+        col_idx.push_back(i);
+        data.push_back(2.0 + 0.1 * i);
+        if (i + 1 < n)
+        {
+            col_idx.push_back(i + 1);
+            data.push_back(-0.5);
+        }
+        row_ptr.push_back(col_idx.size());
+    }
+
+    MathLib::ILU0Preconditioner ilu;
+    ilu.compute(n, row_ptr.data(), col_idx.data(), data.data());
+    ASSERT_EQ(n, ilu.getNLowerLevels());
+    ASSERT_EQ(n, ilu.getNUpperLevels());
+
+    std::vector<double> b(n);
+    for (std::size_t i = 0; i < n; ++i)
+        b[i] = static_cast<double>(i) - 3.0;
+    std::vector<double> x(n);
+    ilu.apply(b.data(), x.data());
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        double Ax = 0.0;
+        for (unsigned k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+            Ax += data[k] * x[col_idx[k]];
+        ASSERT_NEAR(b[i], Ax, 1e-12);
+    }
+}
+
+TEST(MathLibILU0Preconditioner, RefactorizeWithAnalyzedPattern)
+{
+    unsigned const n = 16;
+    Laplacian2d const A(n, 1.0);
+    Laplacian2d const B(n, 1.5);
+
+    MathLib::ILU0Preconditioner ilu;
+    ilu.compute(A.size(), A.row_ptr.data(), A.col_idx.data(), A.data.data());
+    // The rows of a level lie on an anti-diagonal of the grid.
+    ASSERT_EQ(2 * n - 1, ilu.getNLowerLevels());
+    ASSERT_EQ(2 * n - 1, ilu.getNUpperLevels());
+
+    // New values of the same pattern.
+    ilu.factorize(B.size(), B.row_ptr.data(), B.col_idx.data(),
+                  B.data.data());
+    MathLib::ILU0Preconditioner ilu_ref;
+    ilu_ref.compute(B.size(), B.row_ptr.data(), B.col_idx.data(),
+                    B.data.data());
+
+    std::vector<double> x(B.size());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        x[i] = static_cast<double>(i % 7);
+    std::vector<double> x_ref(x);
+    ilu.precondApply(x.data());
+    ilu_ref.precondApply(x_ref.data());
+    for (std::size_t i = 0; i < x.size(); ++i)
+        ASSERT_EQ(x_ref[i], x[i]);
+}
+
+#ifdef OGS_USE_EIGEN
+TEST(MathLibILU0Preconditioner, EigenPreconTypes)
+{
+    unsigned const n = 12;
+    Laplacian2d const L(n, 1.0);
+
+    auto const solve = [&](std::string const& solver_type,
+                           std::string const& precon_type,
+                           bool const symmetric)
+    {
+        SCOPED_TRACE(solver_type + " " + precon_type +
+                     (symmetric ? " symmetric" : ""));
+        boost::property_tree::ptree t_root;
+        boost::property_tree::ptree t_solver;
+        t_solver.put("solver_type", solver_type);
+        t_solver.put("precon_type", precon_type);
+        t_solver.put("error_tolerance", 1e-12);
+        t_solver.put("max_iteration_step", 1000);
+        t_root.put_child("eigen", t_solver);
+        BaseLib::ConfigTree conf(t_root, "");
+
+        MathLib::EigenMatrix A(L.size());
+        if (symmetric)
+            A.setSymmetric();
+        for (std::size_t i = 0; i < L.size(); ++i)
+            for (unsigned k = L.row_ptr[i]; k < L.row_ptr[i + 1]; ++k)
+                A.setValue(i, L.col_idx[k], L.data[k]);
+        A.freezeStructure();
+
+        MathLib::EigenLinearSolver solver(A, "", &conf);
+        MathLib::EigenVector b(A.getNRows());
+        MathLib::EigenVector x(A.getNRows());
+        MathLib::EigenVector Ax(A.getNRows());
+        b.getRawVector().setOnes();
+
+        // The second solution refactorizes the changed matrix of the same
+        // structure.
+        for (double const factor : {1.0, 2.0})
+        {
+            A.getRawMatrix() *= factor;
+            x.getRawVector().setZero();
+            solver.solve(b, x);
+            A.multiply(x, Ax);
+            ASSERT_GT(1e-10 * b.getRawVector().norm(),
+                      (b.getRawVector() - Ax.getRawVector()).norm());
+        }
+    };
+
+    for (auto const precon_type : {"NONE", "DIAGONAL", "ILUT", "IC", "ILU0"})
+    {
+        solve("CG", precon_type, false);
+        solve("BiCGSTAB", precon_type, false);
+    }
+    for (auto const precon_type : {"NONE", "DIAGONAL", "IC", "ILU0"})
+        solve("CG", precon_type, true);
+}
+
+TEST(MathLibILU0Preconditioner, EigenPreconTypeNames)
+{
+    // Without a precon_type tag the Jacobi preconditioner is used.
+    ASSERT_TRUE(MathLib::EigenOption::PreconType::DIAGONAL ==
+                MathLib::EigenOption().precon_type);
+    ASSERT_TRUE(MathLib::EigenOption::PreconType::ILU0 ==
+                MathLib::EigenOption::getPreconType("ILU0"));
+    EXPECT_DEATH(MathLib::EigenOption::getPreconType("DIAGONAl"), "");
+}
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,214 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifdef OGS_USE_EIGEN
+
+#include "MathLib/LinAlg/ApplyKnownSolution.h"
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+#include "MathLib/LinAlg/Eigen/EigenVector.h"
+
+namespace
+{
+using IndexType = MathLib::EigenMatrix::IndexType;
+
+MathLib::EigenMatrix createMatrix(std::size_t const n)
+{
+    // Non-symmetric band matrix with a zero diagonal entry.
+    MathLib::EigenMatrix A(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+            A.add(i, i - 1, -1.0 - i);
+        if (i != 3)
+            A.add(i, i, 4.0 + i);
+        if (i < n - 1)
+            A.add(i, i + 1, -2.0);
+        if (i < n - 2)
+            A.add(i, i + 2, 0.5);
+    }
+    return A;
+}
+
+MathLib::EigenVector createRhs(std::size_t const n)
+{
+    MathLib::EigenVector b(n);
+    for (std::size_t i = 0; i < n; ++i)
+        b[i] = 1.0 + 0.1 * i;
+    return b;
+}
+}  // namespace
+
+TEST(MathLibKnownSolutionElimination, RhsUpdateLikeFullApplication)
+{
+    std::size_t const n = 8;
+    std::vector<std::vector<IndexType>> const ids{{0, 3}, {7, 4}};
+    std::vector<std::vector<double>> const values{{1.0, -2.0}, {0.5, 3.0}};
+    std::vector<std::vector<double>> const new_values{{-1.5, 4.0},
+                                                      {2.0, 0.25}};
+
+    // Record the elimination.
+    MathLib::EigenMatrix A = createMatrix(n);
+    MathLib::EigenVector b = createRhs(n);
+    MathLib::EigenVector x(n);
+    std::vector<MathLib::KnownSolutionElimination<IndexType>> eliminations(
+        ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+        MathLib::applyKnownSolution(A, b, x, ids[i], values[i],
+                                    eliminations[i]);
+        ASSERT_FALSE(eliminations[i].empty());
+    }
+
+    // Reference with the new values applied to the full system.
+    MathLib::EigenMatrix A_ref = createMatrix(n);
+    MathLib::EigenVector b_ref = createRhs(n);
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        MathLib::applyKnownSolution(A_ref, b_ref, x, ids[i], new_values[i]);
+
+    // Replay the elimination on the right-hand-side only.
+    b = createRhs(n);
+    for (std::size_t i = 0; i < ids.size(); ++i)
+        MathLib::applyKnownSolution(eliminations[i], b, ids[i],
+                                    new_values[i]);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ASSERT_DOUBLE_EQ(b_ref[i], b[i]);
+        for (std::size_t j = 0; j < n; ++j)
+            ASSERT_EQ(A_ref.get(i, j), A.get(i, j));
+    }
+}
+
+TEST(MathLibKnownSolutionElimination, InPlaceOnFrozenStructure)
+{
+    std::size_t const n = 8;
+    std::vector<IndexType> const ids{0, 3, 7, 4};
+    std::vector<double> const values{1.0, -2.0, 0.5, 3.0};
+
+    // Dense reference of the elimination.
+    MathLib::EigenMatrix const A_orig = createMatrix(n);
+    std::vector<std::vector<double>> A_ref(n, std::vector<double>(n));
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            A_ref[i][j] = A_orig.get(i, j);
+    MathLib::EigenVector b_ref = createRhs(n);
+    std::vector<bool> is_known(n, false);
+    for (auto const k : ids)
+        is_known[k] = true;
+    for (auto const k : ids)
+        for (std::size_t j = 0; j < n; ++j)
+            if (j != static_cast<std::size_t>(k))
+                A_ref[k][j] = 0.0;
+    for (std::size_t ix = 0; ix < ids.size(); ++ix)
+    {
+        auto const k = ids[ix];
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (is_known[i])
+                continue;
+            b_ref[i] -= A_ref[i][k] * values[ix];
+            A_ref[i][k] = 0.0;
+        }
+        if (A_ref[k][k] == 0.0)
+            A_ref[k][k] = 1.0;
+        b_ref[k] = A_ref[k][k] * values[ix];
+    }
+
+    // The missing diagonal entry is inserted before the structure is frozen.
+    MathLib::EigenMatrix A = createMatrix(n);
+    auto elimination = MathLib::createKnownSolutionElimination(A, ids);
+    ASSERT_FALSE(elimination.empty());
+    A.freezeStructure();
+    MathLib::EigenMatrix const A_frozen = A;
+    auto const nnz = A.getRawMatrix().nonZeros();
+    MathLib::EigenVector b = createRhs(n);
+    MathLib::EigenVector x(n);
+
+    // Applied twice to check that the precomputed positions are kept.
+    for (int r = 0; r < 2; ++r)
+    {
+        A = A_frozen;
+        b = createRhs(n);
+        MathLib::applyKnownSolution(A, b, x, ids, values, elimination);
+    }
+
+    ASSERT_EQ(nnz, A.getRawMatrix().nonZeros());
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ASSERT_DOUBLE_EQ(b_ref[i], b[i]);
+        for (std::size_t j = 0; j < n; ++j)
+            ASSERT_EQ(A_ref[i][j], A.get(i, j));
+    }
+}
+
+TEST(MathLibKnownSolutionElimination, SymmetricUpperTriangle)
+{
+    std::size_t const n = 8;
+    std::vector<IndexType> const ids{0, 3, 7, 4};
+    std::vector<double> const values{1.0, -2.0, 0.5, 3.0};
+    std::vector<double> const new_values{-1.5, 4.0, 2.0, 0.25};
+
+    // Symmetric band matrix with a zero diagonal entry; added completely,
+    // the entries below the diagonal are ignored by symmetric storage.
+    auto const create_symmetric_matrix = [n](bool const symmetric)
+    {
+        MathLib::EigenMatrix A(n);
+        if (symmetric)
+            A.setSymmetric();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (std::size_t j = i; j < std::min(n, i + 3); ++j)
+            {
+                if (i == j && i == 3)
+                    continue;
+                double const v = (i == j) ? 4.0 + i : -1.0 - 0.5 * i - j;
+                A.add(i, j, v);
+                if (i != j)
+                    A.add(j, i, v);
+            }
+        }
+        return A;
+    };
+
+    MathLib::EigenMatrix A_full = create_symmetric_matrix(false);
+    MathLib::EigenMatrix A = create_symmetric_matrix(true);
+    ASSERT_EQ((A_full.getRawMatrix().nonZeros() + n - 1) / 2,
+              A.getRawMatrix().nonZeros());
+
+    auto elimination = MathLib::createKnownSolutionElimination(A, ids);
+    A.freezeStructure();
+    MathLib::EigenVector b = createRhs(n);
+    MathLib::EigenVector b_full = createRhs(n);
+    MathLib::EigenVector x(n);
+    MathLib::applyKnownSolution(A, b, x, ids, values, elimination);
+    MathLib::applyKnownSolution(A_full, b_full, x, ids, values);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ASSERT_DOUBLE_EQ(b_full[i], b[i]);
+        for (std::size_t j = 0; j < n; ++j)
+            ASSERT_EQ(A_full.get(i, j), A.get(i, j));
+    }
+
+    // Replay on the right-hand-side only.
+    A_full = create_symmetric_matrix(false);
+    b_full = createRhs(n);
+    MathLib::applyKnownSolution(A_full, b_full, x, ids, new_values);
+    b = createRhs(n);
+    MathLib::applyKnownSolution(elimination, b, ids, new_values);
+    for (std::size_t i = 0; i < n; ++i)
+        ASSERT_DOUBLE_EQ(b_full[i], b[i]);
+}
+
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,75 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#ifdef OGS_USE_EIGEN
+
+#include "MathLib/LinAlg/LinearCombination.h"
+#include "MathLib/LinAlg/Eigen/EigenMatrix.h"
+
+namespace
+{
+/// Tridiagonal matrix with frozen structure; the entries are scaled by s.
+MathLib::EigenMatrix createMatrix(std::size_t const n, double const s)
+{
+    MathLib::EigenMatrix A(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+            A.add(i, i - 1, -s * i);
+        A.add(i, i, s * (2.0 + i));
+        if (i < n - 1)
+            A.add(i, i + 1, s);
+    }
+    A.freezeStructure();
+    return A;
+}
+}  // namespace
+
+TEST(MathLibLinearCombination, SameStructure)
+{
+    std::size_t const n = 6;
+    MathLib::EigenMatrix const M = createMatrix(n, 1.0);
+    MathLib::EigenMatrix const K = createMatrix(n, -3.0);
+
+    // The result gets the structure of the arguments.
+    MathLib::EigenMatrix A(n);
+    ASSERT_TRUE(MathLib::linearCombination(A, 0.5, M, 2.0, K));
+    ASSERT_EQ(M.getRawMatrix().nonZeros(), A.getRawMatrix().nonZeros());
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            ASSERT_EQ(0.5 * M.get(i, j) + 2.0 * K.get(i, j), A.get(i, j));
+
+    // A frozen result with the same structure is updated in place.
+    A.freezeStructure();
+    double const* const values = A.getRawMatrix().valuePtr();
+    ASSERT_TRUE(MathLib::linearCombination(A, 1.0, M, -1.0, K));
+    ASSERT_EQ(values, A.getRawMatrix().valuePtr());
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            ASSERT_EQ(M.get(i, j) - K.get(i, j), A.get(i, j));
+}
+
+TEST(MathLibLinearCombination, DifferentStructures)
+{
+    std::size_t const n = 5;
+    MathLib::EigenMatrix const M = createMatrix(n, 1.0);
+    MathLib::EigenMatrix K(n);
+    K.add(0, n - 1, 4.0);
+    K.add(2, 2, 1.0);
+
+    MathLib::EigenMatrix A(n);
+    ASSERT_TRUE(MathLib::linearCombination(A, 2.0, M, 0.5, K));
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j)
+            ASSERT_EQ(2.0 * M.get(i, j) + 0.5 * K.get(i, j), A.get(i, j));
+}
+
+#endif  // OGS_USE_EIGEN
@@ -234,6 +234,80 @@ TEST(Math, CheckInterface_Eigen)
     checkLinearSolverInterface<MathLib::EigenMatrix, MathLib::EigenVector,
                                MathLib::EigenLinearSolver, IntType>(A, conf);
 }
+
+TEST(Math, CheckInterface_EigenSymmetric)
+{
+    using IntType = MathLib::EigenMatrix::IndexType;
+
+    // CG and LDLT instead of SparseLU read the stored upper triangle.
+    for (auto const solver_type : {"CG", "SparseLU"})
+    {
+        boost::property_tree::ptree t_root;
+        boost::property_tree::ptree t_solver;
+        t_solver.put("solver_type", solver_type);
+        t_solver.put("precon_type", "NONE");
+        t_solver.put("error_tolerance", 1e-15);
+        t_solver.put("max_iteration_step", 1000);
+        t_root.put_child("eigen", t_solver);
+        BaseLib::ConfigTree conf(t_root, "");
+
+        MathLib::EigenMatrix A(Example1<IntType>::dim_eqs);
+        A.setSymmetric();
+        checkLinearSolverInterface<MathLib::EigenMatrix, MathLib::EigenVector,
+                                   MathLib::EigenLinearSolver, IntType>(A,
+                                                                        conf);
+    }
+}
+
+TEST(Math, EigenSparseLUReuseFactorization)
+{
+    boost::property_tree::ptree t_root;
+    boost::property_tree::ptree t_solver;
+    t_solver.put("solver_type", "SparseLU");
+    t_root.put_child("eigen", t_solver);
+    BaseLib::ConfigTree conf(t_root, "");
+
+    std::size_t const n = 10;
+    MathLib::EigenMatrix A(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (i > 0)
+            A.add(i, i - 1, -1.0);
+        A.add(i, i, 2.0 + 0.1 * i);
+        if (i < n - 1)
+            A.add(i, i + 1, -1.0);
+    }
+    A.freezeStructure();
+
+    MathLib::EigenLinearSolver ls(A, "", &conf);
+    MathLib::EigenVector b(n), x(n), Ax(n);
+
+    auto const checkResidual = [&]()
+    {
+        A.multiply(x, Ax);
+        for (std::size_t i = 0; i < n; ++i)
+            ASSERT_NEAR(b[i], Ax[i], 1e-12);
+    };
+
+    b = 1.0;
+    ls.solve(b, x);
+    checkResidual();
+
+    // New right-hand-side, unchanged matrix.
+    for (std::size_t i = 0; i < n; ++i)
+        b[i] = static_cast<double>(i);
+    ls.solve(b, x, MathLib::LinearSolverBehaviour::REUSE);
+    checkResidual();
+
+    // Changed values; the factorization is recomputed only on request.
+    A.getRawMatrix() *= 2.0;
+    ls.solve(b, x, MathLib::LinearSolverBehaviour::REUSE);
+    MathLib::EigenVector const x_reused(x);
+    ls.solve(b, x);
+    checkResidual();
+    for (std::size_t i = 0; i < n; ++i)
+        ASSERT_NEAR(x_reused[i], 2.0 * x[i], 1e-12);
+}
 #endif
 
 #if defined(OGS_USE_EIGEN) && defined(USE_LIS)
@@ -0,0 +1,117 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MathLib/LinAlg/Solvers/LinearOperatorSolvers.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixDiagPrecond.h"
+
+namespace
+{
+/// Five-point finite difference matrix of a diffusion problem with jumping
+/// coefficients on an n x n grid.
+std::unique_ptr<MathLib::CRSMatrixDiagPrecond> createMatrix(unsigned const n)
+{
+    // Coefficient of the connection of two grid points.
+    auto const coefficient = [](unsigned const a, unsigned const b)
+    {
+        return 1.0 + 10.0 * ((std::min(a, b) * 7 + std::max(a, b) * 3) % 5);
+    };
+
+    std::vector<unsigned> row_ptr(1, 0);
+    std::vector<unsigned> col_idx;
+    std::vector<double> data;
+    for (unsigned j = 0; j < n; ++j)
+        for (unsigned i = 0; i < n; ++i)
+        {
+            unsigned const row = j * n + i;
+            std::vector<unsigned> cols;
+            if (j > 0) cols.push_back(row - n);
+            if (i > 0) cols.push_back(row - 1);
+            cols.push_back(row);
+            if (i + 1 < n) cols.push_back(row + 1);
+            if (j + 1 < n) cols.push_back(row + n);
+
+            double diagonal = 0.01;
+            for (unsigned const col : cols)
+                if (col != row)
+                    diagonal += coefficient(row, col);
+            for (unsigned const col : cols)
+            {
+                col_idx.push_back(col);
+                data.push_back(col == row ? diagonal
+                                          : -coefficient(row, col));
+            }
+            row_ptr.push_back(col_idx.size());
+        }
+
+    // The matrix takes the ownership of the arrays.
+    unsigned* const iA = new unsigned[row_ptr.size()];
+    unsigned* const jA = new unsigned[col_idx.size()];
+    double* const A = new double[data.size()];
+    std::copy(row_ptr.begin(), row_ptr.end(), iA);
+    std::copy(col_idx.begin(), col_idx.end(), jA);
+    std::copy(data.begin(), data.end(), A);
+    return std::unique_ptr<MathLib::CRSMatrixDiagPrecond>(
+        new MathLib::CRSMatrixDiagPrecond(n * n, iA, jA, A));
+}
+}  // namespace
+
+TEST(MathLibPipelinedCG, SameIterationsAsCG)
+{
+    auto const A = createMatrix(40);
+    A->calcPrecond();
+    std::size_t const n = A->getNRows();
+
+    std::vector<double> b(n);
+    for (std::size_t i = 0; i < n; ++i)
+        b[i] = std::sin(0.1 * i);
+
+    std::vector<double> x_cg(n, 0.0);
+    double eps_cg = 1e-10;
+    unsigned n_steps_cg = 1000;
+    ASSERT_EQ(0u, MathLib::CG(*A, b.data(), x_cg.data(), eps_cg, n_steps_cg));
+
+    std::vector<double> x(n, 0.0);
+    double eps = 1e-10;
+    unsigned n_steps = 1000;
+    ASSERT_EQ(0u, MathLib::PipelinedCG(*A, b.data(), x.data(), eps, n_steps));
+    ASSERT_GE(1e-10, eps);
+    ASSERT_NEAR(n_steps_cg, n_steps, 2);
+
+    // The true residual of the recursively updated one.
+    std::vector<double> r(n);
+    A->amux(1.0, x.data(), r.data());
+    double rr = 0.0, bb = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        rr += (b[i] - r[i]) * (b[i] - r[i]);
+        bb += b[i] * b[i];
+    }
+    ASSERT_GT(1e-8, std::sqrt(rr / bb));
+}
+
+TEST(MathLibPipelinedCG, ZeroRightHandSide)
+{
+    auto const A = createMatrix(5);
+    A->calcPrecond();
+    std::vector<double> const b(A->getNRows(), 0.0);
+    std::vector<double> x(A->getNRows(), 1.0);
+    double eps = 1e-10;
+    unsigned n_steps = 100;
+    ASSERT_EQ(0u, MathLib::PipelinedCG(*A, b.data(), x.data(), eps, n_steps));
+    ASSERT_EQ(0u, n_steps);
+    for (double const v : x)
+        ASSERT_EQ(0.0, v);
+}
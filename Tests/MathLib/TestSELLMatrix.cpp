@@ -0,0 +1,124 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MathLib/LinAlg/Sparse/amuxCRS.h"
+#include "MathLib/LinAlg/Sparse/CRSMatrixSELL.h"
+#include "MathLib/LinAlg/Sparse/SELLMatrix.h"
+
+namespace
+{
+/// A matrix with rows of very different lengths including empty rows; the
+/// number of rows is no multiple of the chunk size.
+struct IrregularMatrix
+{
+    explicit IrregularMatrix(unsigned const n)
+    {
+        row_ptr.push_back(0);
+        for (unsigned i = 0; i < n; ++i)
+        {
+            unsigned const length = (i * 7) % 13 == 0 ? 0 : (i * 5) % 11 + 1;
+            for (unsigned j = 0; j < length; ++j)
+            {
+                col_idx.push_back((i + j * j * 3) % n);
+                data.push_back(1.0 + 0.01 * i - 0.1 * j);
+            }
+            row_ptr.push_back(col_idx.size());
+        }
+    }
+
+    std::vector<unsigned> row_ptr;
+    std::vector<unsigned> col_idx;
+    std::vector<double> data;
+};
+}  // namespace
+
+TEST(MathLibSELLMatrix, MatchesCRS)
+{
+    unsigned const n = 101;
+    IrregularMatrix const A(n);
+
+    std::vector<double> x(n);
+    for (unsigned i = 0; i < n; ++i)
+        x[i] = 1.0 / (i + 1.0);
+    std::vector<double> y_ref(n);
+    for (unsigned i = 0; i < n; ++i)
+    {
+        y_ref[i] = 0.0;
+        for (unsigned k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+            y_ref[i] += A.data[k] * x[A.col_idx[k]];
+        y_ref[i] *= 2.5;
+    }
+
+    using Kernel = MathLib::SELLMatrix::Kernel;
+    for (std::size_t const sigma : {1, 8, 32, 1000})
+    {
+        MathLib::SELLMatrix sell(n, A.row_ptr.data(), A.col_idx.data(),
+                                 A.data.data(), sigma);
+        ASSERT_EQ(n, sell.getNRows());
+        ASSERT_LE(A.data.size(), sell.getNStoredEntries());
+
+        for (Kernel const kernel :
+             {Kernel::Scalar, Kernel::AVX2, Kernel::AVX512})
+        {
+            if (!MathLib::SELLMatrix::isSupported(kernel))
+                continue;
+            sell.setKernel(kernel);
+            std::vector<double> y(n, -1.0);
+            sell.amux(2.5, x.data(), y.data());
+            for (unsigned i = 0; i < n; ++i)
+                ASSERT_NEAR(y_ref[i], y[i], 1e-14 * std::abs(y_ref[i]));
+        }
+    }
+}
+
+TEST(MathLibSELLMatrix, SortingReducesPadding)
+{
+    unsigned const n = 256;
+    IrregularMatrix const A(n);
+
+    MathLib::SELLMatrix const unsorted(n, A.row_ptr.data(), A.col_idx.data(),
+                                       A.data.data(), 1);
+    MathLib::SELLMatrix const sorted(n, A.row_ptr.data(), A.col_idx.data(),
+                                     A.data.data(), n);
+    ASSERT_GT(unsorted.getNStoredEntries(), sorted.getNStoredEntries());
+}
+
+TEST(MathLibSELLMatrix, CRSMatrixSELLAmux)
+{
+    unsigned const n = 37;
+    IrregularMatrix const A(n);
+
+    // The matrices take the ownership of the arrays.
+    auto const copy = [](std::vector<unsigned> const& v)
+    {
+        unsigned* const p = new unsigned[v.size()];
+        std::copy(v.begin(), v.end(), p);
+        return p;
+    };
+    double* const data = new double[A.data.size()];
+    std::copy(A.data.begin(), A.data.end(), data);
+    MathLib::CRSMatrixSELL const mat(n, copy(A.row_ptr), copy(A.col_idx),
+                                     data);
+
+    std::vector<double> x(n, 1.0);
+    std::vector<double> y_ref(n);
+    std::vector<double> y(n);
+    MathLib::amuxCRS(1.0, n, A.row_ptr.data(), A.col_idx.data(),
+                     A.data.data(), x.data(), y_ref.data());
+    mat.amux(1.0, x.data(), y.data());
+    for (unsigned i = 0; i < n; ++i)
+        if (A.row_ptr[i] != A.row_ptr[i + 1])
+            ASSERT_NEAR(y_ref[i], y[i], 1e-14 * std::abs(y_ref[i]));
+        else
+            ASSERT_EQ(0.0, y[i]);
+}
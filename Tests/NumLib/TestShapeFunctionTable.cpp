@@ -0,0 +1,224 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/Node.h"
+
+#include "NumLib/Fem/FiniteElement/TemplateIsoparametric.h"
+#include "NumLib/Fem/Integration/GaussIntegrationPolicy.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex8.h"
+#include "NumLib/Fem/ShapeFunction/ShapePoint1.h"
+#include "NumLib/Fem/ShapeFunction/ShapePrism6.h"
+#include "NumLib/Fem/ShapeFunction/ShapeQuad4.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTet10.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri3.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri6.h"
+#include "NumLib/Fem/ShapeFunctionTable.h"
+#include "NumLib/Fem/ShapeMatrixPolicy.h"
+
+namespace
+{
+/// Compares the tabulated values with the shape functions evaluated at the
+/// integration points of all orders.
+template <typename ShapeFunction>
+void checkTableValues()
+{
+    using IntegrationMethod = typename NumLib::GaussIntegrationPolicy<
+        typename ShapeFunction::MeshElement>::IntegrationMethod;
+    using Table = NumLib::ShapeFunctionTable<ShapeFunction, IntegrationMethod>;
+
+    std::size_t n_tabulated_points = 0;
+    for (unsigned order = 0; order <= Table::max_integration_order; ++order)
+    {
+        auto const& table = Table::get(order);
+        IntegrationMethod integration_method(order);
+        ASSERT_EQ(integration_method.getNPoints(), table.size());
+        n_tabulated_points += table.size();
+
+        for (std::size_t ip = 0; ip < table.size(); ++ip)
+        {
+            auto const& wp = integration_method.getWeightedPoint(ip);
+
+            std::array<double, ShapeFunction::NPOINTS> N;
+            ShapeFunction::computeShapeFunction(wp.getCoords(), N);
+            for (std::size_t i = 0; i < N.size(); ++i)
+                ASSERT_EQ(N[i], table[ip].N[i]);
+
+            std::array<double, ShapeFunction::DIM * ShapeFunction::NPOINTS>
+                dNdr;
+            double* const p = dNdr.data();
+            ShapeFunction::computeGradShapeFunction(wp.getCoords(), p);
+            for (std::size_t i = 0; i < dNdr.size(); ++i)
+                ASSERT_EQ(dNdr[i], table[ip].dNdr[i]);
+        }
+    }
+    ASSERT_LT(0u, n_tabulated_points);
+}
+
+/// Compares the shape matrices computed from the tabulated values with the
+/// ones computed at the integration points' coordinates.
+template <typename ShapeFunction, unsigned GlobalDim>
+void checkShapeMatrices(MeshLib::Mesh const& mesh)
+{
+    using ShapeMatricesType = ShapeMatrixPolicyType<ShapeFunction, GlobalDim>;
+    using ShapeMatrices = typename ShapeMatricesType::ShapeMatrices;
+    using IntegrationMethod = typename NumLib::GaussIntegrationPolicy<
+        typename ShapeFunction::MeshElement>::IntegrationMethod;
+
+    unsigned const integration_order = 2;
+    IntegrationMethod integration_method(integration_order);
+    auto const& table = NumLib::ShapeFunctionTable<
+        ShapeFunction, IntegrationMethod>::get(integration_order);
+
+    for (auto const* e : mesh.getElements())
+    {
+        NumLib::TemplateIsoparametric<ShapeFunction, ShapeMatricesType> fe(
+            *static_cast<typename ShapeFunction::MeshElement const*>(e));
+        for (std::size_t ip = 0; ip < table.size(); ++ip)
+        {
+            ShapeMatrices expected(ShapeFunction::DIM, GlobalDim,
+                                   ShapeFunction::NPOINTS);
+            fe.computeShapeFunctions(
+                integration_method.getWeightedPoint(ip).getCoords(),
+                expected);
+
+            ShapeMatrices tabulated(ShapeFunction::DIM, GlobalDim,
+                                    ShapeFunction::NPOINTS);
+            fe.computeShapeFunctions(table[ip], tabulated);
+
+            ASSERT_EQ(expected.detJ, tabulated.detJ);
+            ASSERT_TRUE(expected.N == tabulated.N);
+            ASSERT_TRUE(expected.dNdr == tabulated.dNdr);
+            ASSERT_TRUE(expected.J == tabulated.J);
+            ASSERT_TRUE(expected.dNdx == tabulated.dNdx);
+        }
+
+        // All points at once; the Jacobian is reused for affine elements.
+        std::vector<ShapeMatrices> all(
+            table.size(), ShapeMatrices(ShapeFunction::DIM, GlobalDim,
+                                        ShapeFunction::NPOINTS));
+        fe.computeShapeFunctions(table, all);
+        for (std::size_t ip = 0; ip < table.size(); ++ip)
+        {
+            ShapeMatrices expected(ShapeFunction::DIM, GlobalDim,
+                                   ShapeFunction::NPOINTS);
+            fe.computeShapeFunctions(table[ip], expected);
+
+            ASSERT_NEAR(expected.detJ, all[ip].detJ, 1e-14);
+            ASSERT_TRUE(expected.N == all[ip].N);
+            ASSERT_TRUE(expected.J.isApprox(all[ip].J, 1e-14));
+            ASSERT_TRUE(expected.dNdx.isApprox(all[ip].dNdx, 1e-14));
+        }
+    }
+}
+
+/// Counts the elements with constant Jacobian.
+template <typename ShapeFunction, unsigned GlobalDim>
+std::size_t countAffineElements(MeshLib::Mesh const& mesh)
+{
+    using ShapeMatricesType = ShapeMatrixPolicyType<ShapeFunction, GlobalDim>;
+    using Mapping = NumLib::NaturalCoordinatesMapping<
+        typename ShapeFunction::MeshElement, ShapeFunction,
+        typename ShapeMatricesType::ShapeMatrices>;
+
+    std::size_t n = 0;
+    for (auto const* e : mesh.getElements())
+        if (Mapping::hasConstantJacobian(
+                *static_cast<typename ShapeFunction::MeshElement const*>(e)))
+            n++;
+    return n;
+}
+
+/// Applies x -> A x with a shear A.
+void shear(MeshLib::Mesh& mesh)
+{
+    for (auto* node : mesh.getNodes())
+    {
+        auto& x = *node;
+        x[0] += 0.5 * x[1] + 0.25 * x[2];
+        x[1] += 0.3 * x[2];
+    }
+}
+}  // namespace
+
+TEST(NumLibShapeFunctionTable, ValuesEqualEvaluation)
+{
+    checkTableValues<NumLib::ShapeHex8>();
+    checkTableValues<NumLib::ShapeQuad4>();
+    checkTableValues<NumLib::ShapeTri6>();
+    checkTableValues<NumLib::ShapeTet10>();
+    checkTableValues<NumLib::ShapePrism6>();
+}
+
+TEST(NumLibShapeFunctionTable, PointElement)
+{
+    using Table = NumLib::ShapeFunctionTable<NumLib::ShapePoint1,
+                                             NumLib::IntegrationPoint>;
+    auto const& table = Table::get(0);
+    ASSERT_EQ(1u, table.size());
+    ASSERT_EQ(1.0, table[0].N[0]);
+}
+
+TEST(NumLibShapeFunctionTable, ShapeMatricesEqualEvaluation)
+{
+    std::unique_ptr<MeshLib::Mesh> const hex_mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(2.0, 2));
+    checkShapeMatrices<NumLib::ShapeHex8, 3>(*hex_mesh);
+
+    // Two-dimensional elements in three-dimensional space.
+    std::unique_ptr<MeshLib::Mesh> const quad_mesh(
+        MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 3));
+    checkShapeMatrices<NumLib::ShapeQuad4, 2>(*quad_mesh);
+    checkShapeMatrices<NumLib::ShapeQuad4, 3>(*quad_mesh);
+
+    std::unique_ptr<MeshLib::Mesh> const tri_mesh(
+        MeshLib::MeshGenerator::generateRegularTriMesh(1.0, 3));
+    checkShapeMatrices<NumLib::ShapeTri3, 2>(*tri_mesh);
+}
+
+TEST(NumLibShapeFunctionTable, AffineElements)
+{
+    std::unique_ptr<MeshLib::Mesh> const hex_mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(1.0, 3));
+    shear(*hex_mesh);
+    ASSERT_EQ(hex_mesh->getNElements(),
+              (countAffineElements<NumLib::ShapeHex8, 3>(*hex_mesh)));
+    checkShapeMatrices<NumLib::ShapeHex8, 3>(*hex_mesh);
+
+    // Moving an inner node distorts the eight adjacent elements.
+    auto& inner_node = *hex_mesh->getNodes()[21];
+    ASSERT_EQ(8u, inner_node.getElements().size());
+    inner_node[0] += 0.05;
+    ASSERT_EQ(hex_mesh->getNElements() - 8,
+              (countAffineElements<NumLib::ShapeHex8, 3>(*hex_mesh)));
+    checkShapeMatrices<NumLib::ShapeHex8, 3>(*hex_mesh);
+
+    std::unique_ptr<MeshLib::Mesh> const quad_mesh(
+        MeshLib::MeshGenerator::generateRegularQuadMesh(1.0, 3));
+    shear(*quad_mesh);
+    ASSERT_EQ(quad_mesh->getNElements(),
+              (countAffineElements<NumLib::ShapeQuad4, 2>(*quad_mesh)));
+    (*quad_mesh->getNodes()[5])[1] += 0.05;
+    ASSERT_EQ(quad_mesh->getNElements() - 4,
+              (countAffineElements<NumLib::ShapeQuad4, 2>(*quad_mesh)));
+    checkShapeMatrices<NumLib::ShapeQuad4, 2>(*quad_mesh);
+
+    std::unique_ptr<MeshLib::Mesh> const tri_mesh(
+        MeshLib::MeshGenerator::generateRegularTriMesh(1.0, 3));
+    (*tri_mesh->getNodes()[5])[1] += 0.05;
+    ASSERT_EQ(tri_mesh->getNElements(),
+              (countAffineElements<NumLib::ShapeTri3, 2>(*tri_mesh)));
+}
@@ -0,0 +1,136 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "MeshLib/Elements/Element.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/Node.h"
+
+#include "NumLib/Fem/FiniteElement/TemplateIsoparametric.h"
+#include "NumLib/Fem/Integration/GaussIntegrationPolicy.h"
+#include "NumLib/Fem/ShapeFunction/ShapeHex8.h"
+#include "NumLib/Fem/ShapeFunction/ShapeTri3.h"
+#include "NumLib/Fem/ShapeMatricesCache.h"
+#include "NumLib/Fem/ShapeMatrixPolicy.h"
+
+namespace
+{
+template <typename ShapeFunction, unsigned GlobalDim>
+class ShapeMatricesComputation
+{
+public:
+    using ShapeMatricesType = ShapeMatrixPolicyType<ShapeFunction, GlobalDim>;
+    using ShapeMatrices = typename ShapeMatricesType::ShapeMatrices;
+    using IntegrationMethod = typename NumLib::GaussIntegrationPolicy<
+        typename ShapeFunction::MeshElement>::IntegrationMethod;
+
+    static std::vector<ShapeMatrices> compute(MeshLib::Element const& e,
+                                              unsigned const integration_order)
+    {
+        NumLib::TemplateIsoparametric<ShapeFunction, ShapeMatricesType> fe(
+            *static_cast<typename ShapeFunction::MeshElement const*>(&e));
+        IntegrationMethod integration_method(integration_order);
+
+        std::vector<ShapeMatrices> shape_matrices;
+        for (unsigned ip = 0; ip < integration_method.getNPoints(); ++ip)
+        {
+            shape_matrices.emplace_back(ShapeFunction::DIM, GlobalDim,
+                                        ShapeFunction::NPOINTS);
+            fe.computeShapeFunctions(
+                integration_method.getWeightedPoint(ip).getCoords(),
+                shape_matrices.back());
+        }
+        return shape_matrices;
+    }
+
+    /// Fetches the shape matrices of all elements from the cache and checks
+    /// them against the directly computed ones.
+    static std::vector<std::shared_ptr<std::vector<ShapeMatrices> const>>
+    getAll(NumLib::ShapeMatricesCache& cache, MeshLib::Mesh const& mesh,
+           unsigned const integration_order, std::size_t& n_computations)
+    {
+        std::vector<std::shared_ptr<std::vector<ShapeMatrices> const>> all;
+        for (auto const* e : mesh.getElements())
+        {
+            all.push_back(cache.get<ShapeMatrices>(
+                *e, integration_order, [&]()
+                {
+                    ++n_computations;
+                    return compute(*e, integration_order);
+                }));
+
+            auto const expected = compute(*e, integration_order);
+            auto const& cached = *all.back();
+            EXPECT_EQ(expected.size(), cached.size());
+            for (std::size_t ip = 0; ip < expected.size(); ++ip)
+            {
+                EXPECT_NEAR(expected[ip].detJ, cached[ip].detJ, 1e-14);
+                EXPECT_TRUE(
+                    expected[ip].dNdx.isApprox(cached[ip].dNdx, 1e-12));
+            }
+        }
+        return all;
+    }
+};
+}  // namespace
+
+TEST(NumLibShapeMatricesCache, RegularHexMeshSharesOneSet)
+{
+    using Computation = ShapeMatricesComputation<NumLib::ShapeHex8, 3>;
+
+    // The element size is not exactly representable, hence the node
+    // coordinate differences vary by round-off.
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularHexMesh(5, 5, 5, 1.0 / 7));
+
+    NumLib::ShapeMatricesCache cache;
+    std::size_t n_computations = 0;
+    auto const all = Computation::getAll(cache, *mesh, 2, n_computations);
+
+    ASSERT_EQ(1u, cache.size());
+    ASSERT_EQ(1u, n_computations);
+    for (auto const& sm : all)
+        ASSERT_EQ(all.front().get(), sm.get());
+
+    // Another integration order gives another set.
+    Computation::getAll(cache, *mesh, 3, n_computations);
+    ASSERT_EQ(2u, cache.size());
+}
+
+TEST(NumLibShapeMatricesCache, DistortedElementsAreNotShared)
+{
+    using Computation = ShapeMatricesComputation<NumLib::ShapeTri3, 2>;
+
+    // The regular triangle mesh has two differently oriented triangles.
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateRegularTriMesh(1.0, 4));
+    {
+        NumLib::ShapeMatricesCache cache;
+        std::size_t n_computations = 0;
+        Computation::getAll(cache, *mesh, 2, n_computations);
+        ASSERT_EQ(2u, cache.size());
+        ASSERT_EQ(2u, n_computations);
+    }
+
+    // Moving an inner node changes the shape of its adjacent elements.
+    MeshLib::Node& node = *mesh->getNodes()[6];
+    node[0] += 0.01;
+    node[1] -= 0.02;
+
+    NumLib::ShapeMatricesCache cache;
+    std::size_t n_computations = 0;
+    Computation::getAll(cache, *mesh, 2, n_computations);
+    ASSERT_LT(2u, cache.size());
+    ASSERT_EQ(cache.size(), n_computations);
+}
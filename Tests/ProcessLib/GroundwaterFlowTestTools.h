@@ -0,0 +1,120 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#ifndef TESTS_PROCESSLIB_GROUNDWATERFLOWTESTTOOLS_H_
+#define TESTS_PROCESSLIB_GROUNDWATERFLOWTESTTOOLS_H_
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "BaseLib/ConfigTree.h"
+#include "GeoLib/GEOObjects.h"
+#include "GeoLib/Point.h"
+#include "MeshLib/Mesh.h"
+
+#include "ProcessLib/GroundwaterFlowProcess.h"
+#include "ProcessLib/NumericsConfig.h"
+#include "ProcessLib/Parameter.h"
+#include "ProcessLib/ProcessVariable.h"
+
+namespace
+{
+/// Settings of the groundwater flow process with the defaults of
+/// ProcessLib::createGroundwaterFlowProcess().
+struct GroundwaterFlowSettings
+{
+    bool time_invariant_system = false;
+    bool share_shape_matrices = false;
+    ProcessLib::Parameter<double, MeshLib::Element const&> const* storage =
+        nullptr;
+    double theta = 1.0;
+    bool symmetric_matrix = false;
+    bool triplet_assembly = false;
+    bool batched_assembly = false;
+};
+
+/// Groundwater flow process with the given settings, giving access to the
+/// solution.
+class GroundwaterFlowProcess final
+    : public ProcessLib::GroundwaterFlowProcess<GlobalSetupType>
+{
+public:
+    GroundwaterFlowProcess(
+        MeshLib::Mesh& mesh, ProcessLib::ProcessVariable& variable,
+        ProcessLib::Parameter<double, MeshLib::Element const&> const&
+            hydraulic_conductivity,
+        GroundwaterFlowSettings const& settings)
+        : ProcessLib::GroundwaterFlowProcess<GlobalSetupType>(
+              mesh, variable, hydraulic_conductivity,
+              boost::optional<BaseLib::ConfigTree>(),
+              settings.time_invariant_system, settings.share_shape_matrices,
+              boost::optional<ProcessLib::MatrixFreeSolverOptions>(),
+              settings.storage, settings.theta, settings.symmetric_matrix,
+              settings.triplet_assembly, settings.batched_assembly)
+    {
+    }
+
+    double getSolution(std::size_t const i) const { return this->_x->get(i); }
+};
+
+/// Adds the points with the given names and coordinates to the geometries as
+/// the point set \c geometrical_set.
+void addNamedPoints(
+    GeoLib::GEOObjects& geometries, std::string geometrical_set,
+    std::vector<std::pair<std::string, std::array<double, 3>>> const& points)
+{
+    std::unique_ptr<std::vector<GeoLib::Point*>> geo_points(
+        new std::vector<GeoLib::Point*>);
+    auto* const point_names = new std::map<std::string, std::size_t>;
+    for (auto const& point : points)
+    {
+        (*point_names)[point.first] = geo_points->size();
+        geo_points->push_back(new GeoLib::Point(point.second));
+    }
+    geometries.addPointVec(std::move(geo_points), geometrical_set,
+                           point_names);
+}
+
+/// Creates a process variable with the given initial condition and the given
+/// head values at the named points of the geometrical set.
+ProcessLib::ProcessVariable createProcessVariable(
+    MeshLib::Mesh const& mesh, GeoLib::GEOObjects const& geometries,
+    boost::property_tree::ptree const& initial_condition,
+    std::string const& geometrical_set,
+    std::vector<std::pair<std::string, double>> const& heads)
+{
+    boost::property_tree::ptree boundary_conditions;
+    for (auto const& head : heads)
+    {
+        boost::property_tree::ptree bc;
+        bc.put("geometrical_set", geometrical_set);
+        bc.put("geometry", head.first);
+        bc.put("type", "UniformDirichlet");
+        bc.put("value", head.second);
+        boundary_conditions.add_child("boundary_condition", bc);
+    }
+
+    boost::property_tree::ptree ptree;
+    ptree.put("name", "head");
+    ptree.add_child("initial_condition", initial_condition);
+    ptree.add_child("boundary_conditions", boundary_conditions);
+
+    BaseLib::ConfigTree const config(ptree, "");
+    return ProcessLib::ProcessVariable(config, mesh, geometries);
+}
+}  // namespace
+
+#endif  // TESTS_PROCESSLIB_GROUNDWATERFLOWTESTTOOLS_H_
@@ -0,0 +1,125 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/ptree.hpp>
+
+#ifdef OGS_USE_EIGEN
+
+#include "MeshLib/Elements/Quad.h"
+#include "MeshLib/Elements/Tri.h"
+#include "MeshLib/Mesh.h"
+#include "MeshLib/Node.h"
+
+#include "ProcessLib/Parameter.h"
+
+#include "GroundwaterFlowTestTools.h"
+
+namespace
+{
+/// Square mesh of quadrilaterals and triangles in a checkerboard pattern;
+/// every second cell is split into two triangles.
+MeshLib::Mesh* createMixedMesh(double const length, std::size_t const n)
+{
+    double const h = length / n;
+    std::vector<MeshLib::Node*> nodes;
+    for (std::size_t j = 0; j <= n; ++j)
+        for (std::size_t i = 0; i <= n; ++i)
+            nodes.push_back(new MeshLib::Node(i * h, j * h, 0.0,
+                                              nodes.size()));
+
+    std::vector<MeshLib::Element*> elements;
+    for (std::size_t j = 0; j < n; ++j)
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            MeshLib::Node* const n0 = nodes[j * (n + 1) + i];
+            MeshLib::Node* const n1 = nodes[j * (n + 1) + i + 1];
+            MeshLib::Node* const n2 = nodes[(j + 1) * (n + 1) + i + 1];
+            MeshLib::Node* const n3 = nodes[(j + 1) * (n + 1) + i];
+            if ((i + j) % 2 == 0)
+            {
+                elements.push_back(new MeshLib::Quad(
+                    std::array<MeshLib::Node*, 4>{{n0, n1, n2, n3}}));
+            }
+            else
+            {
+                elements.push_back(new MeshLib::Tri(
+                    std::array<MeshLib::Node*, 3>{{n0, n1, n2}}));
+                elements.push_back(new MeshLib::Tri(
+                    std::array<MeshLib::Node*, 3>{{n0, n2, n3}}));
+            }
+        }
+
+    return new MeshLib::Mesh("mixed", nodes, elements);
+}
+}  // namespace
+
+// The steady-state solution of the batched assembly on a mesh of two element
+// types with heterogeneous conductivity equals the one of the element-wise
+// assembly.
+TEST(ProcessLibGroundwaterFlow, BatchedAssembly)
+{
+    double const length = 1.0;
+    std::size_t const n_cells = 7;
+
+    std::unique_ptr<MeshLib::Mesh> mesh(createMixedMesh(length, n_cells));
+    auto conductivity =
+        mesh->getProperties().createNewPropertyVector<double>(
+            "conductivity", MeshLib::MeshItemType::Cell);
+    for (std::size_t i = 0; i < mesh->getNElements(); ++i)
+        conductivity->push_back(1.0 + 0.1 * (i % 5));
+
+    GeoLib::GEOObjects geometries;
+    std::string const geometrical_set = "square";
+    addNamedPoints(geometries, geometrical_set,
+                   {{"lower_left", {{0.0, 0.0, 0.0}}},
+                    {"upper_right", {{length, length, 0.0}}}});
+
+    boost::property_tree::ptree initial_condition;
+    initial_condition.put("type", "Uniform");
+    initial_condition.put("value", 0.0);
+    auto variable = createProcessVariable(
+        *mesh, geometries, initial_condition, geometrical_set,
+        {{"lower_left", 1.0}, {"upper_right", 0.0}});
+
+    ProcessLib::MeshPropertyParameter<double> const hydraulic_conductivity(
+        *conductivity);
+
+    auto solve = [&](bool const batched_assembly)
+    {
+        GroundwaterFlowSettings settings;
+        settings.batched_assembly = batched_assembly;
+        GroundwaterFlowProcess process(*mesh, variable, hydraulic_conductivity,
+                                       settings);
+        process.initialize();
+        EXPECT_TRUE(process.solve(1.0));
+
+        std::vector<double> solution(mesh->getNNodes());
+        for (std::size_t i = 0; i < solution.size(); ++i)
+            solution[i] = process.getSolution(i);
+        return solution;
+    };
+
+    auto const expected = solve(false);
+    auto const solution = solve(true);
+
+    ASSERT_EQ(expected.size(), solution.size());
+    EXPECT_NEAR(1.0, solution.front(), 1e-10);
+    EXPECT_NEAR(0.0, solution.back(), 1e-10);
+    for (std::size_t i = 0; i < solution.size(); ++i)
+        ASSERT_NEAR(expected[i], solution[i], 1e-10);
+}
+
+#endif  // OGS_USE_EIGEN
@@ -0,0 +1,102 @@
+/**
+ * \copyright
+ * Copyright (c) 2012-2016, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+#include <cmath>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/ptree.hpp>
+
+#ifdef OGS_USE_EIGEN
+
+#include "MeshLib/Mesh.h"
+#include "MeshLib/MeshGenerators/MeshGenerator.h"
+#include "MeshLib/Node.h"
+
+#include "ProcessLib/Parameter.h"
+
+#include "GroundwaterFlowTestTools.h"
+
+// One-dimensional diffusion S dp/dt = K d^2p/dx^2 on [0, L] with p = 0 at both
+// ends and the initial pressure sin(pi x / L). The initial pressure is an
+// eigenvector of the linear elements' storage and conductivity matrices on a
+// uniform grid; in each time step of the theta method it decays by a factor
+// given by the eigenvalues and the time step size.
+TEST(ProcessLibGroundwaterFlow, TransientDecay)
+{
+    double const length = 1.0;
+    std::size_t const n_elements = 20;
+    double const storage = 1.0;
+    double const conductivity = 0.5;
+    double const theta = 0.5;
+    double const pi = std::acos(-1.0);
+
+    std::unique_ptr<MeshLib::Mesh> mesh(
+        MeshLib::MeshGenerator::generateLineMesh(length, n_elements));
+    auto initial_pressure =
+        mesh->getProperties().createNewPropertyVector<double>(
+            "initial_pressure", MeshLib::MeshItemType::Node);
+    for (auto const* node : mesh->getNodes())
+        initial_pressure->push_back(std::sin(pi * (*node)[0] / length));
+
+    GeoLib::GEOObjects geometries;
+    std::string const geometrical_set = "line";
+    addNamedPoints(geometries, geometrical_set,
+                   {{"left", {{0.0, 0.0, 0.0}}},
+                    {"right", {{length, 0.0, 0.0}}}});
+
+    boost::property_tree::ptree initial_condition;
+    initial_condition.put("type", "MeshProperty");
+    initial_condition.put("field_name", "initial_pressure");
+    auto variable =
+        createProcessVariable(*mesh, geometries, initial_condition,
+                              geometrical_set, {{"left", 0.0}, {"right", 0.0}});
+
+    ProcessLib::ConstParameter<double> const hydraulic_conductivity(
+        conductivity);
+    ProcessLib::ConstParameter<double> const storage_parameter(storage);
+
+    GroundwaterFlowSettings settings;
+    settings.storage = &storage_parameter;
+    settings.theta = theta;
+    GroundwaterFlowProcess process(*mesh, variable, hydraulic_conductivity,
+                                   settings);
+    process.initialize();
+
+    // Eigenvalues of the conductivity and the storage matrix for the
+    // initial pressure.
+    double const h = length / n_elements;
+    double const c = std::cos(pi * h / length);
+    double const k = conductivity * (2.0 - 2.0 * c) / h;
+    double const m = storage * h * (2.0 + c) / 3.0;
+
+    // The second and the fourth time step reuse the system matrix; the third
+    // one changes the time step size.
+    double amplitude = 1.0;
+    for (double const dt : {0.01, 0.01, 0.025, 0.025})
+    {
+        ASSERT_TRUE(process.solve(dt));
+        amplitude *= (m / dt - (1.0 - theta) * k) / (m / dt + theta * k);
+
+        for (std::size_t i = 0; i < mesh->getNNodes(); ++i)
+        {
+            double const x = (*mesh->getNode(i))[0];
+            ASSERT_NEAR(amplitude * std::sin(pi * x / length),
+                        process.getSolution(i), 1e-12);
+        }
+    }
+
+    // The discrete decay approximates the analytical one.
+    double const t = 0.07;
+    ASSERT_NEAR(std::exp(-conductivity / storage * pi * pi * t), amplitude,
+                1e-3);
+}
+
+#endif  // OGS_USE_EIGEN